@@ -21,6 +21,9 @@
 #include <skiplist_u64.h>
 #include <skiplist_i32.h>
 #include <skiplist_i64.h>
+#include <skiplist_compact_u32.h>
+#include <skiplist_block_u32.h>
+#include <skiplist_block_u64.h>
 
 
 #if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
@@ -103,6 +106,38 @@
         SkipList_u64**: skipList_u64_destroy \
     )(list)
 
+#define skipList_ceiling(list, id, out) \
+    _Generic((id), \
+        int32_t:  skipList_i32_ceiling, \
+        int64_t:  skipList_i64_ceiling, \
+        uint32_t: skipList_u32_ceiling, \
+        uint64_t: skipList_u64_ceiling \
+    )(list, id, out)
+
+#define skipList_floor(list, id, out) \
+    _Generic((id), \
+        int32_t:  skipList_i32_floor, \
+        int64_t:  skipList_i64_floor, \
+        uint32_t: skipList_u32_floor, \
+        uint64_t: skipList_u64_floor \
+    )(list, id, out)
+
+#define skipList_higher(list, id, out) \
+    _Generic((id), \
+        int32_t:  skipList_i32_higher, \
+        int64_t:  skipList_i64_higher, \
+        uint32_t: skipList_u32_higher, \
+        uint64_t: skipList_u64_higher \
+    )(list, id, out)
+
+#define skipList_lower(list, id, out) \
+    _Generic((id), \
+        int32_t:  skipList_i32_lower, \
+        int64_t:  skipList_i64_lower, \
+        uint32_t: skipList_u32_lower, \
+        uint64_t: skipList_u64_lower \
+    )(list, id, out)
+
 /*──────────────────────────────────────────────
     SkipMap (key → value) unified ops
   ──────────────────────────────────────────────*/
@@ -145,4 +180,36 @@
         SkipMap_u32**: skipMap_u32_destroy, \
         SkipMap_u64**: skipMap_u64_destroy \
     )(sm)
+
+#define skipMap_ceiling(sm, id, kv) \
+    _Generic((id), \
+        int32_t:  skipMap_i32_ceiling, \
+        int64_t:  skipMap_i64_ceiling, \
+        uint32_t: skipMap_u32_ceiling, \
+        uint64_t: skipMap_u64_ceiling \
+    )(sm, id, kv)
+
+#define skipMap_floor(sm, id, kv) \
+    _Generic((id), \
+        int32_t:  skipMap_i32_floor, \
+        int64_t:  skipMap_i64_floor, \
+        uint32_t: skipMap_u32_floor, \
+        uint64_t: skipMap_u64_floor \
+    )(sm, id, kv)
+
+#define skipMap_higher(sm, id, kv) \
+    _Generic((id), \
+        int32_t:  skipMap_i32_higher, \
+        int64_t:  skipMap_i64_higher, \
+        uint32_t: skipMap_u32_higher, \
+        uint64_t: skipMap_u64_higher \
+    )(sm, id, kv)
+
+#define skipMap_lower(sm, id, kv) \
+    _Generic((id), \
+        int32_t:  skipMap_i32_lower, \
+        int64_t:  skipMap_i64_lower, \
+        uint32_t: skipMap_u32_lower, \
+        uint64_t: skipMap_u64_lower \
+    )(sm, id, kv)
 #endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/* ────────────────────────────────────────────────
+   Pluggable allocator shared by the typed lists and the generic macros
+
+   alloc    : required when the allocator is used, NULL falls back to malloc/free
+   free     : optional, NULL means single objects are never released on their own
+   free_all : optional bulk release, when set destroy() skips per node frees and
+              tears everything (list struct included) down with one call
+   ctx      : passed back untouched to every callback
+
+   The allocator is copied into the list at creation, a zero initialised
+   allocator behaves exactly like malloc/free.
+──────────────────────────────────────────────── */
+typedef struct SkipListAllocator {
+    void * (*alloc)(void * ctx, size_t size);
+    void   (*free)(void * ctx, void * ptr, size_t size);
+    void   (*free_all)(void * ctx);
+    void * ctx;
+} SkipListAllocator;
+
+static inline void * skipListAllocator_alloc(const SkipListAllocator * a, size_t size) {
+    return a->alloc ? a->alloc(a->ctx, size) : malloc(size);
+}
+
+static inline void skipListAllocator_free(const SkipListAllocator * a, void * ptr, size_t size) {
+    if (!a->alloc) {
+        free(ptr);
+    } else if (a->free) {
+        a->free(a->ctx, ptr, size);
+    }
+}
+
+static inline void skipListAllocator_freeAll(const SkipListAllocator * a) {
+    if (a->alloc && a->free_all) {
+        a->free_all(a->ctx);
+    }
+}
+
+// true when destroy can skip releasing nodes one by one
+static inline int skipListAllocator_hasBulkFree(const SkipListAllocator * a) {
+    return a->alloc && a->free_all;
+}
+
+// true when memory from one can be returned through the other
+static inline int skipListAllocator_equal(const SkipListAllocator * a, const SkipListAllocator * b) {
+    return a->alloc == b->alloc && a->free == b->free && a->free_all == b->free_all && a->ctx == b->ctx;
+}
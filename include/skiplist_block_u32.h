@@ -0,0 +1,48 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <skiplist_allocator.h>
+
+#ifndef SL_MAX_HEIGHT
+#define SL_MAX_HEIGHT 32
+#endif
+
+/* ────────────────────────────────────────────────
+   Type Declarations
+──────────────────────────────────────────────── */
+
+// set of uint32_t keys where every bottom level node holds a sorted block of
+// keys, the towers index blocks and the in block search is done with SIMD compares
+typedef struct SkipListBlock_u32_t SkipListBlock_u32;
+
+
+/* ────────────────────────────────────────────────
+   uint32_t block SkipList
+──────────────────────────────────────────────── */
+SkipListBlock_u32* skipListBlock_u32_create(void);
+SkipListBlock_u32* skipListBlock_u32_create_with_allocator(const SkipListAllocator *allocator);
+bool  skipListBlock_u32_insert (SkipListBlock_u32 *list, uint32_t id);
+void  skipListBlock_u32_remove (SkipListBlock_u32 *list, uint32_t id);
+bool  skipListBlock_u32_search (SkipListBlock_u32 *list, uint32_t search_id);
+uint32_t skipListBlock_u32_getSize(const SkipListBlock_u32 *list);
+bool skipListBlock_u32_isEmpty(const SkipListBlock_u32 *list);
+bool skipListBlock_u32_pop(SkipListBlock_u32 *list, uint32_t * removed_id);
+void  skipListBlock_u32_destroy(SkipListBlock_u32 **list);
+void  skipListBlock_u32_print  (SkipListBlock_u32 *list);
@@ -0,0 +1,48 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <skiplist_allocator.h>
+
+#ifndef SL_MAX_HEIGHT
+#define SL_MAX_HEIGHT 32
+#endif
+
+/* ────────────────────────────────────────────────
+   Type Declarations
+──────────────────────────────────────────────── */
+
+// set of uint64_t keys where every bottom level node holds a sorted block of
+// keys, the towers index blocks and the in block search is done with SIMD compares
+typedef struct SkipListBlock_u64_t SkipListBlock_u64;
+
+
+/* ────────────────────────────────────────────────
+   uint64_t block SkipList
+──────────────────────────────────────────────── */
+SkipListBlock_u64* skipListBlock_u64_create(void);
+SkipListBlock_u64* skipListBlock_u64_create_with_allocator(const SkipListAllocator *allocator);
+bool  skipListBlock_u64_insert (SkipListBlock_u64 *list, uint64_t id);
+void  skipListBlock_u64_remove (SkipListBlock_u64 *list, uint64_t id);
+bool  skipListBlock_u64_search (SkipListBlock_u64 *list, uint64_t search_id);
+uint32_t skipListBlock_u64_getSize(const SkipListBlock_u64 *list);
+bool skipListBlock_u64_isEmpty(const SkipListBlock_u64 *list);
+bool skipListBlock_u64_pop(SkipListBlock_u64 *list, uint64_t * removed_id);
+void  skipListBlock_u64_destroy(SkipListBlock_u64 **list);
+void  skipListBlock_u64_print  (SkipListBlock_u64 *list);
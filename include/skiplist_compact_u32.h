@@ -0,0 +1,48 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SL_MAX_HEIGHT
+#define SL_MAX_HEIGHT 32
+#endif
+
+/* ────────────────────────────────────────────────
+   Type Declarations
+──────────────────────────────────────────────── */
+
+// set of uint32_t keys whose nodes live in one growable pool,
+// links are 32 bit indices into that pool instead of 64 bit pointers
+typedef struct SkipListCompact_u32_t SkipListCompact_u32;
+
+
+/* ────────────────────────────────────────────────
+   uint32_t compact SkipList
+──────────────────────────────────────────────── */
+SkipListCompact_u32* skipListCompact_u32_create(void);
+// false when id is already present, or when the pool has no room left: it is
+// capped at UINT32_MAX words (16 GiB), around a billion nodes at the default p
+bool  skipListCompact_u32_insert (SkipListCompact_u32 *list, uint32_t id);
+void  skipListCompact_u32_remove (SkipListCompact_u32 *list, uint32_t id);
+bool  skipListCompact_u32_search (SkipListCompact_u32 *list, uint32_t search_id);
+uint32_t skipListCompact_u32_getSize(const SkipListCompact_u32 *list);
+bool skipListCompact_u32_isEmpty(const SkipListCompact_u32 *list);
+bool skipListCompact_u32_pop(SkipListCompact_u32 *list, uint32_t *removed_id);
+void  skipListCompact_u32_destroy(SkipListCompact_u32 **list);
+void  skipListCompact_u32_print  (SkipListCompact_u32 *list);
@@ -0,0 +1,76 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <skiplist_allocator.h>
+
+/* ────────────────────────────────────────────────
+   Creation flags for the typed lists, combined with |
+
+   SKIPLIST_ARENA     : nodes come from per height slabs, same as create_with_arena()
+   SKIPLIST_INDEXABLE : every link stores its span (level 0 steps it skips),
+                        4 bytes per level, enables rank / select / countRange
+   SKIPLIST_BACKLINKS : every node keeps a pointer to its level 0 predecessor,
+                        8 bytes per node, enables reverse iteration and lets
+                        iterators remove their node without a descent
+──────────────────────────────────────────────── */
+#define SKIPLIST_ARENA     (1u << 0)
+#define SKIPLIST_INDEXABLE (1u << 1)
+#define SKIPLIST_BACKLINKS (1u << 2)
+
+/* ────────────────────────────────────────────────
+   Creation options for create_with_options, zero initialise and set only
+   what differs from the defaults
+
+   flags          : SKIPLIST_* flags above
+   seed           : tower height generator seed, lists created with the same seed
+                    and fed the same operations grow the same towers. 0 picks a
+                    fresh seed per list
+   allocator      : NULL allocates with malloc
+   max_height     : tallest tower and height of the header, at most SL_MAX_HEIGHT.
+                    0 keeps SL_MAX_HEIGHT. A list that stays small needs about
+                    log(n) / log(1/p) levels and saves the rest of the header,
+                    the per level tails of the list and the arena size classes
+   p              : base promotion probability in (0, 1), 0 keeps P
+   growth         : SKIPLIST_GROWTH_* below
+   rebalance_step : towers re-leveled per key every write adds or removes,
+                    insert, remove, put, pop, popMax, the batch calls, removeRange
+                    and the in place set operations. 0 leaves re-leveling to
+                    rebalance(). A pass starts whenever the size has doubled or
+                    halved since the last one ended. Writes through fingers and
+                    iterators do not step, they keep node pointers across writes
+──────────────────────────────────────────────── */
+typedef struct SkipListOptions {
+    uint32_t flags;
+    uint64_t seed;
+    const SkipListAllocator * allocator;
+    uint32_t max_height;
+    double p;
+    uint32_t growth;
+    uint32_t rebalance_step;
+} SkipListOptions;
+
+/* ────────────────────────────────────────────────
+   How the promotion probability follows the size of the list
+
+   SKIPLIST_GROWTH_ADAPTIVE : size^(-1/levels) kept between p and P_Upper,
+                              small lists grow taller towers early on
+   SKIPLIST_GROWTH_FIXED    : every promotion uses p, the textbook skip list
+──────────────────────────────────────────────── */
+#define SKIPLIST_GROWTH_ADAPTIVE 0u
+#define SKIPLIST_GROWTH_FIXED    1u
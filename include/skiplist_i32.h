@@ -19,6 +19,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <skiplist_allocator.h>
+#include <skiplist_flags.h>
 
 #ifndef SL_MAX_HEIGHT
 #define SL_MAX_HEIGHT 32
@@ -31,6 +33,10 @@
 ──────────────────────────────────────────────── */
 typedef struct SkipList_i32_t SkipList_i32;
 typedef struct SkipList_i32_t SkipMap_i32;
+// cursor over a list or map that remembers the path of its last operation
+typedef struct SkipListFinger_i32_t SkipListFinger_i32;
+// forward iterator over a list or map in ascending key order
+typedef struct SkipListIter_i32_t SkipListIter_i32;
 
 struct SM_i32_kv {
    int32_t key;
@@ -43,6 +49,9 @@ struct SM_i32_kv {
    ──────────────────────────────────────────────── */
 // Set
 SkipList_i32* skipList_i32_create(void);
+// nodes are carved from per height slabs, destroy releases whole slabs
+SkipList_i32* skipList_i32_create_with_arena(void);
+SkipList_i32* skipList_i32_create_with_allocator(const SkipListAllocator *allocator);
 bool  skipList_i32_insert (SkipList_i32 *list, int32_t id);
 void  skipList_i32_remove (SkipList_i32 *list, int32_t id);
 bool  skipList_i32_search (SkipList_i32 *list, int32_t search_id);
@@ -54,6 +63,8 @@ void  skipList_i32_print  (SkipList_i32 *list);
 
 // Map
 SkipMap_i32* skipMap_i32_create(void);
+SkipMap_i32* skipMap_i32_create_with_arena(void);
+SkipMap_i32* skipMap_i32_create_with_allocator(const SkipListAllocator *allocator);
 bool   skipMap_i32_put     (SkipMap_i32 *sm, int32_t id, void *data);
 void*  skipMap_i32_get     (SkipMap_i32 *sm, int32_t id);
 void*  skipMap_i32_remove  (SkipMap_i32 *sm, int32_t id);
@@ -63,3 +74,166 @@ bool skipMap_i32_isEmpty(const SkipMap_i32 *list);
 bool skipMap_i32_pop(SkipList_i32 * list, struct SM_i32_kv *sm);
 void   skipMap_i32_destroy (SkipMap_i32 **sm);
 void   skipMap_i32_print   (SkipMap_i32 *sm);
+
+// Finger, operations near the previous key cost O(log d) in the distance d.
+// Changes made to the list without this finger make it restart from the
+// header on its next use. Destroy fingers before their list
+SkipListFinger_i32* skipList_i32_finger_create(SkipList_i32 *list);
+SkipListFinger_i32* skipMap_i32_finger_create(SkipMap_i32 *sm);
+void  skipList_i32_finger_destroy(SkipListFinger_i32 **finger);
+bool  skipList_i32_finger_search(SkipListFinger_i32 *finger, int32_t id);
+bool  skipList_i32_finger_insert(SkipListFinger_i32 *finger, int32_t id);
+void  skipList_i32_finger_remove(SkipListFinger_i32 *finger, int32_t id);
+bool  skipMap_i32_finger_put   (SkipListFinger_i32 *finger, int32_t id, void *data);
+void* skipMap_i32_finger_get   (SkipListFinger_i32 *finger, int32_t id);
+void* skipMap_i32_finger_remove(SkipListFinger_i32 *finger, int32_t id);
+
+// Ordered navigation, one descent each. ceiling: smallest key >= id, floor:
+// largest key <= id, higher: smallest key > id, lower: largest key < id.
+// Return false when no such key exists, out may be NULL
+bool skipList_i32_ceiling(SkipList_i32 *list, int32_t id, int32_t *out);
+bool skipList_i32_floor  (SkipList_i32 *list, int32_t id, int32_t *out);
+bool skipList_i32_higher (SkipList_i32 *list, int32_t id, int32_t *out);
+bool skipList_i32_lower  (SkipList_i32 *list, int32_t id, int32_t *out);
+bool skipMap_i32_ceiling (SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out);
+bool skipMap_i32_floor   (SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out);
+bool skipMap_i32_higher  (SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out);
+bool skipMap_i32_lower   (SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out);
+
+// Range scan over [lo, hi), one descent to lo then a level 0 walk. Visitors
+// return false to stop early, scan returns the number of keys visited. The
+// list must not be modified from inside a visitor
+typedef bool (*SkipList_i32_visitor)(int32_t key, void *ctx);
+typedef bool (*SkipMap_i32_visitor)(int32_t key, void *value, void *ctx);
+uint32_t skipList_i32_scan(SkipList_i32 *list, int32_t lo, int32_t hi, SkipList_i32_visitor visit, void *ctx);
+uint32_t skipMap_i32_scan (SkipMap_i32 *sm, int32_t lo, int32_t hi, SkipMap_i32_visitor visit, void *ctx);
+// copies up to cap entries of [*lo, hi) into out and moves *lo past the last
+// one, call again with the same lo until it returns 0 to stream the range
+uint32_t skipList_i32_scanBatch(SkipList_i32 *list, int32_t *lo, int32_t hi, int32_t *out, uint32_t cap);
+uint32_t skipMap_i32_scanBatch (SkipMap_i32 *sm, int32_t *lo, int32_t hi, struct SM_i32_kv *out, uint32_t cap);
+
+// Iterator, starts at the smallest key, next() is O(1). When the current entry
+// is removed, through iter_remove or the list itself, the iterator stays
+// valid: key() still reports the removed key, value() returns NULL and next()
+// moves to the first key after it. Other changes to the list cost the next
+// call one descent to find its position again. Destroy iterators before their list
+SkipListIter_i32* skipList_i32_iter_create(SkipList_i32 *list);
+SkipListIter_i32* skipMap_i32_iter_create(SkipMap_i32 *sm);
+void  skipList_i32_iter_destroy(SkipListIter_i32 **it);
+// positions on the first key >= id, invalid when there is none
+void  skipList_i32_iter_seek (SkipListIter_i32 *it, int32_t id);
+bool  skipList_i32_iter_valid(const SkipListIter_i32 *it);
+bool  skipList_i32_iter_next (SkipListIter_i32 *it);
+int32_t skipList_i32_iter_key(const SkipListIter_i32 *it);
+void* skipMap_i32_iter_value (SkipListIter_i32 *it);
+// removes the current entry, false when it was already removed
+bool  skipList_i32_iter_remove(SkipListIter_i32 *it);
+// map removal returns the stored value for cleanup
+void* skipMap_i32_iter_remove (SkipListIter_i32 *it);
+
+// Indexable lists, created with SKIPLIST_INDEXABLE among the flags. rank is the
+// number of keys below id, select the key at 0 based position index (false
+// when index >= size), countRange the number of keys in [lo, hi). All O(log n)
+SkipList_i32* skipList_i32_create_with_flags(uint32_t flags);
+SkipMap_i32* skipMap_i32_create_with_flags(uint32_t flags);
+uint32_t skipList_i32_rank(SkipList_i32 *list, int32_t id);
+bool     skipList_i32_select(SkipList_i32 *list, uint32_t index, int32_t *out);
+uint32_t skipList_i32_countRange(SkipList_i32 *list, int32_t lo, int32_t hi);
+uint32_t skipMap_i32_rank(SkipMap_i32 *sm, int32_t id);
+bool     skipMap_i32_select(SkipMap_i32 *sm, uint32_t index, struct SM_i32_kv *out);
+uint32_t skipMap_i32_countRange(SkipMap_i32 *sm, int32_t lo, int32_t hi);
+
+// Reverse iteration. iter_last positions on the largest key and iter_seekBefore
+// on the last key < id, both work on any list. iter_prev and scanReverse (keys
+// of [lo, hi) in descending order) need lists created with SKIPLIST_BACKLINKS
+void  skipList_i32_iter_last(SkipListIter_i32 *it);
+void  skipList_i32_iter_seekBefore(SkipListIter_i32 *it, int32_t id);
+bool  skipList_i32_iter_prev(SkipListIter_i32 *it);
+uint32_t skipList_i32_scanReverse(SkipList_i32 *list, int32_t lo, int32_t hi, SkipList_i32_visitor visit, void *ctx);
+uint32_t skipMap_i32_scanReverse (SkipMap_i32 *sm, int32_t lo, int32_t hi, SkipMap_i32_visitor visit, void *ctx);
+
+// Double ended use. peekMin / peekMax are O(1), popMax removes the largest key
+// in expected O(1) using the per level tail pointers. All return false when empty
+bool skipList_i32_peekMin(const SkipList_i32 *list, int32_t *out);
+bool skipList_i32_peekMax(const SkipList_i32 *list, int32_t *out);
+bool skipList_i32_popMax(SkipList_i32 *list, int32_t *removed_id);
+bool skipMap_i32_peekMin(const SkipMap_i32 *sm, struct SM_i32_kv *kv);
+bool skipMap_i32_peekMax(const SkipMap_i32 *sm, struct SM_i32_kv *kv);
+bool skipMap_i32_popMax(SkipMap_i32 *sm, struct SM_i32_kv *kv);
+
+// Bulk build from ascending keys in one pass, towers are spaced evenly instead
+// of drawn at random. Duplicates collapse (for maps the last value wins). The
+// plain versions allocate nodes from an arena (SKIPLIST_ARENA), the _with_flags
+// versions take any creation flags. values is parallel to keys
+SkipList_i32* skipList_i32_buildFromSorted(const int32_t *keys, uint32_t n);
+SkipList_i32* skipList_i32_buildFromSorted_with_flags(const int32_t *keys, uint32_t n, uint32_t flags);
+SkipMap_i32* skipMap_i32_buildFromSorted(const int32_t *keys, void * const *values, uint32_t n);
+SkipMap_i32* skipMap_i32_buildFromSorted_with_flags(const int32_t *keys, void * const *values, uint32_t n, uint32_t flags);
+
+// Batch updates, keys in any order (sorted internally when needed) are merged
+// in one left to right pass. Return the number of keys inserted / removed, for
+// putBatch the number of new keys, values of existing keys are replaced and a
+// key repeated in the batch keeps its last value
+uint32_t skipList_i32_insertBatch(SkipList_i32 *list, const int32_t *keys, uint32_t n);
+uint32_t skipList_i32_removeBatch(SkipList_i32 *list, const int32_t *keys, uint32_t n);
+uint32_t skipMap_i32_putBatch(SkipMap_i32 *sm, const int32_t *keys, void * const *values, uint32_t n);
+
+// Range removal, unlinks every key of [lo, hi) with one splice per level and
+// returns how many left. on_remove (may be NULL) sees each key, and for maps its
+// value, in ascending order before the node is released
+typedef void (*SkipList_i32_on_remove)(int32_t key, void *ctx);
+typedef void (*SkipMap_i32_on_remove)(int32_t key, void *value, void *ctx);
+uint32_t skipList_i32_removeRange(SkipList_i32 *list, int32_t lo, int32_t hi, SkipList_i32_on_remove on_remove, void *ctx);
+uint32_t skipMap_i32_removeRange (SkipMap_i32 *sm, int32_t lo, int32_t hi, SkipMap_i32_on_remove on_remove, void *ctx);
+
+// Split and concat, split moves every key >= key into a new list returned
+// through right, concat appends all of right (every key greater than those
+// of left) and frees its shell. Both relink towers at the boundary only, nodes
+// keep their memory: arena backed lists share the arena after a split. Split
+// is O(log n) only on SKIPLIST_INDEXABLE lists, without spans it walks level 0
+// over the smaller side to count the new sizes, O(min(left, right)). Split
+// needs an allocator without free_all, concat the same flags and allocator on
+// both lists
+void skipList_i32_split (SkipList_i32 *list, int32_t key, SkipList_i32 **right);
+void skipList_i32_concat(SkipList_i32 *left, SkipList_i32 **right);
+void skipMap_i32_split  (SkipMap_i32 *sm, int32_t key, SkipMap_i32 **right);
+void skipMap_i32_concat (SkipMap_i32 *left, SkipMap_i32 **right);
+
+// Set algebra over the keys of two lists. union, intersect and difference
+// (keys of a missing from b) return a new arena backed list built in one pass,
+// isSubset is true when every key of a is in b. The InPlace forms change a
+// and return how many keys were added or removed. Level 0 is merged linearly
+// and the larger list is probed through a finger once the sizes are skewed
+SkipList_i32 *skipList_i32_union(SkipList_i32 *a, SkipList_i32 *b);
+SkipList_i32 *skipList_i32_intersect(SkipList_i32 *a, SkipList_i32 *b);
+SkipList_i32 *skipList_i32_difference(SkipList_i32 *a, SkipList_i32 *b);
+bool skipList_i32_isSubset(SkipList_i32 *a, SkipList_i32 *b);
+uint32_t skipList_i32_unionInPlace(SkipList_i32 *a, SkipList_i32 *b);
+uint32_t skipList_i32_intersectInPlace(SkipList_i32 *a, SkipList_i32 *b);
+uint32_t skipList_i32_differenceInPlace(SkipList_i32 *a, SkipList_i32 *b);
+
+// Clone and snapshot. clone copies every node into a new arena backed list in
+// one pass, keeping tower heights. snapshot is O(1): a read only list sharing
+// every node until the source is next written, which then copies once and
+// leaves the old nodes to its snapshots. A snapshot may be read from another
+// thread while the source keeps changing. Map values are shared by pointer and
+// owned by the source map alone: clones and snapshots never free one, not even
+// values put into a clone later. A map destroyed before its snapshots leaves
+// its values to the last of them, every value is freed once in either order
+SkipList_i32 *skipList_i32_clone(SkipList_i32 *list);
+SkipMap_i32 *skipMap_i32_clone(SkipMap_i32 *sm);
+SkipList_i32 *skipList_i32_snapshot(SkipList_i32 *list);
+SkipMap_i32 *skipMap_i32_snapshot(SkipMap_i32 *sm);
+
+// Creation from a SkipListOptions (see skiplist_flags.h), NULL gives the
+// defaults of create(). A seed makes tower heights reproducible
+SkipList_i32 *skipList_i32_create_with_options(const SkipListOptions *options);
+SkipMap_i32 *skipMap_i32_create_with_options(const SkipListOptions *options);
+
+// Recomputes every tower height in one level 0 pass so the levels match the
+// current size, the n-th key gets the height a bulk build would give it. Towers
+// already at that height stay in place, returns how many changed. A
+// rebalance_step in the options does the same incrementally from every write
+// but finger and iterator ones, see skiplist_flags.h
+uint32_t skipList_i32_rebalance(SkipList_i32 *list);
+uint32_t skipMap_i32_rebalance(SkipMap_i32 *sm);
@@ -19,6 +19,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <skiplist_allocator.h>
+#include <skiplist_flags.h>
 
 #ifndef SL_MAX_HEIGHT
 #define SL_MAX_HEIGHT 32
@@ -31,6 +33,10 @@
 ──────────────────────────────────────────────── */
 typedef struct SkipList_i64_t SkipList_i64;
 typedef struct SkipList_i64_t SkipMap_i64;
+// cursor over a list or map that remembers the path of its last operation
+typedef struct SkipListFinger_i64_t SkipListFinger_i64;
+// forward iterator over a list or map in ascending key order
+typedef struct SkipListIter_i64_t SkipListIter_i64;
 
 struct SM_i64_kv {
    int64_t key;
@@ -42,6 +48,9 @@ struct SM_i64_kv {
    ──────────────────────────────────────────────── */
 // Set
 SkipList_i64* skipList_i64_create(void);
+// nodes are carved from per height slabs, destroy releases whole slabs
+SkipList_i64* skipList_i64_create_with_arena(void);
+SkipList_i64* skipList_i64_create_with_allocator(const SkipListAllocator *allocator);
 bool  skipList_i64_insert (SkipList_i64 *list, int64_t id);
 void  skipList_i64_remove (SkipList_i64 *list, int64_t id);
 bool  skipList_i64_search (SkipList_i64 *list, int64_t search_id);
@@ -53,6 +62,8 @@ void  skipList_i64_print  (SkipList_i64 *list);
 
 // Map
 SkipMap_i64* skipMap_i64_create(void);
+SkipMap_i64* skipMap_i64_create_with_arena(void);
+SkipMap_i64* skipMap_i64_create_with_allocator(const SkipListAllocator *allocator);
 bool   skipMap_i64_put     (SkipMap_i64 *sm, int64_t id, void *data);
 void*  skipMap_i64_get     (SkipMap_i64 *sm, int64_t id);
 void*  skipMap_i64_remove  (SkipMap_i64 *sm, int64_t id);
@@ -61,4 +72,167 @@ uint32_t skipMap_i64_getSize(const SkipMap_i64 *list);
 bool skipMap_i64_isEmpty(const SkipMap_i64 *list);
 bool skipMap_i64_pop(SkipMap_i64 *list, struct SM_i64_kv * kv);
 void   skipMap_i64_destroy (SkipMap_i64 **sm);
-void   skipMap_i64_print   (SkipMap_i64 *sm);
\ No newline at end of file
+void   skipMap_i64_print   (SkipMap_i64 *sm);
+
+// Finger, operations near the previous key cost O(log d) in the distance d.
+// Changes made to the list without this finger make it restart from the
+// header on its next use. Destroy fingers before their list
+SkipListFinger_i64* skipList_i64_finger_create(SkipList_i64 *list);
+SkipListFinger_i64* skipMap_i64_finger_create(SkipMap_i64 *sm);
+void  skipList_i64_finger_destroy(SkipListFinger_i64 **finger);
+bool  skipList_i64_finger_search(SkipListFinger_i64 *finger, int64_t id);
+bool  skipList_i64_finger_insert(SkipListFinger_i64 *finger, int64_t id);
+void  skipList_i64_finger_remove(SkipListFinger_i64 *finger, int64_t id);
+bool  skipMap_i64_finger_put   (SkipListFinger_i64 *finger, int64_t id, void *data);
+void* skipMap_i64_finger_get   (SkipListFinger_i64 *finger, int64_t id);
+void* skipMap_i64_finger_remove(SkipListFinger_i64 *finger, int64_t id);
+
+// Ordered navigation, one descent each. ceiling: smallest key >= id, floor:
+// largest key <= id, higher: smallest key > id, lower: largest key < id.
+// Return false when no such key exists, out may be NULL
+bool skipList_i64_ceiling(SkipList_i64 *list, int64_t id, int64_t *out);
+bool skipList_i64_floor  (SkipList_i64 *list, int64_t id, int64_t *out);
+bool skipList_i64_higher (SkipList_i64 *list, int64_t id, int64_t *out);
+bool skipList_i64_lower  (SkipList_i64 *list, int64_t id, int64_t *out);
+bool skipMap_i64_ceiling (SkipMap_i64 *sm, int64_t id, struct SM_i64_kv *out);
+bool skipMap_i64_floor   (SkipMap_i64 *sm, int64_t id, struct SM_i64_kv *out);
+bool skipMap_i64_higher  (SkipMap_i64 *sm, int64_t id, struct SM_i64_kv *out);
+bool skipMap_i64_lower   (SkipMap_i64 *sm, int64_t id, struct SM_i64_kv *out);
+
+// Range scan over [lo, hi), one descent to lo then a level 0 walk. Visitors
+// return false to stop early, scan returns the number of keys visited. The
+// list must not be modified from inside a visitor
+typedef bool (*SkipList_i64_visitor)(int64_t key, void *ctx);
+typedef bool (*SkipMap_i64_visitor)(int64_t key, void *value, void *ctx);
+uint32_t skipList_i64_scan(SkipList_i64 *list, int64_t lo, int64_t hi, SkipList_i64_visitor visit, void *ctx);
+uint32_t skipMap_i64_scan (SkipMap_i64 *sm, int64_t lo, int64_t hi, SkipMap_i64_visitor visit, void *ctx);
+// copies up to cap entries of [*lo, hi) into out and moves *lo past the last
+// one, call again with the same lo until it returns 0 to stream the range
+uint32_t skipList_i64_scanBatch(SkipList_i64 *list, int64_t *lo, int64_t hi, int64_t *out, uint32_t cap);
+uint32_t skipMap_i64_scanBatch (SkipMap_i64 *sm, int64_t *lo, int64_t hi, struct SM_i64_kv *out, uint32_t cap);
+
+// Iterator, starts at the smallest key, next() is O(1). When the current entry
+// is removed, through iter_remove or the list itself, the iterator stays
+// valid: key() still reports the removed key, value() returns NULL and next()
+// moves to the first key after it. Other changes to the list cost the next
+// call one descent to find its position again. Destroy iterators before their list
+SkipListIter_i64* skipList_i64_iter_create(SkipList_i64 *list);
+SkipListIter_i64* skipMap_i64_iter_create(SkipMap_i64 *sm);
+void  skipList_i64_iter_destroy(SkipListIter_i64 **it);
+// positions on the first key >= id, invalid when there is none
+void  skipList_i64_iter_seek (SkipListIter_i64 *it, int64_t id);
+bool  skipList_i64_iter_valid(const SkipListIter_i64 *it);
+bool  skipList_i64_iter_next (SkipListIter_i64 *it);
+int64_t skipList_i64_iter_key(const SkipListIter_i64 *it);
+void* skipMap_i64_iter_value (SkipListIter_i64 *it);
+// removes the current entry, false when it was already removed
+bool  skipList_i64_iter_remove(SkipListIter_i64 *it);
+// map removal returns the stored value for cleanup
+void* skipMap_i64_iter_remove (SkipListIter_i64 *it);
+
+// Indexable lists, created with SKIPLIST_INDEXABLE among the flags. rank is the
+// number of keys below id, select the key at 0 based position index (false
+// when index >= size), countRange the number of keys in [lo, hi). All O(log n)
+SkipList_i64* skipList_i64_create_with_flags(uint32_t flags);
+SkipMap_i64* skipMap_i64_create_with_flags(uint32_t flags);
+uint32_t skipList_i64_rank(SkipList_i64 *list, int64_t id);
+bool     skipList_i64_select(SkipList_i64 *list, uint32_t index, int64_t *out);
+uint32_t skipList_i64_countRange(SkipList_i64 *list, int64_t lo, int64_t hi);
+uint32_t skipMap_i64_rank(SkipMap_i64 *sm, int64_t id);
+bool     skipMap_i64_select(SkipMap_i64 *sm, uint32_t index, struct SM_i64_kv *out);
+uint32_t skipMap_i64_countRange(SkipMap_i64 *sm, int64_t lo, int64_t hi);
+
+// Reverse iteration. iter_last positions on the largest key and iter_seekBefore
+// on the last key < id, both work on any list. iter_prev and scanReverse (keys
+// of [lo, hi) in descending order) need lists created with SKIPLIST_BACKLINKS
+void  skipList_i64_iter_last(SkipListIter_i64 *it);
+void  skipList_i64_iter_seekBefore(SkipListIter_i64 *it, int64_t id);
+bool  skipList_i64_iter_prev(SkipListIter_i64 *it);
+uint32_t skipList_i64_scanReverse(SkipList_i64 *list, int64_t lo, int64_t hi, SkipList_i64_visitor visit, void *ctx);
+uint32_t skipMap_i64_scanReverse (SkipMap_i64 *sm, int64_t lo, int64_t hi, SkipMap_i64_visitor visit, void *ctx);
+
+// Double ended use. peekMin / peekMax are O(1), popMax removes the largest key
+// in expected O(1) using the per level tail pointers. All return false when empty
+bool skipList_i64_peekMin(const SkipList_i64 *list, int64_t *out);
+bool skipList_i64_peekMax(const SkipList_i64 *list, int64_t *out);
+bool skipList_i64_popMax(SkipList_i64 *list, int64_t *removed_id);
+bool skipMap_i64_peekMin(const SkipMap_i64 *sm, struct SM_i64_kv *kv);
+bool skipMap_i64_peekMax(const SkipMap_i64 *sm, struct SM_i64_kv *kv);
+bool skipMap_i64_popMax(SkipMap_i64 *sm, struct SM_i64_kv *kv);
+
+// Bulk build from ascending keys in one pass, towers are spaced evenly instead
+// of drawn at random. Duplicates collapse (for maps the last value wins). The
+// plain versions allocate nodes from an arena (SKIPLIST_ARENA), the _with_flags
+// versions take any creation flags. values is parallel to keys
+SkipList_i64* skipList_i64_buildFromSorted(const int64_t *keys, uint32_t n);
+SkipList_i64* skipList_i64_buildFromSorted_with_flags(const int64_t *keys, uint32_t n, uint32_t flags);
+SkipMap_i64* skipMap_i64_buildFromSorted(const int64_t *keys, void * const *values, uint32_t n);
+SkipMap_i64* skipMap_i64_buildFromSorted_with_flags(const int64_t *keys, void * const *values, uint32_t n, uint32_t flags);
+
+// Batch updates, keys in any order (sorted internally when needed) are merged
+// in one left to right pass. Return the number of keys inserted / removed, for
+// putBatch the number of new keys, values of existing keys are replaced and a
+// key repeated in the batch keeps its last value
+uint32_t skipList_i64_insertBatch(SkipList_i64 *list, const int64_t *keys, uint32_t n);
+uint32_t skipList_i64_removeBatch(SkipList_i64 *list, const int64_t *keys, uint32_t n);
+uint32_t skipMap_i64_putBatch(SkipMap_i64 *sm, const int64_t *keys, void * const *values, uint32_t n);
+
+// Range removal, unlinks every key of [lo, hi) with one splice per level and
+// returns how many left. on_remove (may be NULL) sees each key, and for maps its
+// value, in ascending order before the node is released
+typedef void (*SkipList_i64_on_remove)(int64_t key, void *ctx);
+typedef void (*SkipMap_i64_on_remove)(int64_t key, void *value, void *ctx);
+uint32_t skipList_i64_removeRange(SkipList_i64 *list, int64_t lo, int64_t hi, SkipList_i64_on_remove on_remove, void *ctx);
+uint32_t skipMap_i64_removeRange (SkipMap_i64 *sm, int64_t lo, int64_t hi, SkipMap_i64_on_remove on_remove, void *ctx);
+
+// Split and concat, split moves every key >= key into a new list returned
+// through right, concat appends all of right (every key greater than those
+// of left) and frees its shell. Both relink towers at the boundary only, nodes
+// keep their memory: arena backed lists share the arena after a split. Split
+// is O(log n) only on SKIPLIST_INDEXABLE lists, without spans it walks level 0
+// over the smaller side to count the new sizes, O(min(left, right)). Split
+// needs an allocator without free_all, concat the same flags and allocator on
+// both lists
+void skipList_i64_split (SkipList_i64 *list, int64_t key, SkipList_i64 **right);
+void skipList_i64_concat(SkipList_i64 *left, SkipList_i64 **right);
+void skipMap_i64_split  (SkipMap_i64 *sm, int64_t key, SkipMap_i64 **right);
+void skipMap_i64_concat (SkipMap_i64 *left, SkipMap_i64 **right);
+
+// Set algebra over the keys of two lists. union, intersect and difference
+// (keys of a missing from b) return a new arena backed list built in one pass,
+// isSubset is true when every key of a is in b. The InPlace forms change a
+// and return how many keys were added or removed. Level 0 is merged linearly
+// and the larger list is probed through a finger once the sizes are skewed
+SkipList_i64 *skipList_i64_union(SkipList_i64 *a, SkipList_i64 *b);
+SkipList_i64 *skipList_i64_intersect(SkipList_i64 *a, SkipList_i64 *b);
+SkipList_i64 *skipList_i64_difference(SkipList_i64 *a, SkipList_i64 *b);
+bool skipList_i64_isSubset(SkipList_i64 *a, SkipList_i64 *b);
+uint32_t skipList_i64_unionInPlace(SkipList_i64 *a, SkipList_i64 *b);
+uint32_t skipList_i64_intersectInPlace(SkipList_i64 *a, SkipList_i64 *b);
+uint32_t skipList_i64_differenceInPlace(SkipList_i64 *a, SkipList_i64 *b);
+
+// Clone and snapshot. clone copies every node into a new arena backed list in
+// one pass, keeping tower heights. snapshot is O(1): a read only list sharing
+// every node until the source is next written, which then copies once and
+// leaves the old nodes to its snapshots. A snapshot may be read from another
+// thread while the source keeps changing. Map values are shared by pointer and
+// owned by the source map alone: clones and snapshots never free one, not even
+// values put into a clone later. A map destroyed before its snapshots leaves
+// its values to the last of them, every value is freed once in either order
+SkipList_i64 *skipList_i64_clone(SkipList_i64 *list);
+SkipMap_i64 *skipMap_i64_clone(SkipMap_i64 *sm);
+SkipList_i64 *skipList_i64_snapshot(SkipList_i64 *list);
+SkipMap_i64 *skipMap_i64_snapshot(SkipMap_i64 *sm);
+
+// Creation from a SkipListOptions (see skiplist_flags.h), NULL gives the
+// defaults of create(). A seed makes tower heights reproducible
+SkipList_i64 *skipList_i64_create_with_options(const SkipListOptions *options);
+SkipMap_i64 *skipMap_i64_create_with_options(const SkipListOptions *options);
+
+// Recomputes every tower height in one level 0 pass so the levels match the
+// current size, the n-th key gets the height a bulk build would give it. Towers
+// already at that height stay in place, returns how many changed. A
+// rebalance_step in the options does the same incrementally from every write
+// but finger and iterator ones, see skiplist_flags.h
+uint32_t skipList_i64_rebalance(SkipList_i64 *list);
+uint32_t skipMap_i64_rebalance(SkipMap_i64 *sm);
@@ -18,6 +18,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <skiplist_allocator.h>
+#include <skiplist_flags.h>
 
 #ifndef SL_MAX_HEIGHT
 #define SL_MAX_HEIGHT 32
@@ -29,6 +31,10 @@
 
 typedef struct SkipList_u64_t SkipList_u64;
 typedef struct SkipList_u64_t SkipMap_u64;
+// cursor over a list or map that remembers the path of its last operation
+typedef struct SkipListFinger_u64_t SkipListFinger_u64;
+// forward iterator over a list or map in ascending key order
+typedef struct SkipListIter_u64_t SkipListIter_u64;
 
 struct SM_u64_kv {
    uint64_t key;
@@ -41,9 +47,18 @@ struct SM_u64_kv {
    ──────────────────────────────────────────────── */
 // Set
 SkipList_u64* skipList_u64_create(void);
+// nodes are carved from per height slabs, destroy releases whole slabs
+SkipList_u64* skipList_u64_create_with_arena(void);
+SkipList_u64* skipList_u64_create_with_allocator(const SkipListAllocator *allocator);
 bool  skipList_u64_insert (SkipList_u64 *list, uint64_t id);
 void  skipList_u64_remove (SkipList_u64 *list, uint64_t id);
 bool  skipList_u64_search (SkipList_u64 *list, uint64_t search_id);
+// results[i] = search(keys[i]) for n unrelated keys, descents are interleaved so
+// their cache misses overlap. Returns the number of keys found
+uint32_t skipList_u64_searchMany(SkipList_u64 *list, const uint64_t *keys, uint32_t n, bool *results);
+// same contract for keys in ascending order, each probe resumes from the path of
+// the previous one instead of the header. Out of order keys are still answered
+uint32_t skipList_u64_searchSorted(SkipList_u64 *list, const uint64_t *keys, uint32_t n, bool *results);
 uint32_t skipList_u64_getSize(const SkipList_u64 *list);
 bool skipList_u64_isEmpty(const SkipList_u64 *list);
 bool skipList_u64_pop(SkipList_u64 *list, uint64_t * removed_id);
@@ -52,8 +67,13 @@ void  skipList_u64_print  (SkipList_u64 *list);
 
 // Map
 SkipMap_u64* skipMap_u64_create(void);
+SkipMap_u64* skipMap_u64_create_with_arena(void);
+SkipMap_u64* skipMap_u64_create_with_allocator(const SkipListAllocator *allocator);
 bool   skipMap_u64_put     (SkipMap_u64 *sm, uint64_t id, void *data);
 void*  skipMap_u64_get     (SkipMap_u64 *sm, uint64_t id);
+// values[i] = get(keys[i]), NULL when absent. Returns the number of keys found
+uint32_t skipMap_u64_getMany(SkipMap_u64 *sm, const uint64_t *keys, uint32_t n, void **values);
+uint32_t skipMap_u64_getSorted(SkipMap_u64 *sm, const uint64_t *keys, uint32_t n, void **values);
 void*  skipMap_u64_remove  (SkipMap_u64 *sm, uint64_t id);
 bool   skipMap_u64_contains(SkipMap_u64 *sm, uint64_t id);
 uint32_t skipMap_u64_getSize(SkipMap_u64 *sm);
@@ -61,3 +81,166 @@ bool   skipMap_u64_isEmpty(SkipMap_u64 *sm);
 bool skipMap_u64_pop(SkipMap_u64 *sm, struct SM_u64_kv * kv);
 void   skipMap_u64_destroy (SkipMap_u64 **sm);
 void   skipMap_u64_print   (SkipMap_u64 *sm);
+
+// Finger, operations near the previous key cost O(log d) in the distance d.
+// Changes made to the list without this finger make it restart from the
+// header on its next use. Destroy fingers before their list
+SkipListFinger_u64* skipList_u64_finger_create(SkipList_u64 *list);
+SkipListFinger_u64* skipMap_u64_finger_create(SkipMap_u64 *sm);
+void  skipList_u64_finger_destroy(SkipListFinger_u64 **finger);
+bool  skipList_u64_finger_search(SkipListFinger_u64 *finger, uint64_t id);
+bool  skipList_u64_finger_insert(SkipListFinger_u64 *finger, uint64_t id);
+void  skipList_u64_finger_remove(SkipListFinger_u64 *finger, uint64_t id);
+bool  skipMap_u64_finger_put   (SkipListFinger_u64 *finger, uint64_t id, void *data);
+void* skipMap_u64_finger_get   (SkipListFinger_u64 *finger, uint64_t id);
+void* skipMap_u64_finger_remove(SkipListFinger_u64 *finger, uint64_t id);
+
+// Ordered navigation, one descent each. ceiling: smallest key >= id, floor:
+// largest key <= id, higher: smallest key > id, lower: largest key < id.
+// Return false when no such key exists, out may be NULL
+bool skipList_u64_ceiling(SkipList_u64 *list, uint64_t id, uint64_t *out);
+bool skipList_u64_floor  (SkipList_u64 *list, uint64_t id, uint64_t *out);
+bool skipList_u64_higher (SkipList_u64 *list, uint64_t id, uint64_t *out);
+bool skipList_u64_lower  (SkipList_u64 *list, uint64_t id, uint64_t *out);
+bool skipMap_u64_ceiling (SkipMap_u64 *sm, uint64_t id, struct SM_u64_kv *out);
+bool skipMap_u64_floor   (SkipMap_u64 *sm, uint64_t id, struct SM_u64_kv *out);
+bool skipMap_u64_higher  (SkipMap_u64 *sm, uint64_t id, struct SM_u64_kv *out);
+bool skipMap_u64_lower   (SkipMap_u64 *sm, uint64_t id, struct SM_u64_kv *out);
+
+// Range scan over [lo, hi), one descent to lo then a level 0 walk. Visitors
+// return false to stop early, scan returns the number of keys visited. The
+// list must not be modified from inside a visitor
+typedef bool (*SkipList_u64_visitor)(uint64_t key, void *ctx);
+typedef bool (*SkipMap_u64_visitor)(uint64_t key, void *value, void *ctx);
+uint32_t skipList_u64_scan(SkipList_u64 *list, uint64_t lo, uint64_t hi, SkipList_u64_visitor visit, void *ctx);
+uint32_t skipMap_u64_scan (SkipMap_u64 *sm, uint64_t lo, uint64_t hi, SkipMap_u64_visitor visit, void *ctx);
+// copies up to cap entries of [*lo, hi) into out and moves *lo past the last
+// one, call again with the same lo until it returns 0 to stream the range
+uint32_t skipList_u64_scanBatch(SkipList_u64 *list, uint64_t *lo, uint64_t hi, uint64_t *out, uint32_t cap);
+uint32_t skipMap_u64_scanBatch (SkipMap_u64 *sm, uint64_t *lo, uint64_t hi, struct SM_u64_kv *out, uint32_t cap);
+
+// Iterator, starts at the smallest key, next() is O(1). When the current entry
+// is removed, through iter_remove or the list itself, the iterator stays
+// valid: key() still reports the removed key, value() returns NULL and next()
+// moves to the first key after it. Other changes to the list cost the next
+// call one descent to find its position again. Destroy iterators before their list
+SkipListIter_u64* skipList_u64_iter_create(SkipList_u64 *list);
+SkipListIter_u64* skipMap_u64_iter_create(SkipMap_u64 *sm);
+void  skipList_u64_iter_destroy(SkipListIter_u64 **it);
+// positions on the first key >= id, invalid when there is none
+void  skipList_u64_iter_seek (SkipListIter_u64 *it, uint64_t id);
+bool  skipList_u64_iter_valid(const SkipListIter_u64 *it);
+bool  skipList_u64_iter_next (SkipListIter_u64 *it);
+uint64_t skipList_u64_iter_key(const SkipListIter_u64 *it);
+void* skipMap_u64_iter_value (SkipListIter_u64 *it);
+// removes the current entry, false when it was already removed
+bool  skipList_u64_iter_remove(SkipListIter_u64 *it);
+// map removal returns the stored value for cleanup
+void* skipMap_u64_iter_remove (SkipListIter_u64 *it);
+
+// Indexable lists, created with SKIPLIST_INDEXABLE among the flags. rank is the
+// number of keys below id, select the key at 0 based position index (false
+// when index >= size), countRange the number of keys in [lo, hi). All O(log n)
+SkipList_u64* skipList_u64_create_with_flags(uint32_t flags);
+SkipMap_u64* skipMap_u64_create_with_flags(uint32_t flags);
+uint32_t skipList_u64_rank(SkipList_u64 *list, uint64_t id);
+bool     skipList_u64_select(SkipList_u64 *list, uint32_t index, uint64_t *out);
+uint32_t skipList_u64_countRange(SkipList_u64 *list, uint64_t lo, uint64_t hi);
+uint32_t skipMap_u64_rank(SkipMap_u64 *sm, uint64_t id);
+bool     skipMap_u64_select(SkipMap_u64 *sm, uint32_t index, struct SM_u64_kv *out);
+uint32_t skipMap_u64_countRange(SkipMap_u64 *sm, uint64_t lo, uint64_t hi);
+
+// Reverse iteration. iter_last positions on the largest key and iter_seekBefore
+// on the last key < id, both work on any list. iter_prev and scanReverse (keys
+// of [lo, hi) in descending order) need lists created with SKIPLIST_BACKLINKS
+void  skipList_u64_iter_last(SkipListIter_u64 *it);
+void  skipList_u64_iter_seekBefore(SkipListIter_u64 *it, uint64_t id);
+bool  skipList_u64_iter_prev(SkipListIter_u64 *it);
+uint32_t skipList_u64_scanReverse(SkipList_u64 *list, uint64_t lo, uint64_t hi, SkipList_u64_visitor visit, void *ctx);
+uint32_t skipMap_u64_scanReverse (SkipMap_u64 *sm, uint64_t lo, uint64_t hi, SkipMap_u64_visitor visit, void *ctx);
+
+// Double ended use. peekMin / peekMax are O(1), popMax removes the largest key
+// in expected O(1) using the per level tail pointers. All return false when empty
+bool skipList_u64_peekMin(const SkipList_u64 *list, uint64_t *out);
+bool skipList_u64_peekMax(const SkipList_u64 *list, uint64_t *out);
+bool skipList_u64_popMax(SkipList_u64 *list, uint64_t *removed_id);
+bool skipMap_u64_peekMin(const SkipMap_u64 *sm, struct SM_u64_kv *kv);
+bool skipMap_u64_peekMax(const SkipMap_u64 *sm, struct SM_u64_kv *kv);
+bool skipMap_u64_popMax(SkipMap_u64 *sm, struct SM_u64_kv *kv);
+
+// Bulk build from ascending keys in one pass, towers are spaced evenly instead
+// of drawn at random. Duplicates collapse (for maps the last value wins). The
+// plain versions allocate nodes from an arena (SKIPLIST_ARENA), the _with_flags
+// versions take any creation flags. values is parallel to keys
+SkipList_u64* skipList_u64_buildFromSorted(const uint64_t *keys, uint32_t n);
+SkipList_u64* skipList_u64_buildFromSorted_with_flags(const uint64_t *keys, uint32_t n, uint32_t flags);
+SkipMap_u64* skipMap_u64_buildFromSorted(const uint64_t *keys, void * const *values, uint32_t n);
+SkipMap_u64* skipMap_u64_buildFromSorted_with_flags(const uint64_t *keys, void * const *values, uint32_t n, uint32_t flags);
+
+// Batch updates, keys in any order (sorted internally when needed) are merged
+// in one left to right pass. Return the number of keys inserted / removed, for
+// putBatch the number of new keys, values of existing keys are replaced and a
+// key repeated in the batch keeps its last value
+uint32_t skipList_u64_insertBatch(SkipList_u64 *list, const uint64_t *keys, uint32_t n);
+uint32_t skipList_u64_removeBatch(SkipList_u64 *list, const uint64_t *keys, uint32_t n);
+uint32_t skipMap_u64_putBatch(SkipMap_u64 *sm, const uint64_t *keys, void * const *values, uint32_t n);
+
+// Range removal, unlinks every key of [lo, hi) with one splice per level and
+// returns how many left. on_remove (may be NULL) sees each key, and for maps its
+// value, in ascending order before the node is released
+typedef void (*SkipList_u64_on_remove)(uint64_t key, void *ctx);
+typedef void (*SkipMap_u64_on_remove)(uint64_t key, void *value, void *ctx);
+uint32_t skipList_u64_removeRange(SkipList_u64 *list, uint64_t lo, uint64_t hi, SkipList_u64_on_remove on_remove, void *ctx);
+uint32_t skipMap_u64_removeRange (SkipMap_u64 *sm, uint64_t lo, uint64_t hi, SkipMap_u64_on_remove on_remove, void *ctx);
+
+// Split and concat, split moves every key >= key into a new list returned
+// through right, concat appends all of right (every key greater than those
+// of left) and frees its shell. Both relink towers at the boundary only, nodes
+// keep their memory: arena backed lists share the arena after a split. Split
+// is O(log n) only on SKIPLIST_INDEXABLE lists, without spans it walks level 0
+// over the smaller side to count the new sizes, O(min(left, right)). Split
+// needs an allocator without free_all, concat the same flags and allocator on
+// both lists
+void skipList_u64_split (SkipList_u64 *list, uint64_t key, SkipList_u64 **right);
+void skipList_u64_concat(SkipList_u64 *left, SkipList_u64 **right);
+void skipMap_u64_split  (SkipMap_u64 *sm, uint64_t key, SkipMap_u64 **right);
+void skipMap_u64_concat (SkipMap_u64 *left, SkipMap_u64 **right);
+
+// Set algebra over the keys of two lists. union, intersect and difference
+// (keys of a missing from b) return a new arena backed list built in one pass,
+// isSubset is true when every key of a is in b. The InPlace forms change a
+// and return how many keys were added or removed. Level 0 is merged linearly
+// and the larger list is probed through a finger once the sizes are skewed
+SkipList_u64 *skipList_u64_union(SkipList_u64 *a, SkipList_u64 *b);
+SkipList_u64 *skipList_u64_intersect(SkipList_u64 *a, SkipList_u64 *b);
+SkipList_u64 *skipList_u64_difference(SkipList_u64 *a, SkipList_u64 *b);
+bool skipList_u64_isSubset(SkipList_u64 *a, SkipList_u64 *b);
+uint32_t skipList_u64_unionInPlace(SkipList_u64 *a, SkipList_u64 *b);
+uint32_t skipList_u64_intersectInPlace(SkipList_u64 *a, SkipList_u64 *b);
+uint32_t skipList_u64_differenceInPlace(SkipList_u64 *a, SkipList_u64 *b);
+
+// Clone and snapshot. clone copies every node into a new arena backed list in
+// one pass, keeping tower heights. snapshot is O(1): a read only list sharing
+// every node until the source is next written, which then copies once and
+// leaves the old nodes to its snapshots. A snapshot may be read from another
+// thread while the source keeps changing. Map values are shared by pointer and
+// owned by the source map alone: clones and snapshots never free one, not even
+// values put into a clone later. A map destroyed before its snapshots leaves
+// its values to the last of them, every value is freed once in either order
+SkipList_u64 *skipList_u64_clone(SkipList_u64 *list);
+SkipMap_u64 *skipMap_u64_clone(SkipMap_u64 *sm);
+SkipList_u64 *skipList_u64_snapshot(SkipList_u64 *list);
+SkipMap_u64 *skipMap_u64_snapshot(SkipMap_u64 *sm);
+
+// Creation from a SkipListOptions (see skiplist_flags.h), NULL gives the
+// defaults of create(). A seed makes tower heights reproducible
+SkipList_u64 *skipList_u64_create_with_options(const SkipListOptions *options);
+SkipMap_u64 *skipMap_u64_create_with_options(const SkipListOptions *options);
+
+// Recomputes every tower height in one level 0 pass so the levels match the
+// current size, the n-th key gets the height a bulk build would give it. Towers
+// already at that height stay in place, returns how many changed. A
+// rebalance_step in the options does the same incrementally from every write
+// but finger and iterator ones, see skiplist_flags.h
+uint32_t skipList_u64_rebalance(SkipList_u64 *list);
+uint32_t skipMap_u64_rebalance(SkipMap_u64 *sm);
@@ -21,6 +21,8 @@
 #include <stdbool.h>
 #include <assert.h>
 #include <math.h>
+#include <skiplist_allocator.h>
+#include <skiplist_flags.h>
 
 
 
@@ -41,6 +43,10 @@
 #endif
 
 #define DEFINE_GENERIC_SKIPMAP(NAME, KEY_TYPE, DATA_TYPE, CMP_FUNC, ON_REMOVE_FUNC_KEY, ON_DESTROY_FUNC) \
+    DEFINE_GENERIC_SKIPMAP_WITH_ALLOCATOR(NAME, KEY_TYPE, DATA_TYPE, CMP_FUNC, ON_REMOVE_FUNC_KEY, ON_DESTROY_FUNC, NULL)
+
+// ALLOCATOR is an expression yielding the const SkipListAllocator * used by _create (NULL means malloc/free)
+#define DEFINE_GENERIC_SKIPMAP_WITH_ALLOCATOR(NAME, KEY_TYPE, DATA_TYPE, CMP_FUNC, ON_REMOVE_FUNC_KEY, ON_DESTROY_FUNC, ALLOCATOR) \
                                                                                      \
     typedef struct Node_##NAME##_t {                                                 \
         KEY_TYPE key;                                                                \
@@ -53,6 +59,10 @@
         uint32_t size;                                                               \
         uint32_t max_level;                                                          \
         Node_##NAME * header;                                                        \
+        SkipListAllocator allocator;                                                 \
+        uint32_t max_height;                                                         \
+        double p_lo;                                                                 \
+        double p_hi;                                                                 \
     }SkipMap_##NAME;                                                                 \
     struct SM_##NAME##_kv{                                                           \
         KEY_TYPE key;                                                                \
@@ -65,25 +75,32 @@
         return lvl;                                                                  \
     }                                                                                \
                                                                                      \
-    static inline int getDynamicPromotionProb_##NAME(uint32_t size, uint32_t level){ \
-        double p = pow((double)(size ? size : 2), -1.0 / level);                     \
-        if (p < P) p = P;                                                            \
-        if (p > P_Upper) p = P_Upper;                                                \
+    static inline int getDynamicPromotionProb_##NAME(const SkipMap_##NAME * sm){     \
+        double p = sm->p_lo;                                                         \
+        if(sm->p_lo < sm->p_hi){                                                     \
+            p = pow((double)(sm->size ? sm->size : 2), -1.0 / sm->max_level);        \
+        }                                                                            \
+        if (p < sm->p_lo) p = sm->p_lo;                                              \
+        if (p > sm->p_hi) p = sm->p_hi;                                              \
         return (int)(p*100);                                                         \
     }                                                                                \
                                                                                      \
-    static inline uint32_t getRandomLevel_##NAME(uint32_t size, uint32_t max_level){ \
+    static inline uint32_t getRandomLevel_##NAME(const SkipMap_##NAME * sm){         \
         uint32_t lvl = 1;                                                            \
-        int prob = getDynamicPromotionProb_##NAME(size, max_level);                  \
-        while(((rand()%100) <= prob) && lvl < SL_MAX_HEIGHT){                        \
+        int prob = getDynamicPromotionProb_##NAME(sm);                               \
+        while(((rand()%100) <= prob) && lvl < sm->max_height){                       \
             lvl++;                                                                   \
         }                                                                            \
         return lvl;                                                                  \
     }                                                                                \
                                                                                      \
-    static inline Node_##NAME * getNode_##NAME(uint32_t level, KEY_TYPE key, DATA_TYPE data) { \
+    static inline size_t nodeSize_##NAME(uint32_t level){                                                            \
+        return sizeof(Node_##NAME) + level * sizeof(Node_##NAME *);                                                  \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline Node_##NAME * getNode_##NAME(SkipMap_##NAME * sm, uint32_t level, KEY_TYPE key, DATA_TYPE data) {  \
         level = clamp_level_##NAME(level);                                                     \
-        Node_##NAME * node = (Node_##NAME *)malloc(sizeof(Node_##NAME) + level * sizeof(Node_##NAME)); \
+        Node_##NAME * node = (Node_##NAME *)skipListAllocator_alloc(&sm->allocator, nodeSize_##NAME(level));         \
         assert(node);                                                                          \
         node->key = key;                                                                       \
         node->height = level;                                                                  \
@@ -106,14 +123,14 @@
             x->data = data;                                                                                         \
             return true;                                                                                            \
         }                                                                                                           \
-        uint32_t height = getRandomLevel_##NAME(sm->size, sm->max_level);                                           \
+        uint32_t height = getRandomLevel_##NAME(sm);                                                                \
         if(height > sm->max_level){                                                                                 \
             for(uint32_t i = sm->max_level; i < height; i++){                                                       \
                 update[i] = sm->header;                                                                             \
             }                                                                                                       \
             sm->max_level = height;                                                                                 \
         }                                                                                                           \
-        Node_##NAME * insertionNode = getNode_##NAME(height, key, data);                                            \
+        Node_##NAME * insertionNode = getNode_##NAME(sm, height, key, data);                                            \
         for(uint32_t i = 0; i < height; i++){                                                                       \
             insertionNode->forward[i] = update[i]->forward[i];                                                      \
             update[i]->forward[i] = insertionNode;                                                                  \
@@ -158,7 +175,7 @@
         }                                                                                                           \
         *item = removalNode->data;                                                                                  \
         ON_REMOVE_FUNC_KEY(removalNode->key);                                                                       \
-        free(removalNode);                                                                                          \
+        skipListAllocator_free(&sm->allocator, removalNode, nodeSize_##NAME(removalNode->height));                   \
         sm->size--;                                                                                                 \
         while(sm->max_level > 1 && !(sm->header->forward[sm->max_level-1]))sm->max_level--;                         \
         return true;                                                                                                \
@@ -180,32 +197,159 @@
         for(uint32_t i =0; i < x->height; i++){                                                                     \
             sm->header->forward[i] = x->forward[i];                                                                 \
         }                                                                                                           \
-        free(x);                                                                                                    \
+        skipListAllocator_free(&sm->allocator, x, nodeSize_##NAME(x->height));                                       \
         sm->size--;                                                                                                 \
         return true;                                                                                                \
     }                                                                                                               \
                                                                                                                     \
+    static inline Node_##NAME * lastBefore_##NAME(SkipMap_##NAME * sm, KEY_TYPE key){                               \
+        Node_##NAME * x = sm->header;                                                                               \
+        for(int i = sm->max_level - 1; i >= 0; i--){                                                                \
+            while(x->forward[i] && CMP_FUNC(x->forward[i]->key, key) < 0) x = x->forward[i];                        \
+        }                                                                                                           \
+        return x;                                                                                                   \
+    }                                                                                                               \
+                                                                                                                    \
+    static inline Node_##NAME * navigate_##NAME(SkipMap_##NAME * sm, KEY_TYPE key, bool upward, bool inclusive){    \
+        Node_##NAME * x = lastBefore_##NAME(sm, key);                                                               \
+        Node_##NAME * next = x->forward[0];                                                                         \
+        bool equal = next && CMP_FUNC(next->key, key) == 0;                                                         \
+        if(equal && inclusive) return next;                                                                         \
+        if(upward) return equal ? next->forward[0] : next;                                                          \
+        return x == sm->header ? NULL : x;                                                                          \
+    }                                                                                                               \
+                                                                                                                    \
+    static inline bool SkipMap_##NAME##_ceiling(SkipMap_##NAME * sm, KEY_TYPE key, struct SM_##NAME##_kv * kv){     \
+        Node_##NAME * x = navigate_##NAME(sm, key, true, true);                                                     \
+        if(!x) return false;                                                                                        \
+        if(kv){                                                                                                     \
+            kv->key = x->key;                                                                                       \
+            kv->value = x->data;                                                                                    \
+        }                                                                                                           \
+        return true;                                                                                                \
+    }                                                                                                               \
+                                                                                                                    \
+    static inline bool SkipMap_##NAME##_floor(SkipMap_##NAME * sm, KEY_TYPE key, struct SM_##NAME##_kv * kv){       \
+        Node_##NAME * x = navigate_##NAME(sm, key, false, true);                                                    \
+        if(!x) return false;                                                                                        \
+        if(kv){                                                                                                     \
+            kv->key = x->key;                                                                                       \
+            kv->value = x->data;                                                                                    \
+        }                                                                                                           \
+        return true;                                                                                                \
+    }                                                                                                               \
+                                                                                                                    \
+    static inline bool SkipMap_##NAME##_higher(SkipMap_##NAME * sm, KEY_TYPE key, struct SM_##NAME##_kv * kv){      \
+        Node_##NAME * x = navigate_##NAME(sm, key, true, false);                                                    \
+        if(!x) return false;                                                                                        \
+        if(kv){                                                                                                     \
+            kv->key = x->key;                                                                                       \
+            kv->value = x->data;                                                                                    \
+        }                                                                                                           \
+        return true;                                                                                                \
+    }                                                                                                               \
+                                                                                                                    \
+    static inline bool SkipMap_##NAME##_lower(SkipMap_##NAME * sm, KEY_TYPE key, struct SM_##NAME##_kv * kv){       \
+        Node_##NAME * x = navigate_##NAME(sm, key, false, false);                                                   \
+        if(!x) return false;                                                                                        \
+        if(kv){                                                                                                     \
+            kv->key = x->key;                                                                                       \
+            kv->value = x->data;                                                                                    \
+        }                                                                                                           \
+        return true;                                                                                                \
+    }                                                                                                               \
+                                                                                                                    \
     static inline void SkipMap_##NAME##_destroy(SkipMap_##NAME ** sm){                                              \
         if(!sm || !(*sm)) return;                                                                                   \
+        bool bulk = skipListAllocator_hasBulkFree(&(*sm)->allocator);                                                \
         Node_##NAME * x = (*sm)->header->forward[0];                                                                \
         while(x){                                                                                                   \
             Node_##NAME * next = x->forward[0];                                                                     \
             ON_DESTROY_FUNC(x->data);                                                                               \
             ON_REMOVE_FUNC_KEY(x->key);                                                                             \
-            free(x);                                                                                                \
+            if(!bulk) skipListAllocator_free(&(*sm)->allocator, x, nodeSize_##NAME(x->height));                      \
             x = next;                                                                                               \
         }                                                                                                           \
-        free((*sm)->header);                                                                                        \
-        free(*sm);                                                                                                  \
+        SkipListAllocator allocator = (*sm)->allocator;                                                              \
+        if(!bulk) skipListAllocator_free(&allocator, (*sm)->header, nodeSize_##NAME((*sm)->header->height));         \
+        skipListAllocator_free(&allocator, *sm, sizeof(**sm));                                                       \
+        skipListAllocator_freeAll(&allocator);                                                                       \
         *sm = NULL;                                                                                                 \
     }                                                                                                               \
                                                                                                                     \
-    static inline SkipMap_##NAME * SkipMap_##NAME##_create(KEY_TYPE sentinel_k, DATA_TYPE sentinel_v){                                    \
-        SkipMap_##NAME * sm = (SkipMap_##NAME*)malloc(sizeof(SkipMap_##NAME));                                     \
-        assert(sm);                                                                                                 \
-        sm->size = 0;                                                                                               \
-        sm->max_level = 1;                                                                                          \
-        sm->header = getNode_##NAME(SL_MAX_HEIGHT,sentinel_k, sentinel_v);                                         \
+    /* recomputes every tower height in one level 0 pass, the n-th node is promoted once per time                    \
+       round(1/p) divides n so the levels match the current size. Towers already at that height                      \
+       stay in place, returns how many changed */                                                                    \
+    static inline uint32_t SkipMap_##NAME##_rebalance(SkipMap_##NAME * sm){                                          \
+        Node_##NAME * update[SL_MAX_HEIGHT];                                                                         \
+        for(uint32_t i = 0; i < sm->max_height; i++) update[i] = sm->header;                                         \
+        uint32_t fanout = (uint32_t)(1.0 / sm->p_lo + 0.5);                                                          \
+        if(fanout < 2) fanout = 2;                                                                                   \
+        uint32_t count = 0, changed = 0;                                                                             \
+        Node_##NAME * x;                                                                                             \
+        while((x = update[0]->forward[0])){                                                                          \
+            uint32_t height = 1;                                                                                     \
+            for(uint32_t n = ++count; n % fanout == 0 && height < sm->max_height; n /= fanout) height++;             \
+            if(height != x->height){                                                                                 \
+                Node_##NAME * y = getNode_##NAME(sm, height, x->key, x->data);                                       \
+                uint32_t top = height > x->height ? height : x->height;                                              \
+                for(uint32_t i = 0; i < top; i++){                                                                   \
+                    if(i >= height){                                                                                 \
+                        update[i]->forward[i] = x->forward[i];                                                       \
+                        continue;                                                                                    \
+                    }                                                                                                \
+                    y->forward[i] = i < x->height ? x->forward[i] : update[i]->forward[i];                           \
+                    update[i]->forward[i] = y;                                                                       \
+                }                                                                                                    \
+                skipListAllocator_free(&sm->allocator, x, nodeSize_##NAME(x->height));                               \
+                x = y;                                                                                               \
+                changed++;                                                                                           \
+            }                                                                                                        \
+            for(uint32_t i = 0; i < height; i++) update[i] = x;                                                      \
+        }                                                                                                            \
+        sm->max_level = 1;                                                                                           \
+        while(sm->max_level < sm->max_height && sm->header->forward[sm->max_level]) sm->max_level++;                 \
+        return changed;                                                                                              \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline SkipMap_##NAME * createShaped_##NAME(KEY_TYPE sentinel_k, DATA_TYPE sentinel_v,                    \
+                                                       const SkipListAllocator * allocator,                          \
+                                                       uint32_t max_height, double p_lo, double p_hi){               \
+        static const SkipListAllocator default_allocator = {0};                                                      \
+        if(!allocator) allocator = &default_allocator;                                                               \
+        SkipMap_##NAME * sm = (SkipMap_##NAME*)skipListAllocator_alloc(allocator, sizeof(SkipMap_##NAME));           \
+        assert(sm);                                                                                                  \
+        sm->size = 0;                                                                                                \
+        sm->max_level = 1;                                                                                           \
+        sm->allocator = *allocator;                                                                                  \
+        sm->max_height = max_height;                                                                                 \
+        sm->p_lo = p_lo;                                                                                             \
+        sm->p_hi = p_hi;                                                                                             \
+        sm->header = getNode_##NAME(sm, max_height, sentinel_k, sentinel_v);                                         \
         return sm;                                                                                                   \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline SkipMap_##NAME * SkipMap_##NAME##_create_with_allocator(KEY_TYPE sentinel_k, DATA_TYPE sentinel_v, \
+                                                                          const SkipListAllocator * allocator){      \
+        return createShaped_##NAME(sentinel_k, sentinel_v, allocator, SL_MAX_HEIGHT, P, P_Upper);                    \
+    }                                                                                                                \
+                                                                                                                     \
+    /* flags, seed and rebalance_step are not used, generic lists draw heights from rand() and a NULL                \
+       allocator keeps ALLOCATOR */                                                                                  \
+    static inline SkipMap_##NAME * SkipMap_##NAME##_create_with_options(KEY_TYPE sentinel_k, DATA_TYPE sentinel_v,   \
+                                                                        const SkipListOptions * options){            \
+        static const SkipListOptions defaults = {0};                                                                 \
+        if(!options) options = &defaults;                                                                            \
+        uint32_t max_height = options->max_height ? options->max_height : SL_MAX_HEIGHT;                             \
+        double p = options->p ? options->p : P;                                                                      \
+        assert(max_height <= SL_MAX_HEIGHT && p > 0 && p < 1);                                                       \
+        assert(options->growth == SKIPLIST_GROWTH_ADAPTIVE || options->growth == SKIPLIST_GROWTH_FIXED);             \
+        double p_hi = (options->growth == SKIPLIST_GROWTH_FIXED || p > P_Upper) ? p : P_Upper;                       \
+        const SkipListAllocator * allocator = options->allocator ? options->allocator : (ALLOCATOR);                 \
+        return createShaped_##NAME(sentinel_k, sentinel_v, allocator, max_height, p, p_hi);                          \
+    }                                                                                                                \
+                                                                                                                     \
+    static inline SkipMap_##NAME * SkipMap_##NAME##_create(KEY_TYPE sentinel_k, DATA_TYPE sentinel_v){               \
+        return SkipMap_##NAME##_create_with_allocator(sentinel_k, sentinel_v, ALLOCATOR);                            \
     }                                                                                                                \
     //end
\ No newline at end of file
@@ -0,0 +1,193 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <skiplist_allocator.h>
+
+/*
+    Height-class slab arena shared by the typed skiplists (internal header)
+
+    every tower height owns a pool of fixed size objects carved out of slabs,
+    released nodes are threaded onto the pool freelist so alloc/free become a
+    freelist pop or a pointer bump. Destroying the arena releases whole slabs,
+    O(#slabs) instead of O(#nodes). Slabs come from the owning list allocator
+*/
+
+#ifndef SL_ARENA_MIN_SLAB
+#define SL_ARENA_MIN_SLAB 4096
+#endif
+
+#ifndef SL_ARENA_MAX_SLAB
+#define SL_ARENA_MAX_SLAB (1u << 20)
+#endif
+
+// slab header {next slab, slab bytes} is padded so the objects that follow stay 16 byte aligned
+#define SL_ARENA_SLAB_HEADER 16
+
+typedef struct SlabPool_t {
+    void * free_list;
+    char * bump;
+    char * end;
+    size_t slab_size;
+}SlabPool;
+
+// a reference one arena keeps on another, see slabArena_hold
+typedef struct SlabArenaHold_t {
+    struct SlabArena_t * arena;
+    struct SlabArenaHold_t * next;
+}SlabArenaHold;
+
+typedef struct SlabArena_t {
+    SkipListAllocator allocator;
+    void * slabs; // singly linked through the first word of every slab
+    size_t reserved;
+    SlabArenaHold * held; // arenas whose objects moved into this one, released with it
+    uint32_t refs; // lists sharing the arena after a split, the last one destroys it
+    uint32_t pool_count;
+    SlabPool pools[];
+}SlabArena;
+
+static inline size_t slabArena_round(size_t size){
+    return (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+}
+
+static inline SlabArena * slabArena_create(uint32_t pool_count, const SkipListAllocator * allocator){
+    size_t bytes = sizeof(SlabArena) + pool_count * sizeof(SlabPool);
+    SlabArena * arena = (SlabArena *)skipListAllocator_alloc(allocator, bytes);
+    assert(arena);
+    memset(arena, 0, bytes);
+    arena->allocator = *allocator;
+    arena->refs = 1;
+    arena->pool_count = pool_count;
+    for(uint32_t i = 0; i < pool_count; i++){
+        arena->pools[i].slab_size = SL_ARENA_MIN_SLAB;
+    }
+    return arena;
+}
+
+// grab a fresh slab for the pool, slabs double in size up to SL_ARENA_MAX_SLAB
+static inline void slabArena_refill(SlabArena * arena, SlabPool * pool, size_t obj_size){
+    size_t bytes = pool->slab_size;
+    while(bytes < SL_ARENA_SLAB_HEADER + obj_size){
+        bytes <<= 1;
+    }
+    char * slab = (char *)skipListAllocator_alloc(&arena->allocator, bytes);
+    assert(slab);
+    ((void **)slab)[0] = arena->slabs;
+    ((size_t *)slab)[1] = bytes;
+    arena->slabs = slab;
+    arena->reserved += bytes;
+    pool->bump = slab + SL_ARENA_SLAB_HEADER;
+    pool->end = slab + bytes;
+    if(pool->slab_size < SL_ARENA_MAX_SLAB){
+        pool->slab_size <<= 1;
+    }
+}
+
+// height is 1 based, obj_size has to be the same for every call with the same height
+static inline void * slabArena_alloc(SlabArena * arena, uint32_t height, size_t obj_size){
+    assert(height >= 1 && height <= arena->pool_count);
+    SlabPool * pool = &arena->pools[height - 1];
+    if(pool->free_list){
+        void * obj = pool->free_list;
+        pool->free_list = *(void **)obj;
+        return obj;
+    }
+    obj_size = slabArena_round(obj_size);
+    if((size_t)(pool->end - pool->bump) < obj_size){
+        slabArena_refill(arena, pool, obj_size);
+    }
+    void * obj = pool->bump;
+    pool->bump += obj_size;
+    return obj;
+}
+
+static inline void slabArena_free(SlabArena * arena, uint32_t height, void * obj){
+    assert(height >= 1 && height <= arena->pool_count);
+    SlabPool * pool = &arena->pools[height - 1];
+    *(void **)obj = pool->free_list;
+    pool->free_list = obj;
+}
+
+static inline SlabArena * slabArena_retain(SlabArena * arena){
+    arena->refs++;
+    return arena;
+}
+
+// moves every slab of src onto dst and frees the src shell, objects still in
+// use keep their memory while the src free lists and bump space are dropped
+// until dst is destroyed. src must not be shared, the pool counts may differ
+// as long as every object still in use fits a pool of dst
+static inline void slabArena_adopt(SlabArena * dst, SlabArena * src){
+    assert(src->refs == 1);
+    void * slab = src->slabs;
+    if(slab){
+        while(((void **)slab)[0]){
+            slab = ((void **)slab)[0];
+        }
+        ((void **)slab)[0] = dst->slabs;
+        dst->slabs = src->slabs;
+    }
+    dst->reserved += src->reserved;
+    if(src->held){
+        SlabArenaHold * hold = src->held;
+        while(hold->next){
+            hold = hold->next;
+        }
+        hold->next = dst->held;
+        dst->held = src->held;
+    }
+    skipListAllocator_free(&src->allocator, src, sizeof(SlabArena) + src->pool_count * sizeof(SlabPool));
+}
+
+// takes over the caller's reference on src, which is still shared elsewhere
+// so its slabs cannot be adopted, and keeps it until dst is destroyed. Objects
+// of src may then be handed to the free lists of dst. Two arenas holding each
+// other are never released
+static inline void slabArena_hold(SlabArena * dst, SlabArena * src){
+    SlabArenaHold * hold = (SlabArenaHold *)skipListAllocator_alloc(&dst->allocator, sizeof(SlabArenaHold));
+    assert(hold);
+    hold->arena = src;
+    hold->next = dst->held;
+    dst->held = hold;
+}
+
+// drops one reference, the slabs and the held arenas are released with the last one
+static inline void slabArena_destroy(SlabArena * arena){
+    if(!arena) return;
+    if(--arena->refs > 0) return;
+    SkipListAllocator allocator = arena->allocator;
+    void * slab = arena->slabs;
+    while(slab){
+        void * next = ((void **)slab)[0];
+        skipListAllocator_free(&allocator, slab, ((size_t *)slab)[1]);
+        slab = next;
+    }
+    SlabArenaHold * hold = arena->held;
+    while(hold){
+        SlabArenaHold * next = hold->next;
+        slabArena_destroy(hold->arena);
+        skipListAllocator_free(&allocator, hold, sizeof(SlabArenaHold));
+        hold = next;
+    }
+    skipListAllocator_free(&allocator, arena, sizeof(SlabArena) + arena->pool_count * sizeof(SlabPool));
+}
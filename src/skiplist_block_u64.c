@@ -0,0 +1,393 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#include <skiplist_block_u64.h>
+#include "skiplist_random.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+#include <stdio.h>
+#include <math.h>
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+
+/*
+    block (unrolled) uint64 skiplist
+
+    bottom level nodes hold a sorted block of up to SL_BLOCK_KEYS_u64 keys and
+    the towers are keyed by the smallest key of every block, so a descent
+    stops at the only block that can hold the key and finishes with one
+    vectorised scan instead of one pointer hop per key.
+    full blocks split in half, a block that drops under a quarter full
+    absorbs its successor when the two fit in three quarters of a block
+*/
+
+#ifndef P
+    #define P 0.33
+#endif
+#ifndef P_Upper
+    #define P_Upper 0.70
+#endif
+
+// 16 keys = 128 bytes, two cache lines. Has to stay a multiple of 4 for the AVX2 scan
+#ifndef SL_BLOCK_KEYS_u64
+    #define SL_BLOCK_KEYS_u64 16
+#endif
+_Static_assert(SL_BLOCK_KEYS_u64 % 4 == 0 && SL_BLOCK_KEYS_u64 >= 4, "block size must be a multiple of 4");
+
+// unused slots hold UINT64_MAX so the scan can always cover the whole block
+typedef struct Block_u64_t {
+    uint64_t keys[SL_BLOCK_KEYS_u64];
+    uint32_t count;
+    uint8_t height;
+    struct Block_u64_t * forward[];
+}Block_u64;
+
+_Static_assert(SL_MAX_HEIGHT <= UINT8_MAX, "block height is stored in a byte");
+
+struct SkipListBlock_u64_t {
+    uint32_t size;      // keys stored
+    uint32_t blocks;    // bottom level nodes, tower heights are drawn from this
+    uint32_t max_level;
+    Block_u64 * header;
+    SkipListAllocator allocator;
+    SkipListRandom rng; // tower heights, see skiplist_random.h
+};
+
+
+/*_______________________________________
+
+    utility functions
+_________________________________________*/
+
+static inline size_t blockSize_u64(uint32_t level) {
+    return sizeof(Block_u64) + level * sizeof(Block_u64 *);
+}
+
+// number of keys in the block smaller than key, i.e. the slot key belongs in
+static inline uint32_t blockLowerBound_u64(const Block_u64 * b, uint64_t key) {
+#if defined(__AVX2__)
+    // no unsigned 64 bit compare, flip the sign bit and compare signed
+    const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256i k = _mm256_xor_si256(_mm256_set1_epi64x((long long)key), bias);
+    uint32_t n = 0;
+    for (uint32_t j = 0; j < SL_BLOCK_KEYS_u64; j += 4) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(b->keys + j)), bias);
+        __m256i lt = _mm256_cmpgt_epi64(k, v);
+        n += (uint32_t)__builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(lt)));
+    }
+    return n;
+#elif defined(__SSE4_2__)
+    const __m128i bias = _mm_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m128i k = _mm_xor_si128(_mm_set1_epi64x((long long)key), bias);
+    uint32_t n = 0;
+    for (uint32_t j = 0; j < SL_BLOCK_KEYS_u64; j += 2) {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(b->keys + j)), bias);
+        __m128i lt = _mm_cmpgt_epi64(k, v);
+        n += (uint32_t)__builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(lt)));
+    }
+    return n;
+#else
+    // SSE2 has no 64 bit compare, a branch free count still vectorises well
+    uint32_t n = 0;
+    for (uint32_t j = 0; j < SL_BLOCK_KEYS_u64; j++) {
+        n += b->keys[j] < key;
+    }
+    return n;
+#endif
+}
+
+static inline Block_u64 * getBlock_u64(struct SkipListBlock_u64_t * list, uint32_t level) {
+    Block_u64 * b = (Block_u64 *)skipListAllocator_alloc(&list->allocator, blockSize_u64(level));
+    assert(b);
+    for (uint32_t j = 0; j < SL_BLOCK_KEYS_u64; j++) {
+        b->keys[j] = UINT64_MAX;
+    }
+    b->count = 0;
+    b->height = (uint8_t)level;
+    for (uint32_t i = 0; i < level; i++) {
+        b->forward[i] = NULL;
+    }
+    return b;
+}
+
+static inline void releaseBlock_u64(struct SkipListBlock_u64_t * list, Block_u64 * b) {
+    skipListAllocator_free(&list->allocator, b, blockSize_u64(b->height));
+}
+
+static inline void blockInsertAt_u64(Block_u64 * b, uint32_t pos, uint64_t key) {
+    memmove(b->keys + pos + 1, b->keys + pos, (b->count - pos) * sizeof(uint64_t));
+    b->keys[pos] = key;
+    b->count++;
+}
+
+static inline void blockRemoveAt_u64(Block_u64 * b, uint32_t pos) {
+    memmove(b->keys + pos, b->keys + pos + 1, (b->count - pos - 1) * sizeof(uint64_t));
+    b->count--;
+    b->keys[b->count] = UINT64_MAX;
+}
+
+// last block whose smallest key is <= key, the header when there is none
+static inline Block_u64 * findBlock_u64(struct SkipListBlock_u64_t * list, uint64_t key, Block_u64 ** update) {
+    Block_u64 * x = list->header;
+    for (int i = list->max_level - 1; i >= 0; i--) {
+        while (x->forward[i] && x->forward[i]->keys[0] <= key) {
+            x = x->forward[i];
+        }
+        if (update) update[i] = x;
+    }
+    return x;
+}
+
+// links a fresh empty block after update[i] on every level of its tower
+static Block_u64 * linkNewBlock_u64(struct SkipListBlock_u64_t * list, Block_u64 ** update) {
+    uint32_t height = skipListRandom_level(&list->rng, list->blocks, list->max_level, SL_MAX_HEIGHT, P, P_Upper);
+    if (height > list->max_level) {
+        for (uint32_t i = list->max_level; i < height; i++) {
+            update[i] = list->header;
+        }
+        list->max_level = height;
+    }
+    Block_u64 * b = getBlock_u64(list, height);
+    for (uint32_t i = 0; i < height; i++) {
+        b->forward[i] = update[i]->forward[i];
+        update[i]->forward[i] = b;
+    }
+    list->blocks++;
+    return b;
+}
+
+// min is the smallest key the block held while it was linked
+static void unlinkBlock_u64(struct SkipListBlock_u64_t * list, Block_u64 * b, uint64_t min) {
+    Block_u64 * update[SL_MAX_HEIGHT];
+    Block_u64 * x = list->header;
+    for (int i = list->max_level - 1; i >= 0; i--) {
+        while (x->forward[i] && x->forward[i]->keys[0] < min) {
+            x = x->forward[i];
+        }
+        update[i] = x;
+    }
+    assert(update[0]->forward[0] == b);
+    for (uint32_t i = 0; i < b->height; i++) {
+        update[i]->forward[i] = b->forward[i];
+    }
+    //coalesce height
+    while (list->max_level > 1 && !(list->header->forward[list->max_level - 1])) {
+        list->max_level -= 1;
+    }
+    list->blocks--;
+}
+
+
+/*_______________________________________
+
+    block uint64 core functions
+_________________________________________*/
+
+static bool skipListBlock_u64_insert_core(struct SkipListBlock_u64_t * list, uint64_t key) {
+    Block_u64 * update[SL_MAX_HEIGHT];
+    Block_u64 * b = findBlock_u64(list, key, update);
+    if (b == list->header) {
+        // smaller than every stored key, it becomes the new minimum of the first block
+        b = list->header->forward[0];
+        if (!b) {
+            b = linkNewBlock_u64(list, update);
+        }
+    }
+    uint32_t pos = blockLowerBound_u64(b, key);
+    if (pos < b->count && b->keys[pos] == key) {
+        return false;
+    }
+    if (b->count == SL_BLOCK_KEYS_u64) {
+        // split, the upper half moves into a new block linked right after b
+        for (uint32_t i = 0; i < b->height; i++) {
+            update[i] = b;
+        }
+        Block_u64 * upper = linkNewBlock_u64(list, update);
+        uint32_t half = SL_BLOCK_KEYS_u64 / 2;
+        memcpy(upper->keys, b->keys + half, (SL_BLOCK_KEYS_u64 - half) * sizeof(uint64_t));
+        upper->count = SL_BLOCK_KEYS_u64 - half;
+        for (uint32_t j = half; j < SL_BLOCK_KEYS_u64; j++) {
+            b->keys[j] = UINT64_MAX;
+        }
+        b->count = half;
+        if (pos > half) {
+            b = upper;
+            pos -= half;
+        }
+    }
+    blockInsertAt_u64(b, pos, key);
+    list->size++;
+    return true;
+}
+
+static bool skipListBlock_u64_search_core(struct SkipListBlock_u64_t * list, uint64_t key) {
+    Block_u64 * b = findBlock_u64(list, key, NULL);
+    if (b == list->header) {
+        return false;
+    }
+    uint32_t pos = blockLowerBound_u64(b, key);
+    return pos < b->count && b->keys[pos] == key;
+}
+
+static void skipListBlock_u64_remove_core(struct SkipListBlock_u64_t * list, uint64_t key) {
+    Block_u64 * b = findBlock_u64(list, key, NULL);
+    if (b == list->header) {
+        return;
+    }
+    uint32_t pos = blockLowerBound_u64(b, key);
+    if (pos >= b->count || b->keys[pos] != key) {
+        return;
+    }
+    blockRemoveAt_u64(b, pos);
+    list->size--;
+    if (b->count == 0) {
+        // only happens when key was the block minimum
+        unlinkBlock_u64(list, b, key);
+        releaseBlock_u64(list, b);
+        return;
+    }
+    Block_u64 * next = b->forward[0];
+    if (b->count < SL_BLOCK_KEYS_u64 / 4 && next && b->count + next->count <= SL_BLOCK_KEYS_u64 * 3 / 4) {
+        // merge, b absorbs its successor
+        uint64_t next_min = next->keys[0];
+        memcpy(b->keys + b->count, next->keys, next->count * sizeof(uint64_t));
+        b->count += next->count;
+        unlinkBlock_u64(list, next, next_min);
+        releaseBlock_u64(list, next);
+    }
+}
+
+
+/*_______________________________________
+
+    block uint64 SkipList impl
+_________________________________________*/
+
+SkipListBlock_u64 *skipListBlock_u64_create_with_allocator(const SkipListAllocator *allocator)
+{
+    static const SkipListAllocator default_allocator = {0};
+    if (!allocator) allocator = &default_allocator;
+    SkipListBlock_u64 * list = (SkipListBlock_u64 *)skipListAllocator_alloc(allocator, sizeof(SkipListBlock_u64));
+    assert(list);
+    list->size = 0;
+    list->blocks = 0;
+    list->max_level = 1;
+    skipListRandom_seed(&list->rng, 0);
+    list->allocator = *allocator;
+    list->header = getBlock_u64(list, SL_MAX_HEIGHT);
+    return list;
+}
+
+SkipListBlock_u64 *skipListBlock_u64_create(void)
+{
+    return skipListBlock_u64_create_with_allocator(NULL);
+}
+
+bool skipListBlock_u64_insert(SkipListBlock_u64 *list, uint64_t id)
+{
+    return skipListBlock_u64_insert_core(list, id);
+}
+
+void skipListBlock_u64_remove(SkipListBlock_u64 *list, uint64_t id)
+{
+    skipListBlock_u64_remove_core(list, id);
+}
+
+bool skipListBlock_u64_search(SkipListBlock_u64 *list, uint64_t search_id)
+{
+    return skipListBlock_u64_search_core(list, search_id);
+}
+
+uint32_t skipListBlock_u64_getSize(const SkipListBlock_u64 *list)
+{
+    return list ? list->size : 0;
+}
+
+bool skipListBlock_u64_isEmpty(const SkipListBlock_u64 *list)
+{
+    return list ? list->size == 0 : true;
+}
+
+bool skipListBlock_u64_pop(SkipListBlock_u64 *list, uint64_t *removed_id)
+{
+    if (skipListBlock_u64_isEmpty(list) || !removed_id) {
+        return false;
+    }
+    Block_u64 * b = list->header->forward[0];
+    *removed_id = b->keys[0];
+    blockRemoveAt_u64(b, 0);
+    list->size--;
+    if (b->count == 0) {
+        // first block, the header is its predecessor on every level
+        for (uint32_t i = 0; i < b->height; i++) {
+            list->header->forward[i] = b->forward[i];
+        }
+        while (list->max_level > 1 && !(list->header->forward[list->max_level - 1])) {
+            list->max_level -= 1;
+        }
+        list->blocks--;
+        releaseBlock_u64(list, b);
+    }
+    return true;
+}
+
+void skipListBlock_u64_destroy(SkipListBlock_u64 **list)
+{
+    if (!list || !*list) return;
+    SkipListBlock_u64 * sl = *list;
+    bool bulk = skipListAllocator_hasBulkFree(&sl->allocator);
+    if (!bulk) {
+        Block_u64 * b = sl->header->forward[0];
+        while (b) {
+            Block_u64 * next = b->forward[0];
+            releaseBlock_u64(sl, b);
+            b = next;
+        }
+        releaseBlock_u64(sl, sl->header);
+    }
+    SkipListAllocator allocator = sl->allocator;
+    skipListAllocator_free(&allocator, sl, sizeof(SkipListBlock_u64));
+    skipListAllocator_freeAll(&allocator);
+    *list = NULL; //prevent use after free
+}
+
+void skipListBlock_u64_print(SkipListBlock_u64 *list)
+{
+    for (int i = list->max_level - 1; i > 0; i--) {
+        printf("level %d: -->\t", i);
+        Block_u64 * b = list->header->forward[i];
+        while (b) {
+            printf("%lu-->", b->keys[0]);
+            b = b->forward[i];
+        }
+        printf("nil\n");
+    }
+    printf("level 0: -->\t");
+    Block_u64 * b = list->header->forward[0];
+    while (b) {
+        printf("[");
+        for (uint32_t j = 0; j < b->count; j++) {
+            printf(j ? " %lu" : "%lu", b->keys[j]);
+        }
+        printf("]-->");
+        b = b->forward[0];
+    }
+    printf("nil\n");
+}
@@ -0,0 +1,298 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#include <skiplist_compact_u32.h>
+#include "skiplist_random.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+#include <stdio.h>
+#include <math.h>
+
+
+/*
+    compact uint32 skiplist
+
+    every node lives in one growable array of 32 bit words and links are word
+    indices into that array, so a tower costs 4 bytes per level instead of 8.
+    node layout (in words): [key][height][next_0] ... [next_height-1]
+    the header owns index 0, nothing ever links back to it so 0 doubles as NULL.
+    The pool may move when it grows, only indices are held across allocations
+*/
+
+#ifndef P
+    #define P 0.33
+#endif
+#ifndef P_Upper
+    #define P_Upper 0.70
+#endif
+
+#define COMPACT_NIL 0u
+#define COMPACT_MIN_WORDS 1024u
+#ifndef COMPACT_MAX_WORDS
+    #define COMPACT_MAX_WORDS UINT32_MAX // indices are 32 bit
+#endif
+#define COMPACT_FULL UINT32_MAX // no room left, never a node index since a node needs 3 words
+
+struct SkipListCompact_u32_t {
+    uint32_t size;
+    uint32_t max_level;
+    uint32_t * pool;
+    uint32_t used;      // words handed out so far
+    uint32_t capacity;  // words allocated
+    uint32_t free_head[SL_MAX_HEIGHT]; // released nodes per height, chained through their key word
+    SkipListRandom rng; // tower heights, see skiplist_random.h
+};
+
+
+/*_______________________________________
+
+    utility functions
+_________________________________________*/
+
+static inline uint32_t clamp_level_compact_u32(uint32_t lvl) {
+    if (lvl == 0) return 1;
+    if (lvl > SL_MAX_HEIGHT) return SL_MAX_HEIGHT;
+    return lvl;
+}
+
+static inline uint32_t compactHeight_u32(const uint32_t * pool, uint32_t x) {
+    return pool[x + 1];
+}
+
+static inline uint32_t * compactForward_u32(uint32_t * pool, uint32_t x) {
+    return pool + x + 2;
+}
+
+// doubles the pool until words fit, the last step stops at COMPACT_MAX_WORDS.
+// False once even that is full or realloc fails, the pool is left as it was
+static bool growPool_compact_u32(struct SkipListCompact_u32_t * list, uint32_t words) {
+    uint64_t capacity = list->capacity ? list->capacity : COMPACT_MIN_WORDS;
+    while (capacity - list->used < words && capacity < COMPACT_MAX_WORDS) {
+        capacity = capacity << 1 > COMPACT_MAX_WORDS ? COMPACT_MAX_WORDS : capacity << 1;
+    }
+    if (capacity - list->used < words) {
+        return false;
+    }
+    uint32_t * pool = (uint32_t *)realloc(list->pool, capacity * sizeof(uint32_t));
+    if (!pool) {
+        return false;
+    }
+    list->pool = pool;
+    list->capacity = (uint32_t)capacity;
+    return true;
+}
+
+static uint32_t getNode_compact_u32(struct SkipListCompact_u32_t * list, uint32_t level, uint32_t key) {
+    level = clamp_level_compact_u32(level);
+    uint32_t x = list->free_head[level - 1];
+    if (x != COMPACT_NIL) {
+        list->free_head[level - 1] = list->pool[x];
+    } else {
+        uint32_t words = 2 + level;
+        if (list->capacity - list->used < words && !growPool_compact_u32(list, words)) {
+            return COMPACT_FULL;
+        }
+        x = list->used;
+        list->used += words;
+    }
+    list->pool[x] = key;
+    list->pool[x + 1] = level;
+    memset(compactForward_u32(list->pool, x), 0, level * sizeof(uint32_t));
+    return x;
+}
+
+static inline void releaseNode_compact_u32(struct SkipListCompact_u32_t * list, uint32_t x) {
+    uint32_t level = compactHeight_u32(list->pool, x);
+    list->pool[x] = list->free_head[level - 1];
+    list->free_head[level - 1] = x;
+}
+
+
+/*_______________________________________
+
+    compact uint32 core functions
+_________________________________________*/
+
+static bool skipListCompact_u32_insert_core(struct SkipListCompact_u32_t * list, uint32_t key) {
+    uint32_t update[SL_MAX_HEIGHT];
+    uint32_t * pool = list->pool;
+    uint32_t x = 0;
+    for (int i = list->max_level - 1; i >= 0; i--) {
+        uint32_t next = compactForward_u32(pool, x)[i];
+        while (next != COMPACT_NIL && pool[next] < key) {
+            x = next;
+            next = compactForward_u32(pool, x)[i];
+        }
+        update[i] = x;
+    }
+    uint32_t next = compactForward_u32(pool, x)[0];
+    if (next != COMPACT_NIL && pool[next] == key) {
+        return false;
+    }
+    uint32_t height = skipListRandom_level(&list->rng, list->size, list->max_level, SL_MAX_HEIGHT, P, P_Upper);
+    // may move the pool, re-read it afterwards
+    uint32_t insertionNode = getNode_compact_u32(list, height, key);
+    if (insertionNode == COMPACT_FULL) {
+        return false;
+    }
+    pool = list->pool;
+    if (height > list->max_level) {
+        for (uint32_t i = list->max_level; i < height; i++) {
+            update[i] = 0;
+        }
+        list->max_level = height;
+    }
+    for (uint32_t i = 0; i < height; i++) {
+        compactForward_u32(pool, insertionNode)[i] = compactForward_u32(pool, update[i])[i];
+        compactForward_u32(pool, update[i])[i] = insertionNode;
+    }
+    list->size++;
+    return true;
+}
+
+static bool skipListCompact_u32_search_core(struct SkipListCompact_u32_t * list, uint32_t key) {
+    uint32_t * pool = list->pool;
+    uint32_t x = 0;
+    for (int i = list->max_level - 1; i >= 0; i--) {
+        uint32_t next = compactForward_u32(pool, x)[i];
+        while (next != COMPACT_NIL && pool[next] < key) {
+            x = next;
+            next = compactForward_u32(pool, x)[i];
+        }
+        if (next != COMPACT_NIL && pool[next] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void skipListCompact_u32_remove_core(struct SkipListCompact_u32_t * list, uint32_t key) {
+    uint32_t update[SL_MAX_HEIGHT];
+    uint32_t * pool = list->pool;
+    uint32_t x = 0;
+    for (int i = list->max_level - 1; i >= 0; i--) {
+        uint32_t next = compactForward_u32(pool, x)[i];
+        while (next != COMPACT_NIL && pool[next] < key) {
+            x = next;
+            next = compactForward_u32(pool, x)[i];
+        }
+        update[i] = x;
+    }
+    // check for existence
+    x = compactForward_u32(pool, x)[0];
+    if (x == COMPACT_NIL || pool[x] != key) {
+        return;
+    }
+    uint32_t height = compactHeight_u32(pool, x);
+    for (uint32_t i = 0; i < height; i++) {
+        compactForward_u32(pool, update[i])[i] = compactForward_u32(pool, x)[i];
+    }
+    releaseNode_compact_u32(list, x);
+    //coalesce height
+    while (list->max_level > 1 && compactForward_u32(pool, 0)[list->max_level - 1] == COMPACT_NIL) {
+        list->max_level -= 1;
+    }
+    list->size--;
+}
+
+
+/*_______________________________________
+
+    compact uint32 SkipList impl
+_________________________________________*/
+
+SkipListCompact_u32 *skipListCompact_u32_create(void)
+{
+    SkipListCompact_u32 * list = (SkipListCompact_u32 *)calloc(1, sizeof(SkipListCompact_u32));
+    assert(list);
+    list->max_level = 1;
+    skipListRandom_seed(&list->rng, 0);
+    // header takes index 0 so every real node index is non zero
+    uint32_t header = getNode_compact_u32(list, SL_MAX_HEIGHT, 0);
+    assert(header == 0);
+    (void)header;
+    return list;
+}
+
+bool skipListCompact_u32_insert(SkipListCompact_u32 *list, uint32_t id)
+{
+    return skipListCompact_u32_insert_core(list, id);
+}
+
+void skipListCompact_u32_remove(SkipListCompact_u32 *list, uint32_t id)
+{
+    skipListCompact_u32_remove_core(list, id);
+}
+
+bool skipListCompact_u32_search(SkipListCompact_u32 *list, uint32_t search_id)
+{
+    return skipListCompact_u32_search_core(list, search_id);
+}
+
+uint32_t skipListCompact_u32_getSize(const SkipListCompact_u32 *list)
+{
+    return list ? list->size : 0;
+}
+
+bool skipListCompact_u32_isEmpty(const SkipListCompact_u32 *list)
+{
+    return list ? list->size == 0 : true;
+}
+
+bool skipListCompact_u32_pop(SkipListCompact_u32 *list, uint32_t *removed_id)
+{
+    if (skipListCompact_u32_isEmpty(list) || !removed_id) {
+        return false;
+    }
+    uint32_t * pool = list->pool;
+    uint32_t x = compactForward_u32(pool, 0)[0];
+    *removed_id = pool[x];
+    uint32_t height = compactHeight_u32(pool, x);
+    for (uint32_t i = 0; i < height; i++) {
+        compactForward_u32(pool, 0)[i] = compactForward_u32(pool, x)[i];
+    }
+    releaseNode_compact_u32(list, x);
+    while (list->max_level > 1 && compactForward_u32(pool, 0)[list->max_level - 1] == COMPACT_NIL) {
+        list->max_level -= 1;
+    }
+    list->size--;
+    return true;
+}
+
+void skipListCompact_u32_destroy(SkipListCompact_u32 **list)
+{
+    if (!list || !*list) return;
+    // every node lives in the pool, one free releases them all
+    free((*list)->pool);
+    free(*list);
+    *list = NULL; //prevent use after free
+}
+
+void skipListCompact_u32_print(SkipListCompact_u32 *list)
+{
+    uint32_t * pool = list->pool;
+    for (int i = list->max_level - 1; i >= 0; i--) {
+        printf("level %d: -->\t", i);
+        uint32_t x = compactForward_u32(pool, 0)[i];
+        while (x != COMPACT_NIL) {
+            printf("%u-->", pool[x]);
+            x = compactForward_u32(pool, x)[i];
+        }
+        printf("nil\n");
+    }
+}
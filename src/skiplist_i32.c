@@ -15,7 +15,11 @@
  * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
  */
 #include <skiplist_i32.h>
+#include "skiplist_arena.h"
+#include "skiplist_random.h"
 #include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
 #include <time.h>
 #include <assert.h>
 #include <stdio.h>
@@ -29,39 +33,94 @@
     #define P_Upper 0.70
 #endif
 
-typedef struct Node_i32_t{
+// bulk builds promote every SL_BUILD_FANOUT-th tower of a level, the
+// deterministic counterpart of P
+#ifndef SL_BUILD_FANOUT
+    #define SL_BUILD_FANOUT 3
+#endif
+
+// set operations stop merging level 0 and probe the larger list through a
+// finger once it holds this many times the keys of the smaller one
+#ifndef SL_GALLOP_RATIO
+    #define SL_GALLOP_RATIO 8
+#endif
+
+// set node: 8 bytes + 8 per level (16 with SL_CACHED_KEYS). Maps keep their value in one extra word
+// placed in front of the node (see nodeData_i32) so both share the same cores
+// forward slot, with SL_CACHED_KEYS the successor key is stored next to the link
+// so a descent can decide whether to advance without touching the next node
+#ifdef SL_CACHED_KEYS
+typedef struct Link_i32_t {
     int32_t key;
-    uint32_t height;
-    void* data;
-    struct Node_i32_t * forward[];
+    struct Node_i32_t * next;
+}Link_i32;
+#else
+typedef struct Link_i32_t {
+    struct Node_i32_t * next;
+}Link_i32;
+#endif
+
+typedef struct Node_i32_t {
+    int32_t key;
+    uint8_t height;
+    Link_i32 forward[];
 }Node_i32;
 
+_Static_assert(SL_MAX_HEIGHT <= UINT8_MAX, "node height is stored in a byte");
+
+
+// the node block a list shares with its snapshots. Values are freed once by
+// the last list to let go, and only if the owning map asked for it
+typedef struct SharedNodes_i32_t {
+    atomic_uint refs; // lists reading the nodes
+    atomic_bool free_values; // set when the owner was destroyed with its values
+}SharedNodes_i32;
 
 struct SkipList_i32_t{
     uint32_t max_level;
     uint32_t size;
     Node_i32 * header;
+    SlabArena * arena; // NULL when nodes come straight from the allocator
+    SkipListAllocator allocator;
+    uint32_t node_prefix; // bytes in front of every node, back link first then the map value
+    uint64_t version; // bumped whenever a node is linked or unlinked, fingers resync on a mismatch
+    bool indexable; // nodes carry a span per level after their links
+    bool is_map;
+    bool backlinks; // nodes keep their level 0 predecessor in the prefix
+    SharedNodes_i32 * shared; // set while snapshots share the nodes
+    bool read_only; // snapshots refuse every write
+    bool owns_values; // destroy frees map values, false for clones and snapshots
+    SkipListRandom rng; // tower heights, see skiplist_random.h
+    uint32_t max_height; // height of the header, no tower grows taller
+    double p_lo; // promotion probability bounds, equal for SKIPLIST_GROWTH_FIXED
+    double p_hi;
+    uint32_t rebalance_step; // towers re-leveled per insert or remove, 0 leaves it to rebalance()
+    uint32_t rebalance_size; // size when the last incremental pass ended
+    uint32_t rebalance_pos; // towers the running incremental pass has visited, 0 when none runs
+    int32_t rebalance_key; // last key the running pass visited
+    Node_i32 * last[]; // max_height entries, last node on every level, the header when the level is empty
 };
 
+// lists are allocated with room for last[] below their max_height only
+static inline size_t listBytes_i32(uint32_t max_height) {
+    return sizeof(struct SkipList_i32_t) + max_height * sizeof(Node_i32 *);
+}
+
+// gives a list whose nodes are shared with snapshots nodes of its own, every
+// write path calls it before touching a node
+static void detach_i32(struct SkipList_i32_t * list);
+
+// advances the incremental re-leveling pass, see rebalance impl
+static void rebalanceStep_i32(struct SkipList_i32_t * list, uint32_t changes);
+
 
 /*_______________________________________
 
     utility functions
 _________________________________________*/
 
-static inline int getDynamicPromotionProb_i32(uint32_t size, uint32_t level){
-    double p = pow((double)(size ? size : 2), -1.0 / level);
-    if (p < P) p = P;
-    if (p > P_Upper) p = P_Upper;
-    return (int)(p*100);
-}
-
-uint32_t getRandomLevel_i32(uint32_t size, uint32_t max_level) {
-    int level = 1;
-    int prob = getDynamicPromotionProb_i32(size,max_level);
-    while (((rand() % 101) <= prob) && level < SL_MAX_HEIGHT)
-        level++;
-    return level;
+static inline uint32_t randomLevel_i32(struct SkipList_i32_t * list) {
+    return skipListRandom_level(&list->rng, list->size, list->max_level, list->max_height, list->p_lo, list->p_hi);
 }
 
 static inline uint32_t clamp_level_i32(uint32_t lvl) {
@@ -70,19 +129,209 @@ static inline uint32_t clamp_level_i32(uint32_t lvl) {
     return lvl;
 }
 
-static inline Node_i32 * getNode_i32(uint32_t level, int32_t key) {
+static inline size_t nodeSize_i32(const struct SkipList_i32_t * list, uint32_t level) {
+    size_t spans = list->indexable ? level * sizeof(uint32_t) : 0;
+    return list->node_prefix + sizeof(Node_i32) + level * sizeof(Link_i32) + spans;
+}
+
+// only valid for indexable lists, span[i] counts the level 0 steps forward[i]
+// skips, for a NULL link the number of nodes after this one
+static inline uint32_t * nodeSpan_i32(Node_i32 * node) {
+    return (uint32_t *)&node->forward[node->height];
+}
+
+// only valid for nodes owned by a map
+static inline void ** nodeData_i32(Node_i32 * node) {
+    return (void **)node - 1;
+}
+
+// true when the successor at this level exists and sorts before key
+static inline bool linkBefore_i32(const Node_i32 * x, uint32_t level, int32_t key) {
+#ifdef SL_CACHED_KEYS
+    return x->forward[level].next && x->forward[level].key < key;
+#else
+    return x->forward[level].next && x->forward[level].next->key < key;
+#endif
+}
+
+static inline bool linkMatches_i32(const Node_i32 * x, uint32_t level, int32_t key) {
+#ifdef SL_CACHED_KEYS
+    return x->forward[level].next && x->forward[level].key == key;
+#else
+    return x->forward[level].next && x->forward[level].next->key == key;
+#endif
+}
+
+static inline void setLink_i32(Node_i32 * x, uint32_t level, Node_i32 * next) {
+    x->forward[level].next = next;
+#ifdef SL_CACHED_KEYS
+    if(next) x->forward[level].key = next->key;
+#endif
+}
+
+// only valid with backlinks, the first word in front of the node
+static inline Node_i32 ** nodeBack_i32(const struct SkipList_i32_t * list, Node_i32 * node) {
+    return (Node_i32 **)((char *)node - list->node_prefix);
+}
+
+// bookkeeping once x is linked behind pred on level 0: x becomes the last node
+// of every level it ends, and with backlinks the header counts as the
+// predecessor of the first node
+static inline void afterLink_i32(struct SkipList_i32_t * list, Node_i32 * pred, Node_i32 * x) {
+    for(uint32_t i = 0; i < x->height; i++){
+        if(!x->forward[i].next) list->last[i] = x;
+    }
+    if(!list->backlinks) return;
+    *nodeBack_i32(list, x) = pred;
+    Node_i32 * next = x->forward[0].next;
+    if(next) *nodeBack_i32(list, next) = x;
+}
+
+// unlinks x given its predecessor on every level below max_level, links that
+// pass over x lose one step of span
+static inline void unlinkNode_i32(struct SkipList_i32_t * list, Node_i32 ** update, Node_i32 * x) {
+    if(list->indexable){
+        uint32_t * span = nodeSpan_i32(x);
+        for(uint32_t i = 0; i < x->height; i++){
+            nodeSpan_i32(update[i])[i] += span[i] - 1;
+        }
+        for(uint32_t i = x->height; i < list->max_level; i++){
+            nodeSpan_i32(update[i])[i]--;
+        }
+    }
+    if(list->backlinks && x->forward[0].next){
+        *nodeBack_i32(list, x->forward[0].next) = update[0];
+    }
+    for(uint32_t i = 0; i < x->height; i++){
+        update[i]->forward[i] = x->forward[i];
+        if(list->last[i] == x) list->last[i] = update[i];
+    }
+}
+
+// pops unlink the first node, the header is its predecessor on every level
+static inline void unlinkFirst_i32(struct SkipList_i32_t * list, Node_i32 * x) {
+    Node_i32 * update[SL_MAX_HEIGHT];
+    for(uint32_t i = 0; i < list->max_level; i++){
+        update[i] = list->header;
+    }
+    unlinkNode_i32(list, update, x);
+}
+
+static inline Node_i32 * getNode_i32(struct SkipList_i32_t * list, uint32_t level, int32_t key) {
     level = clamp_level_i32(level);
-    Node_i32 * node = (Node_i32 *)malloc(sizeof(Node_i32) + level * sizeof(Node_i32 *));
-    assert(node);
+    size_t bytes = nodeSize_i32(list, level);
+    char * base = list->arena ? (char *)slabArena_alloc(list->arena, level, bytes)
+                              : (char *)skipListAllocator_alloc(&list->allocator, bytes);
+    assert(base);
+    Node_i32 * node = (Node_i32 *)(base + list->node_prefix);
     node->key = key;
-    node->height = level;
-    node->data = NULL;
+    node->height = (uint8_t)level;
+    if(list->is_map){
+        *nodeData_i32(node) = NULL;
+    }
     for (uint32_t i = 0; i < level; i++){
-        node->forward[i] = NULL;
+        node->forward[i].next = NULL;
     }
     return node;
 }
 
+static inline void releaseNode_i32(struct SkipList_i32_t * list, Node_i32 * node) {
+    char * base = (char *)node - list->node_prefix;
+    if(list->arena){
+        slabArena_free(list->arena, node->height, base);
+        return;
+    }
+    skipListAllocator_free(&list->allocator, base, nodeSize_i32(list, node->height));
+}
+
+// frees every node including the header, arena backed sets and allocators with
+// a bulk free skip the level 0 walk entirely. An arena still shared with a
+// split off list gets its nodes back one by one instead
+static inline void releaseAllNodes_i32(struct SkipList_i32_t * list, bool free_data) {
+    bool shared = list->arena && list->arena->refs > 1;
+    bool bulk = !shared && (list->arena || skipListAllocator_hasBulkFree(&list->allocator));
+    if(free_data || !bulk){
+        Node_i32 * x = list->header->forward[0].next;
+        while(x) {
+            Node_i32 * next = x->forward[0].next;
+            if(free_data) free(*nodeData_i32(x));
+            if(!bulk) releaseNode_i32(list, x);
+            x = next;
+        }
+    }
+    if(list->arena){
+        if(shared) releaseNode_i32(list, list->header);
+        slabArena_destroy(list->arena);
+        list->arena = NULL;
+    }else if(!bulk){
+        releaseNode_i32(list, list->header);
+    }
+    list->header = NULL;
+}
+
+static inline void destroyList_i32(struct SkipList_i32_t * list, bool free_data) {
+    // clones and snapshots borrow map values from the map they came from
+    free_data = free_data && list->owns_values;
+    if(list->shared){
+        // the owner may go first, the last snapshot then frees its values
+        if(free_data) atomic_store(&list->shared->free_values, true);
+        if(atomic_fetch_sub(&list->shared->refs, 1) > 1){
+            // the nodes stay with the snapshots still reading them, only the shell goes
+            skipListAllocator_free(&list->allocator, list, listBytes_i32(list->max_height));
+            return;
+        }
+        free_data = atomic_load(&list->shared->free_values);
+        free(list->shared);
+    }
+    releaseAllNodes_i32(list, free_data);
+    SkipListAllocator allocator = list->allocator;
+    skipListAllocator_free(&allocator, list, listBytes_i32(list->max_height));
+    skipListAllocator_freeAll(&allocator);
+}
+
+// every list is created here, max_height sizes the header and p_lo, p_hi
+// bound the promotion probability
+static struct SkipList_i32_t * createShaped_i32(bool is_map, uint32_t flags, const SkipListAllocator * allocator, uint32_t max_height, double p_lo, double p_hi) {
+    static const SkipListAllocator default_allocator = {0};
+    if(!allocator) allocator = &default_allocator;
+    struct SkipList_i32_t * sl = (struct SkipList_i32_t *)skipListAllocator_alloc(allocator, listBytes_i32(max_height));
+    assert(sl);
+    sl->max_level = 1;
+    sl->size = 0;
+    sl->allocator = *allocator;
+    sl->is_map = is_map;
+    sl->backlinks = (flags & SKIPLIST_BACKLINKS) != 0;
+    sl->node_prefix = (is_map ? sizeof(void *) : 0) + (sl->backlinks ? sizeof(Node_i32 *) : 0);
+    sl->version = 0;
+    sl->shared = NULL;
+    sl->read_only = false;
+    sl->owns_values = true;
+    skipListRandom_seed(&sl->rng, 0);
+    sl->max_height = max_height;
+    sl->p_lo = p_lo;
+    sl->p_hi = p_hi;
+    sl->rebalance_step = 0;
+    sl->rebalance_size = 0;
+    sl->rebalance_pos = 0;
+    sl->rebalance_key = 0;
+    sl->indexable = (flags & SKIPLIST_INDEXABLE) != 0;
+    sl->arena = (flags & SKIPLIST_ARENA) ? slabArena_create(max_height, allocator) : NULL;
+    sl->header = getNode_i32(sl, max_height, 0);
+    for(uint32_t i = 0; i < max_height; i++){
+        sl->last[i] = sl->header;
+    }
+    if(sl->indexable){
+        for(uint32_t i = 0; i < max_height; i++){
+            nodeSpan_i32(sl->header)[i] = 0;
+        }
+    }
+    return sl;
+}
+
+static struct SkipList_i32_t * skipList_i32_create_core(bool is_map, uint32_t flags, const SkipListAllocator * allocator) {
+    return createShaped_i32(is_map, flags, allocator, SL_MAX_HEIGHT, P, P_Upper);
+}
+
 
 /* _________________________________________________
 
@@ -91,44 +340,102 @@ _____________________________________________________*/
 
 
 
+// insert for indexable lists, the descent also sums the rank of every
+// predecessor so the spans around the new node can be split
+static bool insertIndexed_i32(struct SkipList_i32_t * list, int32_t key, void * data){
+    Node_i32 * update[SL_MAX_HEIGHT];
+    uint32_t rank[SL_MAX_HEIGHT];
+    Node_i32 * x = list->header;
+    for(int i = list->max_level - 1; i >= 0; i--){
+        rank[i] = (i == (int)list->max_level - 1) ? 0 : rank[i + 1];
+        while(linkBefore_i32(x, i, key)){
+            rank[i] += nodeSpan_i32(x)[i];
+            x = x->forward[i].next;
+        }
+        update[i] = x;
+    }
+    x = x->forward[0].next;
+    if(x && x->key == key){
+        if(data){
+            *nodeData_i32(x) = data;
+            return true;
+        }
+        return false;
+    }
+    uint32_t height = randomLevel_i32(list);
+    if(height > list->max_level){
+        for(uint32_t i = list->max_level; i < height; i++){
+            rank[i] = 0;
+            update[i] = list->header;
+            nodeSpan_i32(list->header)[i] = list->size;
+        }
+        list->max_level = height;
+    }
+    Node_i32 * insertionNode = getNode_i32(list, height, key);
+    if(data){
+        *nodeData_i32(insertionNode) = data;
+    }
+    uint32_t * span = nodeSpan_i32(insertionNode);
+    for(uint32_t i = 0; i < height; i++){
+        insertionNode->forward[i] = update[i]->forward[i];
+        setLink_i32(update[i], i, insertionNode);
+        span[i] = nodeSpan_i32(update[i])[i] - (rank[0] - rank[i]);
+        nodeSpan_i32(update[i])[i] = rank[0] - rank[i] + 1;
+    }
+    afterLink_i32(list, update[0], insertionNode);
+    for(uint32_t i = height; i < list->max_level; i++){
+        nodeSpan_i32(update[i])[i]++;
+    }
+    list->size++;
+    list->version++;
+    return true;
+}
+
 bool skipList_i32_insert_core(struct SkipList_i32_t * list, int32_t key, void * data){
+    if(list->shared) detach_i32(list);
+    if(list->indexable){
+        return insertIndexed_i32(list, key, data);
+    }
+    assert(!data || list->is_map); // values can only be stored by maps
     Node_i32 * x = list->header;
     Node_i32 * update[SL_MAX_HEIGHT];
 
     for(int i = list->max_level-1; i >= 0; i--){
-        while(x->forward[i] && x->forward[i]->key < key){
-            x = x->forward[i];
+        while(linkBefore_i32(x, i, key)){
+            x = x->forward[i].next;
         }
         update[i] = x;
     }
     
     // check for existence
-    x = x->forward[0];
+    x = x->forward[0].next;
     if(x && x->key == key){
         if(data){
-            x->data = data;
+            *nodeData_i32(x) = data;
             return true;
         }
         return false;
     }
     // get randonly selected height
-    uint32_t height = getRandomLevel_i32(list->size,list->max_level);
+    uint32_t height = randomLevel_i32(list);
     if(height > list->max_level){
         for(uint32_t i = list->max_level; i < height; i++){
             update[i] = list->header;
         }
         list->max_level = height;
     }
-    Node_i32 * insertionNode = getNode_i32(height, key);
+    Node_i32 * insertionNode = getNode_i32(list, height, key);
     if(data){
-        insertionNode->data = data;
+        *nodeData_i32(insertionNode) = data;
     }
     //update pointers
     for(uint32_t i = 0; i < height; i++){
         insertionNode->forward[i] = update[i]->forward[i];
-        update[i]->forward[i] = insertionNode;
+        setLink_i32(update[i], i, insertionNode);
     }
+    afterLink_i32(list, update[0], insertionNode);
     list->size++;
+    list->version++;
     return true;
 }
 
@@ -136,10 +443,10 @@ bool skipList_i32_insert_core(struct SkipList_i32_t * list, int32_t key, void *
 bool skipList_i32_search_core(struct SkipList_i32_t * list, int32_t key){
     Node_i32 * x = list->header;
     for(int i = list->max_level - 1; i >= 0; i--){
-        while(x->forward[i] && x->key < key){
-            x = x->forward[i];
+        while(linkBefore_i32(x, i, key)){
+            x = x->forward[i].next;
         }
-        if(x->forward[i] && x->forward[i]->key == key){
+        if(linkMatches_i32(x, i, key)){
             return true;
         }
     }
@@ -150,11 +457,11 @@ bool skipList_i32_search_core(struct SkipList_i32_t * list, int32_t key){
 void * skipList_i32_search_and_return_core(struct SkipList_i32_t * list, int32_t key){
     Node_i32 * x = list->header;
     for(int i = list->max_level - 1; i >= 0; i--){
-        while(x->forward[i] && x->key < key){
-            x = x->forward[i];
+        while(linkBefore_i32(x, i, key)){
+            x = x->forward[i].next;
         }
-        if(x->forward[i] && x->forward[i]->key == key){
-            return x->forward[i]->data;
+        if(linkMatches_i32(x, i, key)){
+            return *nodeData_i32(x->forward[i].next);
         }
     }
     return NULL;
@@ -162,67 +469,67 @@ void * skipList_i32_search_and_return_core(struct SkipList_i32_t * list, int32_t
 
 
 void skipList_i32_removal_core(struct SkipList_i32_t * list, int32_t key){
+    if(list->shared) detach_i32(list);
     Node_i32 * x = list->header;
     Node_i32 * update[SL_MAX_HEIGHT];
     
     for(int i = list->max_level - 1; i >= 0; i--){
-        while(x->forward[i] && x->forward[i]->key < key){
-            x = x->forward[i];
+        while(linkBefore_i32(x, i, key)){
+            x = x->forward[i].next;
         }
         update[i] = x;
     }
 
     // check to see if key even exist
-    x = x->forward[0];
+    x = x->forward[0].next;
     if(!x || x->key != key){
         return;
     }
 
     Node_i32 * removalNode = x;
-    for(int i = 0; i < removalNode->height; i++){
-        update[i]->forward[i] = removalNode->forward[i];
-    }
+    unlinkNode_i32(list, update, removalNode);
     //release allocation
-    free(removalNode);
+    releaseNode_i32(list, removalNode);
 
     //coalesce height
-    while(list->max_level > 1 && !(list->header->forward[list->max_level-1])){
+    while(list->max_level > 1 && !(list->header->forward[list->max_level-1].next)){
         list->max_level -= 1;
     }
     list->size--;
+    list->version++;
 }
 
 
 void * skipList_i32_removal_and_return_core(struct SkipList_i32_t * list, int32_t key){
+    if(list->shared) detach_i32(list);
     Node_i32 * x = list->header;
     Node_i32 * update[SL_MAX_HEIGHT];
     
     for(int i = list->max_level - 1; i >= 0; i--){
-        while(x->forward[i] && x->forward[i]->key < key){
-            x = x->forward[i];
+        while(linkBefore_i32(x, i, key)){
+            x = x->forward[i].next;
         }
         update[i] = x;
     }
 
     // check to see if key even exist
-    x = x->forward[0];
+    x = x->forward[0].next;
     if(!x || x->key != key){
         return NULL;
     }
 
     Node_i32 * removalNode = x;
-    for(int i = 0; i < removalNode->height; i++){
-        update[i]->forward[i] = removalNode->forward[i];
-    }
-    void * data = removalNode->data;
+    unlinkNode_i32(list, update, removalNode);
+    void * data = *nodeData_i32(removalNode);
     //release allocation
-    free(removalNode);
+    releaseNode_i32(list, removalNode);
 
     //coalesce height
-    while(list->max_level > 1 && !(list->header->forward[list->max_level-1])){
+    while(list->max_level > 1 && !(list->header->forward[list->max_level-1].next)){
         list->max_level -= 1;
     }
     list->size--;
+    list->version++;
     return data;
 }
 
@@ -235,22 +542,30 @@ _______________________________________*/
 
 SkipList_i32 *skipList_i32_create(void)
 {
-    SkipList_i32 * sl = (SkipList_i32 *)malloc(sizeof(SkipList_i32));
-    assert(sl);
-    sl->max_level = 1;
-    sl->size = 0;
-    sl->header = getNode_i32(SL_MAX_HEIGHT, 0);
-    return sl;
+    return skipList_i32_create_core(false, 0, NULL);
+}
+
+SkipList_i32 *skipList_i32_create_with_arena(void)
+{
+    return skipList_i32_create_core(false, SKIPLIST_ARENA, NULL);
+}
+
+SkipList_i32 *skipList_i32_create_with_allocator(const SkipListAllocator *allocator)
+{
+    return skipList_i32_create_core(false, 0, allocator);
 }
 
 bool skipList_i32_insert(SkipList_i32 *list, int32_t id)
 {
-    return skipList_i32_insert_core(list, id, NULL);
+    bool inserted = skipList_i32_insert_core(list, id, NULL);
+    if(list->rebalance_step) rebalanceStep_i32(list, 1);
+    return inserted;
 }
 
 void skipList_i32_remove(SkipList_i32 *list, int32_t id)
 {
-    return skipList_i32_removal_core(list, id);
+    skipList_i32_removal_core(list, id);
+    if(list->rebalance_step) rebalanceStep_i32(list, 1);
 }
 
 bool skipList_i32_search(SkipList_i32 *list, int32_t search_id)
@@ -269,16 +584,17 @@ bool skipList_i32_isEmpty(const SkipList_i32 *list)
 }
 
 bool skipList_i32_pop(SkipList_i32 *list, int32_t *removedID) {
+    if(list->shared) detach_i32(list);
     if(skipList_i32_isEmpty(list)||!removedID) {
         return false;
     }
-    Node_i32 * x = list->header->forward[0];
+    Node_i32 * x = list->header->forward[0].next;
     *removedID = x->key;
-    for (uint32_t i = 0; i < x->height; i++) {
-        list->header->forward[i] = x->forward[i];
-    }
-    free(x);
+    unlinkFirst_i32(list, x);
+    releaseNode_i32(list, x);
     list->size--;
+    list->version++;
+    if(list->rebalance_step) rebalanceStep_i32(list, 1);
     return true;
 }
 
@@ -286,26 +602,18 @@ void skipList_i32_destroy(SkipList_i32 **list)
 {
     if (!list || !*list) return;
     SkipList_i32 * sl_list = *list;
-    //iterate through lower level deleting nodes
-    Node_i32 * x = sl_list->header->forward[0];
-    while(x) {
-        Node_i32 * next = x->forward[0];
-        free(x);
-        x = next;
-    }
-    free(sl_list->header);
-    free(sl_list);
+    destroyList_i32(sl_list, false);
     *list = NULL; //prevent use after free
 }
 
 void skipList_i32_print(SkipList_i32 *list)
 {
     for(int i = list->max_level-1; i >= 0; i--){
-        Node_i32 * x = list->header->forward[i];
+        Node_i32 * x = list->header->forward[i].next;
         printf("level %d: -->\t", i);
         while(x){
             printf("%d-->", x->key);
-            x = x->forward[i];
+            x = x->forward[i].next;
         }
         printf("nil\n");
     }
@@ -319,17 +627,24 @@ ___________________________*/
 
 SkipMap_i32 *skipMap_i32_create(void)
 {
-    SkipMap_i32 * sm = (SkipMap_i32 *)malloc(sizeof(SkipMap_i32));
-    assert(sm);
-    sm->max_level = 1;
-    sm->size = 0;
-    sm->header = getNode_i32(SL_MAX_HEIGHT, 0);
-    return sm;
+    return skipList_i32_create_core(true, 0, NULL);
+}
+
+SkipMap_i32 *skipMap_i32_create_with_arena(void)
+{
+    return skipList_i32_create_core(true, SKIPLIST_ARENA, NULL);
+}
+
+SkipMap_i32 *skipMap_i32_create_with_allocator(const SkipListAllocator *allocator)
+{
+    return skipList_i32_create_core(true, 0, allocator);
 }
 
 bool skipMap_i32_put(SkipMap_i32 *sm, int32_t id, void *data)
 {
-    return skipList_i32_insert_core(sm,id,data);
+    bool inserted = skipList_i32_insert_core(sm, id, data);
+    if(sm->rebalance_step) rebalanceStep_i32(sm, 1);
+    return inserted;
 }
 
 void *skipMap_i32_get(SkipMap_i32 *sm, int32_t id)
@@ -339,7 +654,9 @@ void *skipMap_i32_get(SkipMap_i32 *sm, int32_t id)
 
 void *skipMap_i32_remove(SkipMap_i32 *sm, int32_t id)
 {
-    return skipList_i32_removal_and_return_core(sm,id);
+    void * data = skipList_i32_removal_and_return_core(sm, id);
+    if(sm->rebalance_step) rebalanceStep_i32(sm, 1);
+    return data;
 }
 
 bool skipMap_i32_contains(SkipMap_i32 *sm, int32_t id)
@@ -356,18 +673,19 @@ bool skipMap_i32_isEmpty(const SkipMap_i32 *sm) {
 }
 
 bool skipMap_i32_pop(SkipList_i32 *list, struct SM_i32_kv *sm) {
+    if(list->shared) detach_i32(list);
     if(skipMap_i32_isEmpty(list) || !sm) {
         return false;
     }
-    sm->key = list->header->forward[0]->key;
-    sm->value = list->header->forward[0]->data;
+    sm->key = list->header->forward[0].next->key;
+    sm->value = *nodeData_i32(list->header->forward[0].next);
     //need to relink pointers removing this node
-    Node_i32 * x = list->header->forward[0];
-    for (uint32_t i = 0; i < x->height; i++) {
-        list->header->forward[i] = x->forward[i];
-    }
-    free(x);
+    Node_i32 * x = list->header->forward[0].next;
+    unlinkFirst_i32(list, x);
+    releaseNode_i32(list, x);
     list->size--;
+    list->version++;
+    if(list->rebalance_step) rebalanceStep_i32(list, 1);
     return true;
 }
 
@@ -379,27 +697,1692 @@ void skipMap_i32_destroy(SkipMap_i32 **sm)
     //if these data fields point to invalid addresses this will cause a segfault
     //not only that but if the skiplist doesnt own these data pointers, use after free could become possible
     //this should only be considered if the skiplist owns the pointers and the pointers are valid heap allocations
-    Node_i32 * x = (*sm)->header->forward[0];
-    while(x){
-        Node_i32 * next = x->forward[0];
-        free(x->data);
-        x->data = NULL;
-        free(x);
-        x = next;
-    }
-    free((*sm)->header);
-    free((*sm));
+    destroyList_i32(*sm, true);
     *sm = NULL;
 }
 
 void skipMap_i32_print(SkipMap_i32 *sm)
 {
     for(int i = sm->max_level-1; i >= 0; i--){
-        Node_i32 * x = sm->header->forward[i];
+        Node_i32 * x = sm->header->forward[i].next;
         printf("level %d: -->\t", i);
         while(x){
-            printf("(%d, %lX)-->",x->key, (unsigned long)x->data);
+            printf("(%d, %p)-->", x->key, *nodeData_i32(x));
+            x = x->forward[i].next;
         }
         printf("nil\n");
     }      
 }
+
+
+/*_______________________________________
+
+    int32 finger impl
+__________________________________________*/
+
+// a finger remembers the predecessor path of its last key, preds[i] is the last
+// node on level i before that key. Operations near that key climb only as far
+// as the distance needs, O(log d) instead of a full O(log n) descent
+struct SkipListFinger_i32_t {
+    struct SkipList_i32_t * list;
+    uint64_t version;
+    Node_i32 * preds[SL_MAX_HEIGHT];
+};
+
+static inline bool nodeBefore_i32(const struct SkipList_i32_t * list, const Node_i32 * x, int32_t key) {
+    return x == list->header || x->key < key;
+}
+
+static inline void resetFinger_i32(struct SkipListFinger_i32_t * finger) {
+    for(uint32_t i = 0; i < SL_MAX_HEIGHT; i++){
+        finger->preds[i] = finger->list->header;
+    }
+    finger->version = finger->list->version;
+}
+
+// moves the finger onto key, afterwards preds[] is the update path for key
+static void fingerSeek_i32(struct SkipListFinger_i32_t * finger, int32_t key) {
+    struct SkipList_i32_t * list = finger->list;
+    Node_i32 ** preds = finger->preds;
+    int top = list->max_level - 1;
+    int i = 0;
+    if(finger->version != list->version){
+        // the list changed behind our back, nodes on the old path may be gone
+        resetFinger_i32(finger);
+        i = top;
+    }else{
+        // climb until preds[i] is before key and the level above cannot move forward
+        while(i < top && (!nodeBefore_i32(list, preds[i], key) || linkBefore_i32(preds[i + 1], i + 1, key))){
+            i++;
+        }
+        if(!nodeBefore_i32(list, preds[i], key)){
+            preds[i] = list->header;
+        }
+    }
+    Node_i32 * x = preds[i];
+    for(; i >= 0; i--){
+        while(linkBefore_i32(x, i, key)){
+            x = x->forward[i].next;
+        }
+        preds[i] = x;
+    }
+}
+
+static inline Node_i32 * fingerFind_i32(struct SkipListFinger_i32_t * finger, int32_t key) {
+    fingerSeek_i32(finger, key);
+    Node_i32 * x = finger->preds[0]->forward[0].next;
+    return (x && x->key == key) ? x : NULL;
+}
+
+static bool fingerInsert_i32(struct SkipListFinger_i32_t * finger, int32_t key, void * data) {
+    if(finger->list->shared) detach_i32(finger->list);
+    struct SkipList_i32_t * list = finger->list;
+    assert(!data || list->is_map); // values can only be stored by maps
+    Node_i32 * x = fingerFind_i32(finger, key);
+    if(x){
+        if(data){
+            *nodeData_i32(x) = data;
+            return true;
+        }
+        return false;
+    }
+    if(list->indexable){
+        // span upkeep needs the rank of every predecessor, which fingers do not track
+        return skipList_i32_insert_core(list, key, data);
+    }
+    Node_i32 ** update = finger->preds;
+    uint32_t height = randomLevel_i32(list);
+    if(height > list->max_level){
+        for(uint32_t i = list->max_level; i < height; i++){
+            update[i] = list->header;
+        }
+        list->max_level = height;
+    }
+    Node_i32 * insertionNode = getNode_i32(list, height, key);
+    if(data){
+        *nodeData_i32(insertionNode) = data;
+    }
+    for(uint32_t i = 0; i < height; i++){
+        insertionNode->forward[i] = update[i]->forward[i];
+        setLink_i32(update[i], i, insertionNode);
+    }
+    afterLink_i32(list, update[0], insertionNode);
+    list->size++;
+    list->version++;
+    // preds still lead to key, so our own change keeps the finger valid
+    finger->version = list->version;
+    return true;
+}
+
+static void * fingerRemove_i32(struct SkipListFinger_i32_t * finger, int32_t key) {
+    if(finger->list->shared) detach_i32(finger->list);
+    struct SkipList_i32_t * list = finger->list;
+    Node_i32 * x = fingerFind_i32(finger, key);
+    if(!x){
+        return NULL;
+    }
+    unlinkNode_i32(list, finger->preds, x);
+    void * data = list->is_map ? *nodeData_i32(x) : NULL;
+    releaseNode_i32(list, x);
+    //coalesce height
+    while(list->max_level > 1 && !(list->header->forward[list->max_level-1].next)){
+        list->max_level -= 1;
+    }
+    list->size--;
+    list->version++;
+    finger->version = list->version;
+    return data;
+}
+
+static SkipListFinger_i32 * fingerCreate_i32(struct SkipList_i32_t * list) {
+    SkipListFinger_i32 * finger = (SkipListFinger_i32 *)malloc(sizeof(SkipListFinger_i32));
+    assert(finger);
+    finger->list = list;
+    resetFinger_i32(finger);
+    return finger;
+}
+
+SkipListFinger_i32 *skipList_i32_finger_create(SkipList_i32 *list)
+{
+    return fingerCreate_i32(list);
+}
+
+SkipListFinger_i32 *skipMap_i32_finger_create(SkipMap_i32 *sm)
+{
+    return fingerCreate_i32(sm);
+}
+
+void skipList_i32_finger_destroy(SkipListFinger_i32 **finger)
+{
+    if(!finger || !*finger) return;
+    free(*finger);
+    *finger = NULL;
+}
+
+bool skipList_i32_finger_search(SkipListFinger_i32 *finger, int32_t id)
+{
+    return fingerFind_i32(finger, id) != NULL;
+}
+
+bool skipList_i32_finger_insert(SkipListFinger_i32 *finger, int32_t id)
+{
+    return fingerInsert_i32(finger, id, NULL);
+}
+
+void skipList_i32_finger_remove(SkipListFinger_i32 *finger, int32_t id)
+{
+    fingerRemove_i32(finger, id);
+}
+
+bool skipMap_i32_finger_put(SkipListFinger_i32 *finger, int32_t id, void *data)
+{
+    return fingerInsert_i32(finger, id, data);
+}
+
+void *skipMap_i32_finger_get(SkipListFinger_i32 *finger, int32_t id)
+{
+    Node_i32 * x = fingerFind_i32(finger, id);
+    return x ? *nodeData_i32(x) : NULL;
+}
+
+void *skipMap_i32_finger_remove(SkipListFinger_i32 *finger, int32_t id)
+{
+    return fingerRemove_i32(finger, id);
+}
+
+
+/*_______________________________________
+
+    int32 navigation impl
+__________________________________________*/
+
+// single descent to the last node before key, the header when none is
+static inline Node_i32 * lastBefore_i32(struct SkipList_i32_t * list, int32_t key) {
+    Node_i32 * x = list->header;
+    for(int i = list->max_level - 1; i >= 0; i--){
+        while(linkBefore_i32(x, i, key)){
+            x = x->forward[i].next;
+        }
+    }
+    return x;
+}
+
+// upward finds the first node after key, downward the last node before it,
+// inclusive lets a node equal to key answer either way
+static Node_i32 * navigate_i32(struct SkipList_i32_t * list, int32_t key, bool upward, bool inclusive) {
+    Node_i32 * x = lastBefore_i32(list, key);
+    Node_i32 * next = x->forward[0].next;
+    bool equal = next && next->key == key;
+    if(equal && inclusive){
+        return next;
+    }
+    if(upward){
+        return equal ? next->forward[0].next : next;
+    }
+    return x == list->header ? NULL : x;
+}
+
+static inline bool navigateKey_i32(struct SkipList_i32_t * list, int32_t key, bool upward, bool inclusive, int32_t * out) {
+    Node_i32 * x = navigate_i32(list, key, upward, inclusive);
+    if(!x) return false;
+    if(out) *out = x->key;
+    return true;
+}
+
+static inline bool navigateEntry_i32(struct SkipList_i32_t * list, int32_t key, bool upward, bool inclusive, struct SM_i32_kv * out) {
+    Node_i32 * x = navigate_i32(list, key, upward, inclusive);
+    if(!x) return false;
+    if(out){
+        out->key = x->key;
+        out->value = *nodeData_i32(x);
+    }
+    return true;
+}
+
+bool skipList_i32_ceiling(SkipList_i32 *list, int32_t id, int32_t *out)
+{
+    return navigateKey_i32(list, id, true, true, out);
+}
+
+bool skipList_i32_floor(SkipList_i32 *list, int32_t id, int32_t *out)
+{
+    return navigateKey_i32(list, id, false, true, out);
+}
+
+bool skipList_i32_higher(SkipList_i32 *list, int32_t id, int32_t *out)
+{
+    return navigateKey_i32(list, id, true, false, out);
+}
+
+bool skipList_i32_lower(SkipList_i32 *list, int32_t id, int32_t *out)
+{
+    return navigateKey_i32(list, id, false, false, out);
+}
+
+bool skipMap_i32_ceiling(SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out)
+{
+    return navigateEntry_i32(sm, id, true, true, out);
+}
+
+bool skipMap_i32_floor(SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out)
+{
+    return navigateEntry_i32(sm, id, false, true, out);
+}
+
+bool skipMap_i32_higher(SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out)
+{
+    return navigateEntry_i32(sm, id, true, false, out);
+}
+
+bool skipMap_i32_lower(SkipMap_i32 *sm, int32_t id, struct SM_i32_kv *out)
+{
+    return navigateEntry_i32(sm, id, false, false, out);
+}
+
+
+/*_______________________________________
+
+    int32 range scan impl
+__________________________________________*/
+
+// first node with key >= lo, or NULL
+static inline Node_i32 * scanStart_i32(struct SkipList_i32_t * list, int32_t lo) {
+    return lastBefore_i32(list, lo)->forward[0].next;
+}
+
+uint32_t skipList_i32_scan(SkipList_i32 *list, int32_t lo, int32_t hi, SkipList_i32_visitor visit, void *ctx)
+{
+    assert(visit);
+    uint32_t visited = 0;
+    if(lo >= hi) return 0;
+    for(Node_i32 * x = scanStart_i32(list, lo); x && x->key < hi; x = x->forward[0].next){
+        visited++;
+        if(!visit(x->key, ctx)) break;
+    }
+    return visited;
+}
+
+uint32_t skipList_i32_scanBatch(SkipList_i32 *list, int32_t *lo, int32_t hi, int32_t *out, uint32_t cap)
+{
+    assert(lo && (out || !cap));
+    uint32_t n = 0;
+    if(*lo >= hi || !cap) return 0;
+    for(Node_i32 * x = scanStart_i32(list, *lo); x && x->key < hi && n < cap; x = x->forward[0].next){
+        out[n++] = x->key;
+    }
+    // the last key is below hi so the resume point cannot overflow
+    *lo = n ? out[n - 1] + 1 : hi;
+    return n;
+}
+
+uint32_t skipMap_i32_scan(SkipMap_i32 *sm, int32_t lo, int32_t hi, SkipMap_i32_visitor visit, void *ctx)
+{
+    assert(visit);
+    uint32_t visited = 0;
+    if(lo >= hi) return 0;
+    for(Node_i32 * x = scanStart_i32(sm, lo); x && x->key < hi; x = x->forward[0].next){
+        visited++;
+        if(!visit(x->key, *nodeData_i32(x), ctx)) break;
+    }
+    return visited;
+}
+
+uint32_t skipMap_i32_scanBatch(SkipMap_i32 *sm, int32_t *lo, int32_t hi, struct SM_i32_kv *out, uint32_t cap)
+{
+    assert(lo && (out || !cap));
+    uint32_t n = 0;
+    if(*lo >= hi || !cap) return 0;
+    for(Node_i32 * x = scanStart_i32(sm, *lo); x && x->key < hi && n < cap; x = x->forward[0].next){
+        out[n].key = x->key;
+        out[n].value = *nodeData_i32(x);
+        n++;
+    }
+    *lo = n ? out[n - 1].key + 1 : hi;
+    return n;
+}
+
+
+/*_______________________________________
+
+    int32 iterator impl
+__________________________________________*/
+
+// node is the current entry, or its successor once the current entry was
+// removed. key always holds the current key so a removed position can be
+// re-found by descending, version tells us when that is needed
+struct SkipListIter_i32_t {
+    struct SkipList_i32_t * list;
+    Node_i32 * node;
+    int32_t key;
+    uint64_t version;
+    bool valid;
+    bool removed;
+};
+
+static inline void iterAt_i32(struct SkipListIter_i32_t * it, Node_i32 * x) {
+    it->node = x;
+    it->valid = x != NULL;
+    it->removed = false;
+    if(x) it->key = x->key;
+    it->version = it->list->version;
+}
+
+// after changes made without this iterator the node pointer may be dangling,
+// descend to the current key again, O(log n) once per change
+static inline void iterSync_i32(struct SkipListIter_i32_t * it) {
+    if(it->version == it->list->version || !it->valid){
+        return;
+    }
+    Node_i32 * x = lastBefore_i32(it->list, it->key)->forward[0].next;
+    bool present = !it->removed && x && x->key == it->key;
+    it->node = x;
+    it->removed = !present;
+    it->version = it->list->version;
+}
+
+// removes a node the caller already holds, its predecessors are found by
+// walking back along level 0, an expected 1/p steps per level instead of a
+// descent. Not for indexable lists, their spans need every level's predecessor
+static void * removeKnown_i32(struct SkipList_i32_t * list, Node_i32 * x) {
+    assert(list->backlinks && !list->indexable);
+    Node_i32 * update[SL_MAX_HEIGHT];
+    Node_i32 * pred = *nodeBack_i32(list, x);
+    // level 0 needs no walk, set outside the loop so update[0] is visibly written
+    update[0] = pred;
+    for(uint32_t i = 1; i < x->height; i++){
+        // the header is taller than any node so the walk stops there at the latest
+        while(pred->height <= i){
+            pred = *nodeBack_i32(list, pred);
+        }
+        update[i] = pred;
+    }
+    unlinkNode_i32(list, update, x);
+    void * data = list->is_map ? *nodeData_i32(x) : NULL;
+    releaseNode_i32(list, x);
+    //coalesce height
+    while(list->max_level > 1 && !(list->header->forward[list->max_level-1].next)){
+        list->max_level -= 1;
+    }
+    list->size--;
+    list->version++;
+    return data;
+}
+
+static SkipListIter_i32 * iterCreate_i32(struct SkipList_i32_t * list) {
+    SkipListIter_i32 * it = (SkipListIter_i32 *)malloc(sizeof(SkipListIter_i32));
+    assert(it);
+    it->list = list;
+    iterAt_i32(it, list->header->forward[0].next);
+    return it;
+}
+
+SkipListIter_i32 *skipList_i32_iter_create(SkipList_i32 *list)
+{
+    return iterCreate_i32(list);
+}
+
+SkipListIter_i32 *skipMap_i32_iter_create(SkipMap_i32 *sm)
+{
+    return iterCreate_i32(sm);
+}
+
+void skipList_i32_iter_destroy(SkipListIter_i32 **it)
+{
+    if(!it || !*it) return;
+    free(*it);
+    *it = NULL;
+}
+
+void skipList_i32_iter_seek(SkipListIter_i32 *it, int32_t id)
+{
+    iterAt_i32(it, lastBefore_i32(it->list, id)->forward[0].next);
+}
+
+bool skipList_i32_iter_valid(const SkipListIter_i32 *it)
+{
+    return it->valid;
+}
+
+bool skipList_i32_iter_next(SkipListIter_i32 *it)
+{
+    if(!it->valid) return false;
+    iterSync_i32(it);
+    iterAt_i32(it, it->removed ? it->node : it->node->forward[0].next);
+    return it->valid;
+}
+
+int32_t skipList_i32_iter_key(const SkipListIter_i32 *it)
+{
+    assert(it->valid);
+    return it->key;
+}
+
+void *skipMap_i32_iter_value(SkipListIter_i32 *it)
+{
+    assert(it->list->is_map); // values only exist in maps
+    if(!it->valid) return NULL;
+    iterSync_i32(it);
+    return it->removed ? NULL : *nodeData_i32(it->node);
+}
+
+bool skipList_i32_iter_remove(SkipListIter_i32 *it)
+{
+    if(it->list->shared) detach_i32(it->list);
+    if(!it->valid) return false;
+    iterSync_i32(it);
+    if(it->removed) return false;
+    Node_i32 * next = it->node->forward[0].next;
+    if(it->list->backlinks && !it->list->indexable){
+        removeKnown_i32(it->list, it->node);
+    }else{
+        skipList_i32_removal_core(it->list, it->key);
+    }
+    // the successor is known, next() stays O(1) after our own removal
+    it->node = next;
+    it->removed = true;
+    it->version = it->list->version;
+    return true;
+}
+
+void *skipMap_i32_iter_remove(SkipListIter_i32 *it)
+{
+    if(it->list->shared) detach_i32(it->list);
+    if(!it->valid) return NULL;
+    iterSync_i32(it);
+    if(it->removed) return NULL;
+    Node_i32 * next = it->node->forward[0].next;
+    void * data = (it->list->backlinks && !it->list->indexable) ? removeKnown_i32(it->list, it->node)
+                                                                 : skipList_i32_removal_and_return_core(it->list, it->key);
+    it->node = next;
+    it->removed = true;
+    it->version = it->list->version;
+    return data;
+}
+
+
+/*_______________________________________
+
+    int32 indexable impl
+__________________________________________*/
+
+// number of keys below key, summing spans along the descent
+static uint32_t rank_i32(struct SkipList_i32_t * list, int32_t key) {
+    assert(list->indexable); // created without SKIPLIST_INDEXABLE
+    uint32_t rank = 0;
+    Node_i32 * x = list->header;
+    for(int i = list->max_level - 1; i >= 0; i--){
+        while(linkBefore_i32(x, i, key)){
+            rank += nodeSpan_i32(x)[i];
+            x = x->forward[i].next;
+        }
+    }
+    return rank;
+}
+
+// node at 0 based position index, NULL when out of range
+static Node_i32 * select_i32(struct SkipList_i32_t * list, uint32_t index) {
+    assert(list->indexable); // created without SKIPLIST_INDEXABLE
+    if(index >= list->size) return NULL;
+    uint32_t target = index + 1;
+    uint32_t traversed = 0;
+    Node_i32 * x = list->header;
+    for(int i = list->max_level - 1; i >= 0; i--){
+        while(x->forward[i].next && traversed + nodeSpan_i32(x)[i] <= target){
+            traversed += nodeSpan_i32(x)[i];
+            x = x->forward[i].next;
+        }
+        if(traversed == target) return x;
+    }
+    return NULL;
+}
+
+uint32_t skipList_i32_rank(SkipList_i32 *list, int32_t id)
+{
+    return rank_i32(list, id);
+}
+
+bool skipList_i32_select(SkipList_i32 *list, uint32_t index, int32_t *out)
+{
+    Node_i32 * x = select_i32(list, index);
+    if(!x) return false;
+    if(out) *out = x->key;
+    return true;
+}
+
+uint32_t skipList_i32_countRange(SkipList_i32 *list, int32_t lo, int32_t hi)
+{
+    if(lo >= hi) return 0;
+    return rank_i32(list, hi) - rank_i32(list, lo);
+}
+
+SkipList_i32 *skipList_i32_create_with_flags(uint32_t flags)
+{
+    return skipList_i32_create_core(false, flags, NULL);
+}
+
+SkipMap_i32 *skipMap_i32_create_with_flags(uint32_t flags)
+{
+    return skipList_i32_create_core(true, flags, NULL);
+}
+
+uint32_t skipMap_i32_rank(SkipMap_i32 *sm, int32_t id)
+{
+    return rank_i32(sm, id);
+}
+
+bool skipMap_i32_select(SkipMap_i32 *sm, uint32_t index, struct SM_i32_kv *out)
+{
+    Node_i32 * x = select_i32(sm, index);
+    if(!x) return false;
+    if(out){
+        out->key = x->key;
+        out->value = *nodeData_i32(x);
+    }
+    return true;
+}
+
+uint32_t skipMap_i32_countRange(SkipMap_i32 *sm, int32_t lo, int32_t hi)
+{
+    return skipList_i32_countRange(sm, lo, hi);
+}
+
+
+/*_______________________________________
+
+    int32 reverse iteration impl
+__________________________________________*/
+
+// node with the largest key, NULL when empty
+static inline Node_i32 * lastNode_i32(struct SkipList_i32_t * list) {
+    return list->last[0] == list->header ? NULL : list->last[0];
+}
+
+void skipList_i32_iter_last(SkipListIter_i32 *it)
+{
+    iterAt_i32(it, lastNode_i32(it->list));
+}
+
+void skipList_i32_iter_seekBefore(SkipListIter_i32 *it, int32_t id)
+{
+    Node_i32 * x = lastBefore_i32(it->list, id);
+    iterAt_i32(it, x == it->list->header ? NULL : x);
+}
+
+bool skipList_i32_iter_prev(SkipListIter_i32 *it)
+{
+    assert(it->list->backlinks); // created without SKIPLIST_BACKLINKS
+    if(!it->valid) return false;
+    iterSync_i32(it);
+    // a removed position keeps its successor, whose back link is the entry we want
+    Node_i32 * x = it->node ? *nodeBack_i32(it->list, it->node) : lastBefore_i32(it->list, it->key);
+    iterAt_i32(it, x == it->list->header ? NULL : x);
+    return it->valid;
+}
+
+uint32_t skipList_i32_scanReverse(SkipList_i32 *list, int32_t lo, int32_t hi, SkipList_i32_visitor visit, void *ctx)
+{
+    assert(list->backlinks && visit);
+    uint32_t visited = 0;
+    if(lo >= hi) return 0;
+    for(Node_i32 * x = lastBefore_i32(list, hi); x != list->header && x->key >= lo; x = *nodeBack_i32(list, x)){
+        visited++;
+        if(!visit(x->key, ctx)) break;
+    }
+    return visited;
+}
+
+uint32_t skipMap_i32_scanReverse(SkipMap_i32 *sm, int32_t lo, int32_t hi, SkipMap_i32_visitor visit, void *ctx)
+{
+    assert(sm->backlinks && visit);
+    uint32_t visited = 0;
+    if(lo >= hi) return 0;
+    for(Node_i32 * x = lastBefore_i32(sm, hi); x != sm->header && x->key >= lo; x = *nodeBack_i32(sm, x)){
+        visited++;
+        if(!visit(x->key, *nodeData_i32(x), ctx)) break;
+    }
+    return visited;
+}
+
+
+/*_______________________________________
+
+    int32 double ended impl
+__________________________________________*/
+
+// unlinks the largest node without descending from the header. Above the
+// tail's height last[i] already is the predecessor, below it the walk starts
+// from last[height], a node known to sit before the tail, so only the last
+// few steps of a descent are paid, expected O(1)
+static Node_i32 * unlinkLast_i32(struct SkipList_i32_t * list) {
+    if(list->shared) detach_i32(list);
+    Node_i32 * x = list->last[0];
+    if(x == list->header) return NULL;
+    Node_i32 * update[SL_MAX_HEIGHT];
+    for(uint32_t i = x->height; i < list->max_level; i++){
+        update[i] = list->last[i];
+    }
+    Node_i32 * pred = x->height < list->max_level ? list->last[x->height] : list->header;
+    for(int i = x->height - 1; i >= 0; i--){
+        while(pred->forward[i].next != x){
+            pred = pred->forward[i].next;
+        }
+        update[i] = pred;
+    }
+    unlinkNode_i32(list, update, x);
+    return x;
+}
+
+static inline void releaseLast_i32(struct SkipList_i32_t * list, Node_i32 * x) {
+    releaseNode_i32(list, x);
+    //coalesce height
+    while(list->max_level > 1 && !(list->header->forward[list->max_level-1].next)){
+        list->max_level -= 1;
+    }
+    list->size--;
+    list->version++;
+}
+
+bool skipList_i32_peekMin(const SkipList_i32 *list, int32_t *out)
+{
+    Node_i32 * x = list->header->forward[0].next;
+    if(!x) return false;
+    if(out) *out = x->key;
+    return true;
+}
+
+bool skipList_i32_peekMax(const SkipList_i32 *list, int32_t *out)
+{
+    Node_i32 * x = list->last[0];
+    if(x == list->header) return false;
+    if(out) *out = x->key;
+    return true;
+}
+
+bool skipList_i32_popMax(SkipList_i32 *list, int32_t *removed_id)
+{
+    Node_i32 * x = unlinkLast_i32(list);
+    if(!x) return false;
+    if(removed_id) *removed_id = x->key;
+    releaseLast_i32(list, x);
+    if(list->rebalance_step) rebalanceStep_i32(list, 1);
+    return true;
+}
+
+bool skipMap_i32_peekMin(const SkipMap_i32 *sm, struct SM_i32_kv *kv)
+{
+    Node_i32 * x = sm->header->forward[0].next;
+    if(!x) return false;
+    if(kv){
+        kv->key = x->key;
+        kv->value = *nodeData_i32(x);
+    }
+    return true;
+}
+
+bool skipMap_i32_peekMax(const SkipMap_i32 *sm, struct SM_i32_kv *kv)
+{
+    Node_i32 * x = sm->last[0];
+    if(x == sm->header) return false;
+    if(kv){
+        kv->key = x->key;
+        kv->value = *nodeData_i32(x);
+    }
+    return true;
+}
+
+bool skipMap_i32_popMax(SkipMap_i32 *sm, struct SM_i32_kv *kv)
+{
+    Node_i32 * x = unlinkLast_i32(sm);
+    if(!x) return false;
+    if(kv){
+        kv->key = x->key;
+        kv->value = *nodeData_i32(x);
+    }
+    releaseLast_i32(sm, x);
+    if(sm->rebalance_step) rebalanceStep_i32(sm, 1);
+    return true;
+}
+
+
+/*_______________________________________
+
+    int32 bulk build impl
+__________________________________________*/
+
+// the i-th node (1 based) is promoted once per time fanout divides i, every
+// level holds exactly a 1/fanout share of the one below
+static inline uint32_t buildHeight_i32(uint32_t i, uint32_t fanout, uint32_t cap) {
+    uint32_t height = 1;
+    while(i % fanout == 0 && height < cap){
+        i /= fanout;
+        height++;
+    }
+    return height;
+}
+
+// appends ascending keys to the tail of an empty list, list->last doubles as
+// the per level tail and rank[] tracks where each tail sits for spans
+typedef struct Builder_i32_t {
+    struct SkipList_i32_t * list;
+    uint32_t rank[SL_MAX_HEIGHT];
+}Builder_i32;
+
+static inline void builderInit_i32(Builder_i32 * builder, struct SkipList_i32_t * list) {
+    builder->list = list;
+    memset(builder->rank, 0, sizeof(builder->rank));
+}
+
+static inline Node_i32 * builderAppend_i32(Builder_i32 * builder, int32_t key) {
+    struct SkipList_i32_t * list = builder->list;
+    uint32_t count = ++list->size;
+    uint32_t height = buildHeight_i32(count, SL_BUILD_FANOUT, list->max_height);
+    Node_i32 * prev = list->last[0];
+    Node_i32 * x = getNode_i32(list, height, key);
+    for(uint32_t i = 0; i < height; i++){
+        setLink_i32(list->last[i], i, x);
+        if(list->indexable){
+            nodeSpan_i32(list->last[i])[i] = count - builder->rank[i];
+            builder->rank[i] = count;
+        }
+        list->last[i] = x;
+    }
+    if(list->backlinks) *nodeBack_i32(list, x) = prev;
+    if(height > list->max_level) list->max_level = height;
+    return x;
+}
+
+static inline void builderFinish_i32(Builder_i32 * builder) {
+    struct SkipList_i32_t * list = builder->list;
+    if(list->indexable){
+        // a NULL link spans the nodes after its owner
+        for(uint32_t i = 0; i < list->max_height; i++){
+            nodeSpan_i32(list->last[i])[i] = list->size - builder->rank[i];
+        }
+    }
+    list->version++;
+}
+
+// appends every key to the tail of its levels in one pass
+static struct SkipList_i32_t * buildFromSorted_i32(bool is_map, uint32_t flags, const int32_t * keys, void * const * values, uint32_t n) {
+    assert(keys || !n);
+    struct SkipList_i32_t * list = skipList_i32_create_core(is_map, flags, NULL);
+    Builder_i32 builder;
+    builderInit_i32(&builder, list);
+    Node_i32 * prev = NULL;
+    for(uint32_t j = 0; j < n; j++){
+        if(prev && keys[j] == prev->key){
+            // duplicates collapse, for maps the later value wins like a repeated put
+            if(values) *nodeData_i32(prev) = values[j];
+            continue;
+        }
+        assert(!prev || keys[j] > prev->key); // input has to be ascending
+        prev = builderAppend_i32(&builder, keys[j]);
+        if(values) *nodeData_i32(prev) = values[j];
+    }
+    builderFinish_i32(&builder);
+    return list;
+}
+
+SkipList_i32 *skipList_i32_buildFromSorted(const int32_t *keys, uint32_t n)
+{
+    return buildFromSorted_i32(false, SKIPLIST_ARENA, keys, NULL, n);
+}
+
+SkipList_i32 *skipList_i32_buildFromSorted_with_flags(const int32_t *keys, uint32_t n, uint32_t flags)
+{
+    return buildFromSorted_i32(false, flags, keys, NULL, n);
+}
+
+SkipMap_i32 *skipMap_i32_buildFromSorted(const int32_t *keys, void * const *values, uint32_t n)
+{
+    return buildFromSorted_i32(true, SKIPLIST_ARENA, keys, values, n);
+}
+
+SkipMap_i32 *skipMap_i32_buildFromSorted_with_flags(const int32_t *keys, void * const *values, uint32_t n, uint32_t flags)
+{
+    return buildFromSorted_i32(true, flags, keys, values, n);
+}
+
+
+/*_______________________________________
+
+    int32 batch update impl
+__________________________________________*/
+
+// map batches remember their input position so a repeated key keeps the
+// value put last once sorted
+typedef struct BatchEntry_i32_t {
+    int32_t key;
+    uint32_t order;
+    void * value;
+}BatchEntry_i32;
+
+static int compareKeys_i32(const void * a, const void * b) {
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compareEntries_i32(const void * a, const void * b) {
+    const BatchEntry_i32 * x = (const BatchEntry_i32 *)a;
+    const BatchEntry_i32 * y = (const BatchEntry_i32 *)b;
+    if(x->key != y->key) return (x->key > y->key) - (x->key < y->key);
+    return (x->order > y->order) - (x->order < y->order);
+}
+
+static inline bool isSorted_i32(const int32_t * keys, uint32_t n) {
+    for(uint32_t i = 1; i < n; i++){
+        if(keys[i] < keys[i - 1]) return false;
+    }
+    return true;
+}
+
+// ascending view of keys, a sorted private copy when the caller's order is not
+static const int32_t * sortedKeys_i32(const int32_t * keys, uint32_t n, int32_t ** copy) {
+    *copy = NULL;
+    if(isSorted_i32(keys, n)) return keys;
+    *copy = (int32_t *)malloc(n * sizeof(int32_t));
+    assert(*copy);
+    memcpy(*copy, keys, n * sizeof(int32_t));
+    qsort(*copy, n, sizeof(int32_t), compareKeys_i32);
+    return *copy;
+}
+
+// the batch walks a finger over the list in key order, every key resumes from
+// the predecessors of the one before it, so the batch costs one merge pass
+// rather than n descents from the header. Indexable lists insert through the
+// core since fingers do not track ranks
+static inline void batchFinger_i32(struct SkipListFinger_i32_t * finger, struct SkipList_i32_t * list) {
+    finger->list = list;
+    resetFinger_i32(finger);
+}
+
+uint32_t skipList_i32_insertBatch(SkipList_i32 *list, const int32_t *keys, uint32_t n)
+{
+    if(!n) return 0;
+    int32_t * copy;
+    const int32_t * sorted = sortedKeys_i32(keys, n, &copy);
+    uint32_t before = list->size;
+    struct SkipListFinger_i32_t finger;
+    batchFinger_i32(&finger, list);
+    for(uint32_t i = 0; i < n; i++){
+        fingerInsert_i32(&finger, sorted[i], NULL);
+    }
+    free(copy);
+    if(list->rebalance_step) rebalanceStep_i32(list, n);
+    return list->size - before;
+}
+
+uint32_t skipList_i32_removeBatch(SkipList_i32 *list, const int32_t *keys, uint32_t n)
+{
+    if(!n) return 0;
+    int32_t * copy;
+    const int32_t * sorted = sortedKeys_i32(keys, n, &copy);
+    uint32_t before = list->size;
+    struct SkipListFinger_i32_t finger;
+    batchFinger_i32(&finger, list);
+    for(uint32_t i = 0; i < n; i++){
+        fingerRemove_i32(&finger, sorted[i]);
+    }
+    free(copy);
+    if(list->rebalance_step) rebalanceStep_i32(list, n);
+    return before - list->size;
+}
+
+uint32_t skipMap_i32_putBatch(SkipMap_i32 *sm, const int32_t *keys, void * const *values, uint32_t n)
+{
+    if(!n) return 0;
+    assert(keys && values);
+    uint32_t before = sm->size;
+    struct SkipListFinger_i32_t finger;
+    batchFinger_i32(&finger, sm);
+    if(isSorted_i32(keys, n)){
+        for(uint32_t i = 0; i < n; i++){
+            fingerInsert_i32(&finger, keys[i], values[i]);
+        }
+    }else{
+        BatchEntry_i32 * entries = (BatchEntry_i32 *)malloc(n * sizeof(BatchEntry_i32));
+        assert(entries);
+        for(uint32_t i = 0; i < n; i++){
+            entries[i].key = keys[i];
+            entries[i].order = i;
+            entries[i].value = values[i];
+        }
+        qsort(entries, n, sizeof(BatchEntry_i32), compareEntries_i32);
+        for(uint32_t i = 0; i < n; i++){
+            fingerInsert_i32(&finger, entries[i].key, entries[i].value);
+        }
+        free(entries);
+    }
+    if(sm->rebalance_step) rebalanceStep_i32(sm, n);
+    return sm->size - before;
+}
+
+
+/*_______________________________________
+
+    int32 range removal impl
+__________________________________________*/
+
+// detaches every node of [lo, hi) with one splice per level and returns the
+// first detached node, the chain stays linked on level 0 through *tail.
+// size is left to the caller, which counts the chain while releasing it
+static Node_i32 * spliceRange_i32(struct SkipList_i32_t * list, int32_t lo, int32_t hi, Node_i32 ** tail) {
+    if(list->shared) detach_i32(list);
+    Node_i32 * update[SL_MAX_HEIGHT];
+    Node_i32 * end[SL_MAX_HEIGHT];
+    uint32_t rank_lo[SL_MAX_HEIGHT];
+    uint32_t rank_hi[SL_MAX_HEIGHT];
+    int top = list->max_level - 1;
+    // both descents write every level below max_level, the header first makes that visible
+    for(uint32_t i = 0; i < list->max_level; i++){
+        update[i] = end[i] = list->header;
+    }
+    Node_i32 * x = list->header;
+    uint32_t rank = 0;
+    for(int i = top; i >= 0; i--){
+        while(linkBefore_i32(x, i, lo)){
+            if(list->indexable) rank += nodeSpan_i32(x)[i];
+            x = x->forward[i].next;
+        }
+        update[i] = x;
+        rank_lo[i] = rank;
+    }
+    // second descent to hi, each level resumes from whichever of the two
+    // paths is further right so only nodes inside the range are walked
+    x = list->header;
+    rank = 0;
+    for(int i = top; i >= 0; i--){
+        if(update[i] != list->header && (x == list->header || update[i]->key > x->key)){
+            x = update[i];
+            rank = rank_lo[i];
+        }
+        while(linkBefore_i32(x, i, hi)){
+            if(list->indexable) rank += nodeSpan_i32(x)[i];
+            x = x->forward[i].next;
+        }
+        end[i] = x;
+        rank_hi[i] = rank;
+    }
+    Node_i32 * first = update[0]->forward[0].next;
+    if(end[0] == update[0]){
+        return NULL;
+    }
+    *tail = end[0];
+    for(int i = top; i >= 0; i--){
+        if(list->indexable){
+            // distance from update[i] to the first node after the range, minus what leaves
+            uint32_t span = rank_hi[i] - rank_lo[i] + nodeSpan_i32(end[i])[i];
+            nodeSpan_i32(update[i])[i] = span - (rank_hi[0] - rank_lo[0]);
+        }
+        if(end[i] != update[i]){
+            update[i]->forward[i] = end[i]->forward[i];
+        }
+        if(!update[i]->forward[i].next) list->last[i] = update[i];
+    }
+    if(list->backlinks && update[0]->forward[0].next){
+        *nodeBack_i32(list, update[0]->forward[0].next) = update[0];
+    }
+    //coalesce height
+    while(list->max_level > 1 && !(list->header->forward[list->max_level-1].next)){
+        list->max_level -= 1;
+    }
+    list->version++;
+    return first;
+}
+
+uint32_t skipList_i32_removeRange(SkipList_i32 *list, int32_t lo, int32_t hi, SkipList_i32_on_remove on_remove, void *ctx)
+{
+    if(lo >= hi) return 0;
+    Node_i32 * tail;
+    Node_i32 * x = spliceRange_i32(list, lo, hi, &tail);
+    uint32_t count = 0;
+    while(x){
+        Node_i32 * next = (x == tail) ? NULL : x->forward[0].next;
+        if(on_remove) on_remove(x->key, ctx);
+        releaseNode_i32(list, x);
+        count++;
+        x = next;
+    }
+    list->size -= count;
+    if(list->rebalance_step) rebalanceStep_i32(list, count);
+    return count;
+}
+
+uint32_t skipMap_i32_removeRange(SkipMap_i32 *sm, int32_t lo, int32_t hi, SkipMap_i32_on_remove on_remove, void *ctx)
+{
+    if(lo >= hi) return 0;
+    Node_i32 * tail;
+    Node_i32 * x = spliceRange_i32(sm, lo, hi, &tail);
+    uint32_t count = 0;
+    while(x){
+        Node_i32 * next = (x == tail) ? NULL : x->forward[0].next;
+        if(on_remove) on_remove(x->key, *nodeData_i32(x), ctx);
+        releaseNode_i32(sm, x);
+        count++;
+        x = next;
+    }
+    sm->size -= count;
+    if(sm->rebalance_step) rebalanceStep_i32(sm, count);
+    return count;
+}
+
+
+/*_______________________________________
+
+    int32 split and concat impl
+__________________________________________*/
+
+// an empty list with the layout of like whose nodes come from the same place,
+// arena backed lists share the arena so nodes can move between the two
+static struct SkipList_i32_t * createSibling_i32(struct SkipList_i32_t * like) {
+    uint32_t flags = (like->indexable ? SKIPLIST_INDEXABLE : 0) | (like->backlinks ? SKIPLIST_BACKLINKS : 0);
+    struct SkipList_i32_t * sl = createShaped_i32(like->is_map, flags, &like->allocator, like->max_height, like->p_lo, like->p_hi);
+    sl->rebalance_step = like->rebalance_step;
+    sl->owns_values = like->owns_values;
+    // a seeded list splits into seeded halves
+    skipListRandom_seed(&sl->rng, skipListRandom_next(&like->rng));
+    if(like->arena){
+        releaseNode_i32(sl, sl->header);
+        sl->arena = slabArena_retain(like->arena);
+        sl->header = getNode_i32(sl, sl->max_height, 0);
+        for(uint32_t i = 0; i < sl->max_height; i++){
+            sl->last[i] = sl->header;
+            if(sl->indexable) nodeSpan_i32(sl->header)[i] = 0;
+        }
+    }
+    return sl;
+}
+
+static void coalesce_i32(struct SkipList_i32_t * list) {
+    while(list->max_level > 1 && !(list->header->forward[list->max_level-1].next)){
+        list->max_level -= 1;
+    }
+}
+
+static struct SkipList_i32_t * split_i32(struct SkipList_i32_t * list, int32_t key) {
+    if(list->shared) detach_i32(list);
+    // a bulk free allocator would take the nodes of both lists with whichever is destroyed first
+    assert(!skipListAllocator_hasBulkFree(&list->allocator));
+    Node_i32 * update[SL_MAX_HEIGHT];
+    uint32_t rank[SL_MAX_HEIGHT];
+    Node_i32 * x = list->header;
+    uint32_t r = 0;
+    for(int i = list->max_level - 1; i >= 0; i--){
+        while(linkBefore_i32(x, i, key)){
+            if(list->indexable) r += nodeSpan_i32(x)[i];
+            x = x->forward[i].next;
+        }
+        update[i] = x;
+        rank[i] = r;
+    }
+    struct SkipList_i32_t * right = createSibling_i32(list);
+    right->max_level = list->max_level;
+    for(uint32_t i = 0; i < list->max_level; i++){
+        right->header->forward[i] = update[i]->forward[i];
+        if(right->header->forward[i].next) right->last[i] = list->last[i];
+        if(list->indexable){
+            // header spans are positions in the new list, rank[0] nodes stay behind
+            nodeSpan_i32(right->header)[i] = rank[i] + nodeSpan_i32(update[i])[i] - rank[0];
+            nodeSpan_i32(update[i])[i] = rank[0] - rank[i];
+        }
+        setLink_i32(update[i], i, NULL);
+        list->last[i] = update[i];
+    }
+    Node_i32 * first = right->header->forward[0].next;
+    if(right->backlinks && first) *nodeBack_i32(right, first) = right->header;
+    uint32_t kept = rank[0];
+    if(!list->indexable){
+        // without spans count whichever side runs out first
+        Node_i32 * a = list->header->forward[0].next;
+        Node_i32 * b = first;
+        uint32_t steps = 0;
+        while(a && b){
+            a = a->forward[0].next;
+            b = b->forward[0].next;
+            steps++;
+        }
+        kept = a ? list->size - steps : steps;
+    }
+    right->size = list->size - kept;
+    list->size = kept;
+    coalesce_i32(list);
+    coalesce_i32(right);
+    list->version++;
+    return right;
+}
+
+static void concat_i32(struct SkipList_i32_t * left, struct SkipList_i32_t * right) {
+    if(left->shared) detach_i32(left);
+    if(right->shared) detach_i32(right);
+    assert(left->is_map == right->is_map && left->indexable == right->indexable && left->backlinks == right->backlinks);
+    assert(left->owns_values == right->owns_values); // a clone cannot take an owner's values
+    assert(skipListAllocator_equal(&left->allocator, &right->allocator));
+    assert(!left->arena == !right->arena);
+    assert(right->max_level <= left->max_height); // the towers of right have to fit under the header of left
+    Node_i32 * first = right->header->forward[0].next;
+    assert(!first || !left->size || left->last[0]->key < first->key);
+    uint32_t height = left->max_level > right->max_level ? left->max_level : right->max_level;
+    Node_i32 * tail0 = left->last[0];
+    for(uint32_t i = 0; i < height; i++){
+        Node_i32 * tail = left->last[i];
+        if(left->indexable){
+            // levels above max_level carry stale header spans
+            if(i >= left->max_level) nodeSpan_i32(tail)[i] = left->size;
+            nodeSpan_i32(tail)[i] += i < right->max_level ? nodeSpan_i32(right->header)[i] : right->size;
+        }
+        if(i < right->max_level && right->header->forward[i].next){
+            tail->forward[i] = right->header->forward[i];
+            left->last[i] = right->last[i];
+        }
+    }
+    if(left->backlinks && first) *nodeBack_i32(left, first) = tail0;
+    left->max_level = height;
+    left->size += right->size;
+    left->version++;
+    // only the header and the shell of right are left to free
+    releaseNode_i32(right, right->header);
+    if(!right->arena || right->arena == left->arena){
+        slabArena_destroy(right->arena);
+    }else if(right->arena->refs > 1){
+        // a split sibling still allocates from it, left keeps it alive instead
+        slabArena_hold(left->arena, right->arena);
+    }else{
+        slabArena_adopt(left->arena, right->arena);
+    }
+    SkipListAllocator allocator = right->allocator;
+    skipListAllocator_free(&allocator, right, listBytes_i32(right->max_height));
+}
+
+void skipList_i32_split(SkipList_i32 *list, int32_t key, SkipList_i32 **right)
+{
+    *right = split_i32(list, key);
+}
+
+void skipList_i32_concat(SkipList_i32 *left, SkipList_i32 **right)
+{
+    if (!right || !*right) return;
+    concat_i32(left, *right);
+    *right = NULL;
+}
+
+void skipMap_i32_split(SkipMap_i32 *sm, int32_t key, SkipMap_i32 **right)
+{
+    *right = split_i32(sm, key);
+}
+
+void skipMap_i32_concat(SkipMap_i32 *left, SkipMap_i32 **right)
+{
+    if (!right || !*right) return;
+    concat_i32(left, *right);
+    *right = NULL;
+}
+
+
+/*_______________________________________
+
+    int32 set algebra impl
+__________________________________________*/
+
+// results are arena backed like buildFromSorted and keep the index and back
+// link options of the left operand
+static struct SkipList_i32_t * createResult_i32(const struct SkipList_i32_t * like) {
+    uint32_t flags = SKIPLIST_ARENA | (like->indexable ? SKIPLIST_INDEXABLE : 0) | (like->backlinks ? SKIPLIST_BACKLINKS : 0);
+    return createShaped_i32(false, flags, NULL, like->max_height, like->p_lo, like->p_hi);
+}
+
+// probing each key of small through a finger costs O(log gap) per key and
+// beats walking every node of large once the sizes are far enough apart
+static inline bool skewed_i32(const struct SkipList_i32_t * small, const struct SkipList_i32_t * large) {
+    return large->size / SL_GALLOP_RATIO > small->size;
+}
+
+SkipList_i32 *skipList_i32_union(SkipList_i32 *a, SkipList_i32 *b)
+{
+    assert(!a->is_map && !b->is_map);
+    struct SkipList_i32_t * out = createResult_i32(a);
+    Builder_i32 builder;
+    builderInit_i32(&builder, out);
+    Node_i32 * x = a->header->forward[0].next;
+    Node_i32 * y = b->header->forward[0].next;
+    while(x || y){
+        if(!y || (x && x->key < y->key)){
+            builderAppend_i32(&builder, x->key);
+            x = x->forward[0].next;
+        }else{
+            builderAppend_i32(&builder, y->key);
+            if(x && x->key == y->key) x = x->forward[0].next;
+            y = y->forward[0].next;
+        }
+    }
+    builderFinish_i32(&builder);
+    return out;
+}
+
+SkipList_i32 *skipList_i32_intersect(SkipList_i32 *a, SkipList_i32 *b)
+{
+    assert(!a->is_map && !b->is_map);
+    struct SkipList_i32_t * out = createResult_i32(a);
+    Builder_i32 builder;
+    builderInit_i32(&builder, out);
+    struct SkipList_i32_t * small = a->size <= b->size ? a : b;
+    struct SkipList_i32_t * large = small == a ? b : a;
+    Node_i32 * x = small->header->forward[0].next;
+    if(skewed_i32(small, large)){
+        struct SkipListFinger_i32_t finger;
+        batchFinger_i32(&finger, large);
+        for(; x; x = x->forward[0].next){
+            if(fingerFind_i32(&finger, x->key)) builderAppend_i32(&builder, x->key);
+        }
+    }else{
+        Node_i32 * y = large->header->forward[0].next;
+        while(x && y){
+            if(x->key < y->key){
+                x = x->forward[0].next;
+            }else if(y->key < x->key){
+                y = y->forward[0].next;
+            }else{
+                builderAppend_i32(&builder, x->key);
+                x = x->forward[0].next;
+                y = y->forward[0].next;
+            }
+        }
+    }
+    builderFinish_i32(&builder);
+    return out;
+}
+
+SkipList_i32 *skipList_i32_difference(SkipList_i32 *a, SkipList_i32 *b)
+{
+    assert(!a->is_map && !b->is_map);
+    struct SkipList_i32_t * out = createResult_i32(a);
+    Builder_i32 builder;
+    builderInit_i32(&builder, out);
+    Node_i32 * x = a->header->forward[0].next;
+    if(skewed_i32(a, b)){
+        struct SkipListFinger_i32_t finger;
+        batchFinger_i32(&finger, b);
+        for(; x; x = x->forward[0].next){
+            if(!fingerFind_i32(&finger, x->key)) builderAppend_i32(&builder, x->key);
+        }
+    }else{
+        Node_i32 * y = b->header->forward[0].next;
+        for(; x; x = x->forward[0].next){
+            while(y && y->key < x->key){
+                y = y->forward[0].next;
+            }
+            if(!y || y->key != x->key) builderAppend_i32(&builder, x->key);
+        }
+    }
+    builderFinish_i32(&builder);
+    return out;
+}
+
+bool skipList_i32_isSubset(SkipList_i32 *a, SkipList_i32 *b)
+{
+    if(a->size > b->size) return false;
+    Node_i32 * x = a->header->forward[0].next;
+    if(skewed_i32(a, b)){
+        struct SkipListFinger_i32_t finger;
+        batchFinger_i32(&finger, b);
+        for(; x; x = x->forward[0].next){
+            if(!fingerFind_i32(&finger, x->key)) return false;
+        }
+        return true;
+    }
+    Node_i32 * y = b->header->forward[0].next;
+    for(; x; x = x->forward[0].next){
+        while(y && y->key < x->key){
+            y = y->forward[0].next;
+        }
+        if(!y || y->key != x->key) return false;
+    }
+    return true;
+}
+
+uint32_t skipList_i32_unionInPlace(SkipList_i32 *a, SkipList_i32 *b)
+{
+    if(a->shared) detach_i32(a);
+    assert(!a->is_map && !b->is_map);
+    if(a == b) return 0;
+    uint32_t before = a->size;
+    struct SkipListFinger_i32_t finger;
+    batchFinger_i32(&finger, a);
+    for(Node_i32 * y = b->header->forward[0].next; y; y = y->forward[0].next){
+        fingerInsert_i32(&finger, y->key, NULL);
+    }
+    if(a->rebalance_step) rebalanceStep_i32(a, a->size - before);
+    return a->size - before;
+}
+
+uint32_t skipList_i32_intersectInPlace(SkipList_i32 *a, SkipList_i32 *b)
+{
+    if(a->shared) detach_i32(a);
+    assert(!a->is_map && !b->is_map);
+    if(a == b) return 0;
+    uint32_t before = a->size;
+    bool probe = skewed_i32(a, b);
+    struct SkipListFinger_i32_t drop, seek;
+    batchFinger_i32(&drop, a);
+    batchFinger_i32(&seek, b);
+    Node_i32 * x = a->header->forward[0].next;
+    Node_i32 * y = b->header->forward[0].next;
+    while(x){
+        Node_i32 * next = x->forward[0].next;
+        bool keep;
+        if(probe){
+            keep = fingerFind_i32(&seek, x->key) != NULL;
+        }else{
+            while(y && y->key < x->key){
+                y = y->forward[0].next;
+            }
+            keep = y && y->key == x->key;
+        }
+        if(!keep) fingerRemove_i32(&drop, x->key);
+        x = next;
+    }
+    if(a->rebalance_step) rebalanceStep_i32(a, before - a->size);
+    return before - a->size;
+}
+
+uint32_t skipList_i32_differenceInPlace(SkipList_i32 *a, SkipList_i32 *b)
+{
+    if(a->shared) detach_i32(a);
+    assert(!a->is_map && !b->is_map);
+    uint32_t before = a->size;
+    int32_t key;
+    if(a == b){
+        while(skipList_i32_pop(a, &key));
+        return before;
+    }
+    struct SkipListFinger_i32_t drop;
+    batchFinger_i32(&drop, a);
+    if(skewed_i32(a, b)){
+        struct SkipListFinger_i32_t seek;
+        batchFinger_i32(&seek, b);
+        Node_i32 * x = a->header->forward[0].next;
+        while(x){
+            Node_i32 * next = x->forward[0].next;
+            if(fingerFind_i32(&seek, x->key)) fingerRemove_i32(&drop, x->key);
+            x = next;
+        }
+    }else{
+        for(Node_i32 * y = b->header->forward[0].next; y; y = y->forward[0].next){
+            fingerRemove_i32(&drop, y->key);
+        }
+    }
+    if(a->rebalance_step) rebalanceStep_i32(a, before - a->size);
+    return before - a->size;
+}
+
+
+/*_______________________________________
+
+    int32 clone and snapshot impl
+__________________________________________*/
+
+// copies every node of src behind the empty header of dst keeping tower
+// heights, so links and spans line up one to one and nothing is recomputed
+static void copyNodes_i32(struct SkipList_i32_t * dst, const struct SkipList_i32_t * src) {
+    if(dst->indexable){
+        memcpy(nodeSpan_i32(dst->header), nodeSpan_i32(src->header), dst->max_height * sizeof(uint32_t));
+    }
+    for(uint32_t i = 0; i < dst->max_height; i++){
+        dst->last[i] = dst->header;
+    }
+    for(Node_i32 * x = src->header->forward[0].next; x; x = x->forward[0].next){
+        Node_i32 * y = getNode_i32(dst, x->height, x->key);
+        if(dst->is_map) *nodeData_i32(y) = *nodeData_i32(x);
+        if(dst->indexable) memcpy(nodeSpan_i32(y), nodeSpan_i32(x), x->height * sizeof(uint32_t));
+        if(dst->backlinks) *nodeBack_i32(dst, y) = dst->last[0];
+        for(uint32_t i = 0; i < y->height; i++){
+            setLink_i32(dst->last[i], i, y);
+            dst->last[i] = y;
+        }
+    }
+    dst->size = src->size;
+    dst->max_level = src->max_level;
+    dst->version++;
+}
+
+static void detach_i32(struct SkipList_i32_t * list) {
+    assert(!list->read_only); // snapshots cannot be written
+    if(atomic_load(&list->shared->refs) == 1){
+        // every snapshot is gone, the nodes are ours again. Only this list
+        // takes snapshots of itself so the count cannot grow behind our back
+        free(list->shared);
+        list->shared = NULL;
+        return;
+    }
+    struct SkipList_i32_t old = *list;
+    list->arena = old.arena ? slabArena_create(list->max_height, &list->allocator) : NULL;
+    list->header = getNode_i32(list, list->max_height, 0);
+    list->shared = NULL;
+    copyNodes_i32(list, &old);
+    if(atomic_fetch_sub(&old.shared->refs, 1) == 1){
+        // the last snapshot was destroyed while we copied
+        free(old.shared);
+        releaseAllNodes_i32(&old, false);
+    }
+}
+
+static struct SkipList_i32_t * clone_i32(struct SkipList_i32_t * list) {
+    uint32_t flags = SKIPLIST_ARENA | (list->indexable ? SKIPLIST_INDEXABLE : 0) | (list->backlinks ? SKIPLIST_BACKLINKS : 0);
+    struct SkipList_i32_t * copy = createShaped_i32(list->is_map, flags, NULL, list->max_height, list->p_lo, list->p_hi);
+    copy->rebalance_step = list->rebalance_step;
+    // the values stay with the source, a clone never frees them
+    copy->owns_values = false;
+    copyNodes_i32(copy, list);
+    return copy;
+}
+
+static struct SkipList_i32_t * snapshot_i32(struct SkipList_i32_t * list) {
+    // a bulk free allocator would take the shared nodes with whichever list goes first
+    assert(!list->read_only && !skipListAllocator_hasBulkFree(&list->allocator));
+    if(!list->shared){
+        list->shared = (SharedNodes_i32 *)malloc(sizeof(SharedNodes_i32));
+        assert(list->shared);
+        atomic_init(&list->shared->refs, 1);
+        atomic_init(&list->shared->free_values, false);
+    }
+    atomic_fetch_add(&list->shared->refs, 1);
+    struct SkipList_i32_t * snap = (struct SkipList_i32_t *)skipListAllocator_alloc(&list->allocator, listBytes_i32(list->max_height));
+    assert(snap);
+    memcpy(snap, list, listBytes_i32(list->max_height));
+    snap->read_only = true;
+    snap->owns_values = false;
+    return snap;
+}
+
+SkipList_i32 *skipList_i32_clone(SkipList_i32 *list)
+{
+    return clone_i32(list);
+}
+
+SkipMap_i32 *skipMap_i32_clone(SkipMap_i32 *sm)
+{
+    return clone_i32(sm);
+}
+
+SkipList_i32 *skipList_i32_snapshot(SkipList_i32 *list)
+{
+    return snapshot_i32(list);
+}
+
+SkipMap_i32 *skipMap_i32_snapshot(SkipMap_i32 *sm)
+{
+    return snapshot_i32(sm);
+}
+
+
+/*_______________________________________
+
+    int32 options impl
+__________________________________________*/
+
+static struct SkipList_i32_t * createWithOptions_i32(bool is_map, const SkipListOptions * options) {
+    static const SkipListOptions defaults = {0};
+    if(!options) options = &defaults;
+    uint32_t max_height = options->max_height ? options->max_height : SL_MAX_HEIGHT;
+    double p = options->p ? options->p : P;
+    assert(max_height <= SL_MAX_HEIGHT && p > 0 && p < 1);
+    assert(options->growth == SKIPLIST_GROWTH_ADAPTIVE || options->growth == SKIPLIST_GROWTH_FIXED);
+    // the adaptive curve never drops below p, a p above its usual ceiling pins it
+    double p_hi = (options->growth == SKIPLIST_GROWTH_FIXED || p > P_Upper) ? p : P_Upper;
+    struct SkipList_i32_t * sl = createShaped_i32(is_map, options->flags, options->allocator, max_height, p, p_hi);
+    sl->rebalance_step = options->rebalance_step;
+    if(options->seed) skipListRandom_seed(&sl->rng, options->seed);
+    return sl;
+}
+
+SkipList_i32 *skipList_i32_create_with_options(const SkipListOptions *options)
+{
+    return createWithOptions_i32(false, options);
+}
+
+SkipMap_i32 *skipMap_i32_create_with_options(const SkipListOptions *options)
+{
+    return createWithOptions_i32(true, options);
+}
+
+
+/*_______________________________________
+
+    int32 rebalance impl
+__________________________________________*/
+
+// the deterministic fanout matching the base promotion probability of the
+// list, SL_BUILD_FANOUT for the default P
+static inline uint32_t rebalanceFanout_i32(const struct SkipList_i32_t * list) {
+    uint32_t fanout = (uint32_t)(1.0 / list->p_lo + 0.5);
+    return fanout < 2 ? 2 : fanout;
+}
+
+// moves x, the node after update[0] at rank r, into a tower of the given
+// height. Levels both towers share keep their links and spans, a dropped level
+// hands link and span back to the predecessor, a new level splits its span at r
+static Node_i32 * reheight_i32(struct SkipList_i32_t * list, Node_i32 ** update, uint32_t * rank, Node_i32 * x, uint32_t height, uint32_t r) {
+    if(height > list->max_level){
+        for(uint32_t i = list->max_level; i < height; i++){
+            update[i] = list->header;
+            rank[i] = 0;
+            if(list->indexable) nodeSpan_i32(list->header)[i] = list->size;
+        }
+        list->max_level = height;
+    }
+    Node_i32 * y = getNode_i32(list, height, x->key);
+    if(list->is_map) *nodeData_i32(y) = *nodeData_i32(x);
+    if(list->backlinks){
+        *nodeBack_i32(list, y) = *nodeBack_i32(list, x);
+        if(x->forward[0].next) *nodeBack_i32(list, x->forward[0].next) = y;
+    }
+    uint32_t top = height > x->height ? height : x->height;
+    for(uint32_t i = 0; i < top; i++){
+        Node_i32 * pred = update[i];
+        if(i >= height){
+            pred->forward[i] = x->forward[i];
+            if(list->indexable) nodeSpan_i32(pred)[i] += nodeSpan_i32(x)[i];
+            if(!pred->forward[i].next) list->last[i] = pred;
+            continue;
+        }
+        if(i < x->height){
+            y->forward[i] = x->forward[i];
+            if(list->indexable) nodeSpan_i32(y)[i] = nodeSpan_i32(x)[i];
+        }else{
+            y->forward[i] = pred->forward[i];
+            if(list->indexable){
+                nodeSpan_i32(y)[i] = nodeSpan_i32(pred)[i] - (r - rank[i]);
+                nodeSpan_i32(pred)[i] = r - rank[i];
+            }
+        }
+        setLink_i32(pred, i, y);
+        if(!y->forward[i].next) list->last[i] = y;
+    }
+    releaseNode_i32(list, x);
+    return y;
+}
+
+// gives up to budget nodes after update[0] the height a bulk build gives the
+// n-th node, count holds n of the last node visited. Towers already at that
+// height stay where they are, returns how many changed
+static uint32_t relevel_i32(struct SkipList_i32_t * list, Node_i32 ** update, uint32_t * rank, uint32_t * count, uint32_t budget) {
+    uint32_t fanout = rebalanceFanout_i32(list);
+    uint32_t changed = 0;
+    Node_i32 * x;
+    while(budget-- && (x = update[0]->forward[0].next)){
+        uint32_t r = rank[0] + 1;
+        uint32_t height = buildHeight_i32(++*count, fanout, list->max_height);
+        if(height != x->height){
+            x = reheight_i32(list, update, rank, x, height, r);
+            changed++;
+        }
+        for(uint32_t i = 0; i < height; i++){
+            update[i] = x;
+            rank[i] = r;
+        }
+    }
+    if(changed){
+        coalesce_i32(list);
+        list->version++;
+    }
+    return changed;
+}
+
+static uint32_t rebalance_i32(struct SkipList_i32_t * list) {
+    if(list->shared) detach_i32(list);
+    Node_i32 * update[SL_MAX_HEIGHT];
+    uint32_t rank[SL_MAX_HEIGHT];
+    for(uint32_t i = 0; i < list->max_height; i++){
+        update[i] = list->header;
+        rank[i] = 0;
+    }
+    uint32_t count = 0;
+    uint32_t changed = relevel_i32(list, update, rank, &count, UINT32_MAX);
+    // a running incremental pass has nothing left to do
+    list->rebalance_size = list->size;
+    list->rebalance_pos = 0;
+    return changed;
+}
+
+// one bounded step of the incremental pass. A pass starts once the size has
+// doubled or halved since the last one ended and every step resumes after the
+// last key it visited, one descent plus rebalance_step towers per change
+static void rebalanceStep_i32(struct SkipList_i32_t * list, uint32_t changes) {
+    bool resume = list->rebalance_pos != 0;
+    if(!resume && list->size < 2 * (uint64_t)list->rebalance_size && list->size > list->rebalance_size / 2){
+        return;
+    }
+    Node_i32 * update[SL_MAX_HEIGHT];
+    uint32_t rank[SL_MAX_HEIGHT];
+    Node_i32 * x = list->header;
+    uint32_t r = 0;
+    int32_t key = list->rebalance_key;
+    for(int i = list->max_height - 1; i >= 0; i--){
+        while(resume && (linkBefore_i32(x, i, key) || linkMatches_i32(x, i, key))){
+            if(list->indexable) r += nodeSpan_i32(x)[i];
+            x = x->forward[i].next;
+        }
+        update[i] = x;
+        rank[i] = r;
+    }
+    uint32_t count = list->rebalance_pos;
+    uint64_t budget = (uint64_t)list->rebalance_step * changes;
+    relevel_i32(list, update, rank, &count, budget > UINT32_MAX ? UINT32_MAX : (uint32_t)budget);
+    if(update[0]->forward[0].next){
+        list->rebalance_pos = count;
+        list->rebalance_key = update[0]->key;
+    }else{
+        list->rebalance_size = list->size;
+        list->rebalance_pos = 0;
+    }
+}
+
+uint32_t skipList_i32_rebalance(SkipList_i32 *list)
+{
+    return rebalance_i32(list);
+}
+
+uint32_t skipMap_i32_rebalance(SkipMap_i32 *sm)
+{
+    return rebalance_i32(sm);
+}
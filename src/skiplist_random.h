@@ -0,0 +1,104 @@
+/*
+ * SkipList Library
+ * Copyright (C) 2025  Andrew Pegg
+ *
+ * The SkipList Library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3 of the License only.
+ *
+ * The SkipList Library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <math.h>
+
+/*
+    Per list tower height generator (internal header)
+
+    every list owns a xorshift64* state, drawing a height costs one random word
+    and a few multiplies instead of a locked rand() per promotion, and a list
+    created with a seed always grows the same towers. The promotion probability
+    follows the same size^(-1/level) curve as before but is cached, pow only runs
+    again once the size leaves a band of +-1/8 around the size it was computed
+    for or the list gains a level
+*/
+
+typedef struct SkipListRandom_t {
+    uint64_t state;
+    double p;       // promotion probability for sizes in [from, until)
+    double cut;     // p scaled to the 2^53 range of a draw
+    uint32_t from;
+    uint32_t until;
+    uint32_t level; // max_level p was computed for
+}SkipListRandom;
+
+// splitmix64 finaliser, spreads seeds that differ in a few bits over the whole state
+static inline uint64_t skipListRandom_mix(uint64_t x){
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// seed 0 picks a fresh seed from the clock, a process wide counter and the
+// address of the state so lists created in the same second still differ
+static inline void skipListRandom_seed(SkipListRandom * r, uint64_t seed){
+    static atomic_uint_fast64_t created;
+    if(!seed){
+        seed = (uint64_t)time(NULL) ^ (uint64_t)(uintptr_t)r ^ skipListRandom_mix(atomic_fetch_add(&created, 1));
+    }
+    r->state = skipListRandom_mix(seed);
+    if(!r->state) r->state = 0x9E3779B97F4A7C15ull; // xorshift never leaves 0
+    r->from = 1;
+    r->until = 0; // empty band, the first draw computes p
+    r->level = 0;
+}
+
+static inline uint64_t skipListRandom_next(SkipListRandom * r){
+    uint64_t x = r->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    r->state = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+static inline void skipListRandom_refresh(SkipListRandom * r, uint32_t size, uint32_t level, double lo, double hi){
+    // a fixed p has no curve to follow
+    double p = lo < hi ? pow((double)(size ? size : 2), -1.0 / level) : lo;
+    if(p < lo) p = lo;
+    if(p > hi) p = hi;
+    r->p = p;
+    r->cut = p * 9007199254740992.0; // 2^53
+    r->from = size - size / 8;
+    r->until = size + size / 8 + 1;
+    r->level = level;
+}
+
+// height in [1, cap], promoted past level h with probability p^h. One draw u
+// is compared against p * 2^53, p^2 * 2^53, ... which is the same geometric
+// distribution as one coin per level. Only p = 1/2^k would reduce this to a
+// count of trailing zeros, and the dynamic p lies between lo and hi
+static inline uint32_t skipListRandom_level(SkipListRandom * r, uint32_t size, uint32_t max_level, uint32_t cap, double lo, double hi){
+    if(size < r->from || size >= r->until || max_level != r->level){
+        skipListRandom_refresh(r, size, max_level, lo, hi);
+    }
+    // the top 53 bits convert exactly and through the signed path, one instruction
+    double u = (double)(int64_t)(skipListRandom_next(r) >> 11);
+    double cut = r->cut;
+    uint32_t level = 1;
+    while(level < cap && u < cut){
+        level++;
+        cut *= r->p;
+    }
+    return level;
+}
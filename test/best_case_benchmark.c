@@ -133,6 +133,46 @@ void benchmark_ops(const char *label, FILE *csv, uint64_t ops) {
         min_r, max_r, median_r, mode_r, avg_r);
 }
 
+// the increasing order search above, one search per key vs a single
+// searchSorted over the whole key array
+void benchmark_sorted_search(FILE *csv, uint64_t ops) {
+    long single_times[REPEATS], sorted_times[REPEATS];
+    uint64_t *keys = malloc(sizeof(uint64_t) * ops);
+    bool *results = malloc(sizeof(bool) * ops);
+    volatile uint64_t found = 0;
+    for (uint64_t i = 0; i < ops; i++){
+        keys[i] = i;
+    }
+    SkipList_u64 *sl = skipList_u64_create();
+    for (long long i = ops-1; i >= 0; i--){
+        skipList_u64_insert(sl, keys[i]);
+    }
+
+    for (int r = 0; r < REPEATS; r++) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint64_t i = 0; i < ops; i++){
+            found += skipList_u64_search(sl, keys[i]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        single_times[r] = time_diff_ns(start, end);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        found += skipList_u64_searchSorted(sl, keys, (uint32_t)ops, results);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        sorted_times[r] = time_diff_ns(start, end);
+    }
+    skipList_u64_destroy(&sl);
+    free(results);
+    free(keys);
+
+    double single_ns = compute_median(single_times, REPEATS) / ops;
+    double sorted_ns = compute_median(sorted_times, REPEATS) / ops;
+    fprintf(csv, "%lu,%.2f,%.2f\n", ops, single_ns, sorted_ns);
+    printf("\n=== searchSorted (%lu ops) ===\n", ops);
+    printf("single: %.2f ns/op, searchSorted: %.2f ns/op, speedup: %.2fx\n", single_ns, sorted_ns, single_ns / sorted_ns);
+}
+
 int main(void) {
     srand(time(NULL));
 
@@ -156,5 +196,16 @@ int main(void) {
 
     fclose(csv);
     printf("\n✅ Benchmark results saved to bestcase_benchmark_results.csv\n");
+
+    csv = fopen("sorted_search_results.csv", "w");
+    if (!csv) {
+        perror("fopen");
+        return 1;
+    }
+    fprintf(csv, "Ops,Single_ns_per_op,SearchSorted_ns_per_op\n");
+    for (size_t i = 0; i < n_sizes; i++)
+        benchmark_sorted_search(csv, test_sizes[i]);
+    fclose(csv);
+    printf("\n✅ Benchmark results saved to sorted_search_results.csv\n");
     return 0;
 }
\ No newline at end of file
@@ -15,6 +15,30 @@
 
 
 
+// lets the same driver time SkipList_u64 and SkipListBlock_u64
+typedef struct {
+    void * (*create)(void);
+    bool   (*insert)(void *list, uint64_t id);
+    bool   (*search)(void *list, uint64_t id);
+    void   (*remove)(void *list, uint64_t id);
+    void   (*destroy)(void *list);
+} ListOps;
+
+static void * u64_create(void) { return skipList_u64_create(); }
+static bool u64_insert(void *list, uint64_t id) { return skipList_u64_insert(list, id); }
+static bool u64_search(void *list, uint64_t id) { return skipList_u64_search(list, id); }
+static void u64_remove(void *list, uint64_t id) { skipList_u64_remove(list, id); }
+static void u64_destroy(void *list) { SkipList_u64 *sl = list; skipList_u64_destroy(&sl); }
+
+static void * block_create(void) { return skipListBlock_u64_create(); }
+static bool block_insert(void *list, uint64_t id) { return skipListBlock_u64_insert(list, id); }
+static bool block_search(void *list, uint64_t id) { return skipListBlock_u64_search(list, id); }
+static void block_remove(void *list, uint64_t id) { skipListBlock_u64_remove(list, id); }
+static void block_destroy(void *list) { SkipListBlock_u64 *sl = list; skipListBlock_u64_destroy(&sl); }
+
+static const ListOps u64_ops = { u64_create, u64_insert, u64_search, u64_remove, u64_destroy };
+static const ListOps block_ops = { block_create, block_insert, block_search, block_remove, block_destroy };
+
 static inline long time_diff_ns(struct timespec start, struct timespec end) {
     return (end.tv_sec - start.tv_sec) * NS_PER_SEC + (end.tv_nsec - start.tv_nsec);
 }
@@ -53,7 +77,7 @@ void shuffle(uint64_t *arr, uint64_t n) {
     }
 }
 
-void benchmark_ops(const char *label, FILE *csv, uint64_t ops) {
+void benchmark_ops(const char *label, const ListOps *list_ops, FILE *csv, uint64_t ops) {
     long insert_times[REPEATS], search_times[REPEATS], remove_times[REPEATS];
     volatile uint64_t removed_count = 0;
     volatile uint64_t add_count = 0;
@@ -66,13 +90,13 @@ void benchmark_ops(const char *label, FILE *csv, uint64_t ops) {
     for (int r = 0; r < REPEATS; r++) {
         printf("ops: %lu, repeat: %d\n", ops,r);
         shuffle(keys, ops);
-        SkipList_u64 *sl = skipList_u64_create();
+        void *sl = list_ops->create();
         struct timespec start, end;
 
         // ===== SkipList insert =====
         clock_gettime(CLOCK_MONOTONIC, &start);
         for (uint64_t i = 0; i < ops; i++){
-            bool res = skipList_u64_insert(sl, keys[i]);
+            bool res = list_ops->insert(sl, keys[i]);
             add_count++;
         }
         clock_gettime(CLOCK_MONOTONIC, &end);
@@ -81,7 +105,7 @@ void benchmark_ops(const char *label, FILE *csv, uint64_t ops) {
         // ===== SkipList search =====
         clock_gettime(CLOCK_MONOTONIC, &start);
         for (uint64_t i = 0; i < ops; i++){
-            bool res = skipList_u64_search(sl, keys[i]);
+            bool res = list_ops->search(sl, keys[i]);
             search_count++;
         }
         clock_gettime(CLOCK_MONOTONIC, &end);
@@ -90,13 +114,13 @@ void benchmark_ops(const char *label, FILE *csv, uint64_t ops) {
         // ===== SkipList remove =====
         clock_gettime(CLOCK_MONOTONIC, &start);
         for (uint64_t i = 0; i < ops; i++){
-            skipList_u64_remove(sl, keys[i]);
+            list_ops->remove(sl, keys[i]);
             removed_count++;
         }
         clock_gettime(CLOCK_MONOTONIC, &end);
         remove_times[r] = time_diff_ns(start, end);
 
-        skipList_u64_destroy(&sl);
+        list_ops->destroy(sl);
     }
 
     free(keys);
@@ -150,28 +174,92 @@ void benchmark_ops(const char *label, FILE *csv, uint64_t ops) {
     printf("Insert Count: %lu,Search count: %lu, Remove Count: %lu\n", add_count, search_count, removed_count);
 }
 
+// random probes against a populated list, a loop of single searches vs
+// searchMany over batches of SEARCH_BATCH unrelated keys
+#define SEARCH_BATCH 128
+
+void benchmark_search_many(FILE *csv, uint64_t ops) {
+    long single_times[REPEATS], many_times[REPEATS];
+    uint64_t *keys = malloc(sizeof(uint64_t) * ops);
+    bool *results = malloc(sizeof(bool) * SEARCH_BATCH);
+    volatile uint64_t found = 0;
+    for (uint64_t i = 0; i < ops; i++){
+        keys[i] = i;
+    }
+    shuffle(keys, ops);
+    SkipList_u64 *sl = skipList_u64_create();
+    for (uint64_t i = 0; i < ops; i++){
+        skipList_u64_insert(sl, keys[i]);
+    }
+
+    for (int r = 0; r < REPEATS; r++) {
+        struct timespec start, end;
+        shuffle(keys, ops);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint64_t i = 0; i < ops; i++){
+            found += skipList_u64_search(sl, keys[i]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        single_times[r] = time_diff_ns(start, end);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint64_t i = 0; i < ops; i += SEARCH_BATCH){
+            uint32_t n = ops - i < SEARCH_BATCH ? (uint32_t)(ops - i) : SEARCH_BATCH;
+            found += skipList_u64_searchMany(sl, keys + i, n, results);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        many_times[r] = time_diff_ns(start, end);
+    }
+    skipList_u64_destroy(&sl);
+    free(results);
+    free(keys);
+
+    double single_ns = compute_median(single_times, REPEATS) / ops;
+    double many_ns = compute_median(many_times, REPEATS) / ops;
+    fprintf(csv, "%lu,%.2f,%.2f\n", ops, single_ns, many_ns);
+    printf("\n=== searchMany (%lu ops) ===\n", ops);
+    printf("single: %.2f ns/op, searchMany: %.2f ns/op, speedup: %.2fx\n", single_ns, many_ns, single_ns / many_ns);
+}
+
 int main(void) {
     srand(time(NULL));
 
     uint64_t test_sizes[] = {100, 500, 1000, 5000, 10000, 50000, 100000,500000,1000000,5000000,10000000};
     size_t n_sizes = sizeof(test_sizes) / sizeof(test_sizes[0]);
 
-    FILE *csv = fopen("benchmark_results.csv", "w");
+    const char *labels[] = {"SkipList_u64", "SkipListBlock_u64"};
+    const ListOps *ops[] = {&u64_ops, &block_ops};
+    const char *files[] = {"benchmark_results.csv", "block_benchmark_results.csv"};
+
+    for (size_t l = 0; l < 2; l++) {
+        FILE *csv = fopen(files[l], "w");
+        if (!csv) {
+            perror("fopen");
+            return 1;
+        }
+
+        fprintf(csv,
+            "Ops,"
+            "Insert_min,Insert_max,Insert_median,Insert_mode,Insert_avg,"
+            "Search_min,Search_max,Search_median,Search_mode,Search_avg,"
+            "Remove_min,Remove_max,Remove_median,Remove_mode,Remove_avg\n");
+
+        for (size_t i = 0; i < n_sizes; i++)
+            benchmark_ops(labels[l], ops[l], csv, test_sizes[i]);
+
+        fclose(csv);
+        printf("\n✅ Benchmark results saved to %s\n", files[l]);
+    }
+
+    FILE *csv = fopen("search_many_results.csv", "w");
     if (!csv) {
         perror("fopen");
         return 1;
     }
-
-    fprintf(csv,
-        "Ops,"
-        "Insert_min,Insert_max,Insert_median,Insert_mode,Insert_avg,"
-        "Search_min,Search_max,Search_median,Search_mode,Search_avg,"
-        "Remove_min,Remove_max,Remove_median,Remove_mode,Remove_avg\n");
-
+    fprintf(csv, "Ops,Single_ns_per_op,SearchMany_ns_per_op\n");
     for (size_t i = 0; i < n_sizes; i++)
-        benchmark_ops("SkipList_u64", csv, test_sizes[i]);
-
+        benchmark_search_many(csv, test_sizes[i]);
     fclose(csv);
-    printf("\n✅ Benchmark results saved to benchmark_results.csv\n");
+    printf("\n✅ Benchmark results saved to search_many_results.csv\n");
     return 0;
-}
\ No newline at end of file
+}
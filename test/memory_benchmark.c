@@ -0,0 +1,76 @@
+#include <skiplist.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#define SEED 42
+
+// counts the bytes the lists request from the allocator
+typedef struct {
+    long long live_bytes;
+    long long peak_bytes;
+} MemCtx;
+
+static void * mem_alloc(void * ctx, size_t size) {
+    MemCtx * m = ctx;
+    m->live_bytes += size;
+    if (m->live_bytes > m->peak_bytes) m->peak_bytes = m->live_bytes;
+    return malloc(size);
+}
+
+static void mem_free(void * ctx, void * ptr, size_t size) {
+    MemCtx * m = ctx;
+    m->live_bytes -= size;
+    free(ptr);
+}
+
+#define MEASURE(T, KT)                                                              \
+    static void measure_##T(FILE *csv, uint64_t n) {                                \
+        MemCtx set_ctx = {0}, map_ctx = {0};                                        \
+        SkipListAllocator set_a = { mem_alloc, mem_free, NULL, &set_ctx };          \
+        SkipListAllocator map_a = { mem_alloc, mem_free, NULL, &map_ctx };          \
+        /* same seed for both so the towers come out identical */                  \
+        SkipListOptions set_o = { .seed = SEED, .allocator = &set_a };              \
+        SkipListOptions map_o = { .seed = SEED, .allocator = &map_a };              \
+        SkipList_##T *sl = skipList_##T##_create_with_options(&set_o);              \
+        SkipMap_##T *sm = skipMap_##T##_create_with_options(&map_o);                \
+        for (uint64_t i = 0; i < n; i++) skipList_##T##_insert(sl, (KT)i);          \
+        for (uint64_t i = 0; i < n; i++) skipMap_##T##_put(sm, (KT)i, NULL);        \
+        double set_b = (double)set_ctx.live_bytes / n;                              \
+        double map_b = (double)map_ctx.live_bytes / n;                              \
+        skipList_##T##_destroy(&sl);                                                \
+        skipMap_##T##_destroy(&sm);                                                 \
+        printf("%-4s n=%-10lu set=%6.2f B/key  map=%6.2f B/key  saved=%6.2f B/key (%.1f MB)\n", \
+               #T, n, set_b, map_b, map_b - set_b, (map_b - set_b) * n / (1024.0 * 1024.0)); \
+        fprintf(csv, "%s,%lu,%.2f,%.2f\n", #T, n, set_b, map_b);                   \
+    }
+
+MEASURE(i32, int32_t)
+MEASURE(u32, uint32_t)
+MEASURE(i64, int64_t)
+MEASURE(u64, uint64_t)
+
+int main(void) {
+    uint64_t test_sizes[] = {1000, 10000, 100000, 1000000, 10000000};
+    size_t n_sizes = sizeof(test_sizes) / sizeof(test_sizes[0]);
+
+    FILE *csv = fopen("memory_results.csv", "w");
+    if (!csv) {
+        perror("fopen");
+        return 1;
+    }
+    fprintf(csv, "Type,Keys,Set_bytes_per_key,Map_bytes_per_key\n");
+
+    // the map node is the set node plus its value word, i.e. the layout every
+    // list used before set nodes dropped the data pointer
+    for (size_t i = 0; i < n_sizes; i++) {
+        measure_i32(csv, test_sizes[i]);
+        measure_u32(csv, test_sizes[i]);
+        measure_i64(csv, test_sizes[i]);
+        measure_u64(csv, test_sizes[i]);
+    }
+
+    fclose(csv);
+    printf("\n✅ Memory results saved to memory_results.csv\n");
+    return 0;
+}
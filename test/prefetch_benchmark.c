@@ -0,0 +1,96 @@
+#define _POSIX_C_SOURCE 200809L
+// ablation for the u64 descent kernels, the source is pulled in directly so
+// both kernels can be timed against the same list in one binary
+#include "skiplist_u64.c"
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#define REPEATS 5
+#define NS_PER_SEC 1000000000L
+
+static inline long time_diff_ns(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * NS_PER_SEC + (end.tv_nsec - start.tv_nsec);
+}
+
+static int cmp_long(const void *a, const void *b) {
+    long x = *(const long *)a, y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+static double compute_median(long *vals, int n) {
+    qsort(vals, n, sizeof(long), cmp_long);
+    if (n % 2 == 0) return (vals[n/2 - 1] + vals[n/2]) / 2.0;
+    return vals[n/2];
+}
+
+static void shuffle(uint64_t *arr, uint64_t n) {
+    for (uint64_t i = n - 1; i > 0; i--) {
+        uint64_t j = rand() % (i + 1);
+        uint64_t tmp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = tmp;
+    }
+}
+
+static long time_kernel(SkipList_u64 *sl, const uint64_t *keys, uint64_t ops, bool prefetch) {
+    struct timespec start, end;
+    uint64_t found = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (prefetch) {
+        for (uint64_t i = 0; i < ops; i++) found += searchDescentPrefetch_u64(sl, keys[i]);
+    } else {
+        for (uint64_t i = 0; i < ops; i++) found += searchDescent_u64(sl, keys[i]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (found != ops) {
+        fprintf(stderr, "kernel missed %lu keys\n", ops - found);
+        exit(1);
+    }
+    return time_diff_ns(start, end);
+}
+
+static void benchmark_kernels(FILE *csv, uint64_t ops) {
+    long plain[REPEATS], prefetch[REPEATS];
+    uint64_t *keys = malloc(sizeof(uint64_t) * ops);
+    for (uint64_t i = 0; i < ops; i++) keys[i] = i;
+    shuffle(keys, ops);
+    SkipList_u64 *sl = skipList_u64_create();
+    for (uint64_t i = 0; i < ops; i++) skipList_u64_insert(sl, keys[i]);
+
+    // same list and key order for both, alternate so drift hits them equally
+    for (int r = 0; r < REPEATS; r++) {
+        shuffle(keys, ops);
+        plain[r] = time_kernel(sl, keys, ops, false);
+        prefetch[r] = time_kernel(sl, keys, ops, true);
+    }
+    skipList_u64_destroy(&sl);
+    free(keys);
+
+    double plain_ns = compute_median(plain, REPEATS) / ops;
+    double prefetch_ns = compute_median(prefetch, REPEATS) / ops;
+    printf("n=%-10lu plain=%8.1f ns/op  prefetch=%8.1f ns/op  speedup=%5.2fx\n",
+           ops, plain_ns, prefetch_ns, plain_ns / prefetch_ns);
+    fprintf(csv, "%lu,%.2f,%.2f\n", ops, plain_ns, prefetch_ns);
+}
+
+int main(void) {
+    srand(time(NULL));
+
+    uint64_t test_sizes[] = {100, 500, 1000, 5000, 10000, 50000, 100000,500000,1000000,5000000,10000000};
+    size_t n_sizes = sizeof(test_sizes) / sizeof(test_sizes[0]);
+
+    FILE *csv = fopen("prefetch_results.csv", "w");
+    if (!csv) {
+        perror("fopen");
+        return 1;
+    }
+    fprintf(csv, "Ops,Plain_ns_per_op,Prefetch_ns_per_op\n");
+
+    for (size_t i = 0; i < n_sizes; i++)
+        benchmark_kernels(csv, test_sizes[i]);
+
+    fclose(csv);
+    printf("\n✅ Prefetch results saved to prefetch_results.csv\n");
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <skiplist.h>
+#include <skiplist_generic.h>
+#include <skipmap_generic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_SIZE 5000
+
+// tracks every allocation so leaks or mismatched sizes show up as non zero counters
+typedef struct {
+    size_t allocs;
+    size_t frees;
+    long long live_bytes;
+} CountingCtx;
+
+static void * counting_alloc(void * ctx, size_t size) {
+    CountingCtx * c = ctx;
+    c->allocs++;
+    c->live_bytes += size;
+    return malloc(size);
+}
+
+static void counting_free(void * ctx, void * ptr, size_t size) {
+    CountingCtx * c = ctx;
+    c->frees++;
+    c->live_bytes -= size;
+    free(ptr);
+}
+
+// per request style arena, single objects are never freed
+typedef struct Block {
+    struct Block * next;
+} Block;
+
+typedef struct {
+    Block * blocks;
+    int released;
+} BumpCtx;
+
+static void * bump_alloc(void * ctx, size_t size) {
+    BumpCtx * b = ctx;
+    Block * blk = malloc(sizeof(Block) + size);
+    blk->next = b->blocks;
+    b->blocks = blk;
+    return blk + 1;
+}
+
+static void bump_free_all(void * ctx) {
+    BumpCtx * b = ctx;
+    while (b->blocks) {
+        Block * next = b->blocks->next;
+        free(b->blocks);
+        b->blocks = next;
+    }
+    b->released++;
+}
+
+static CountingCtx generic_counting = {0};
+static const SkipListAllocator generic_allocator = { counting_alloc, counting_free, NULL, &generic_counting };
+
+#define cmp_int_func(a,b) ((a > b) - (a < b))
+DEFINE_GENERIC_SKIPLIST_WITH_ALLOCATOR(SL_Counted, int, cmp_int_func, NO_OP, &generic_allocator)
+DEFINE_GENERIC_SKIPMAP_WITH_ALLOCATOR(SM_Counted, int, int, cmp_int_func, NO_OP, NO_OP, &generic_allocator)
+
+void test_allocator_i32() {
+    printf("test_allocator_i32()\n");
+    CountingCtx counting = {0};
+    SkipListAllocator a = { counting_alloc, counting_free, NULL, &counting };
+    SkipList_i32 * sl = skipList_i32_create_with_allocator(&a);
+    printf("[test_allocator_i32] inserting/removing through counting allocator\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_i32_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        skipList_i32_remove(sl, i);
+    }
+    int32_t p;
+    assert(skipList_i32_pop(sl, &p) && p == 1);
+    assert(counting.allocs > TEST_SIZE && counting.live_bytes > 0);
+    skipList_i32_destroy(&sl);
+    assert(counting.allocs == counting.frees && counting.live_bytes == 0);
+
+    printf("[test_allocator_i32] tearing a map down with free_all\n");
+    BumpCtx bump = {0};
+    SkipListAllocator b = { bump_alloc, NULL, bump_free_all, &bump };
+    SkipMap_i32 * sm = skipMap_i32_create_with_allocator(&b);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipMap_i32_put(sm, i, NULL));
+    }
+    assert(skipMap_i32_getSize(sm) == TEST_SIZE);
+    skipMap_i32_destroy(&sm);
+    assert(sm == NULL && bump.blocks == NULL && bump.released == 1);
+    printf("[test_allocator_i32] ✅\n");
+}
+
+void test_allocator_u32() {
+    printf("test_allocator_u32()\n");
+    CountingCtx counting = {0};
+    SkipListAllocator a = { counting_alloc, counting_free, NULL, &counting };
+    SkipList_u32 * sl = skipList_u32_create_with_allocator(&a);
+    printf("[test_allocator_u32] inserting/removing through counting allocator\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_u32_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        skipList_u32_remove(sl, i);
+    }
+    uint32_t p;
+    assert(skipList_u32_pop(sl, &p) && p == 1);
+    assert(counting.allocs > TEST_SIZE && counting.live_bytes > 0);
+    skipList_u32_destroy(&sl);
+    assert(counting.allocs == counting.frees && counting.live_bytes == 0);
+
+    printf("[test_allocator_u32] tearing a map down with free_all\n");
+    BumpCtx bump = {0};
+    SkipListAllocator b = { bump_alloc, NULL, bump_free_all, &bump };
+    SkipMap_u32 * sm = skipMap_u32_create_with_allocator(&b);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipMap_u32_put(sm, i, NULL));
+    }
+    assert(skipMap_u32_getSize(sm) == TEST_SIZE);
+    skipMap_u32_destroy(&sm);
+    assert(sm == NULL && bump.blocks == NULL && bump.released == 1);
+    printf("[test_allocator_u32] ✅\n");
+}
+
+void test_allocator_i64() {
+    printf("test_allocator_i64()\n");
+    CountingCtx counting = {0};
+    SkipListAllocator a = { counting_alloc, counting_free, NULL, &counting };
+    SkipList_i64 * sl = skipList_i64_create_with_allocator(&a);
+    printf("[test_allocator_i64] inserting/removing through counting allocator\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_i64_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        skipList_i64_remove(sl, i);
+    }
+    int64_t p;
+    assert(skipList_i64_pop(sl, &p) && p == 1);
+    assert(counting.allocs > TEST_SIZE && counting.live_bytes > 0);
+    skipList_i64_destroy(&sl);
+    assert(counting.allocs == counting.frees && counting.live_bytes == 0);
+
+    printf("[test_allocator_i64] tearing a map down with free_all\n");
+    BumpCtx bump = {0};
+    SkipListAllocator b = { bump_alloc, NULL, bump_free_all, &bump };
+    SkipMap_i64 * sm = skipMap_i64_create_with_allocator(&b);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipMap_i64_put(sm, i, NULL));
+    }
+    assert(skipMap_i64_getSize(sm) == TEST_SIZE);
+    skipMap_i64_destroy(&sm);
+    assert(sm == NULL && bump.blocks == NULL && bump.released == 1);
+    printf("[test_allocator_i64] ✅\n");
+}
+
+void test_allocator_u64() {
+    printf("test_allocator_u64()\n");
+    CountingCtx counting = {0};
+    SkipListAllocator a = { counting_alloc, counting_free, NULL, &counting };
+    SkipList_u64 * sl = skipList_u64_create_with_allocator(&a);
+    printf("[test_allocator_u64] inserting/removing through counting allocator\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_u64_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        skipList_u64_remove(sl, i);
+    }
+    uint64_t p;
+    assert(skipList_u64_pop(sl, &p) && p == 1);
+    assert(counting.allocs > TEST_SIZE && counting.live_bytes > 0);
+    skipList_u64_destroy(&sl);
+    assert(counting.allocs == counting.frees && counting.live_bytes == 0);
+
+    printf("[test_allocator_u64] tearing a map down with free_all\n");
+    BumpCtx bump = {0};
+    SkipListAllocator b = { bump_alloc, NULL, bump_free_all, &bump };
+    SkipMap_u64 * sm = skipMap_u64_create_with_allocator(&b);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipMap_u64_put(sm, i, NULL));
+    }
+    assert(skipMap_u64_getSize(sm) == TEST_SIZE);
+    skipMap_u64_destroy(&sm);
+    assert(sm == NULL && bump.blocks == NULL && bump.released == 1);
+    printf("[test_allocator_u64] ✅\n");
+}
+
+void test_allocator_generic() {
+    printf("test_allocator_generic()\n");
+    SkipList_SL_Counted * sl = SkipList_SL_Counted_create(0);
+    SkipMap_SM_Counted * sm = SkipMap_SM_Counted_create(0, 0);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(SkipList_SL_Counted_insert(sl, i));
+        assert(SkipMap_SM_Counted_put(sm, i, i * 2));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        int v;
+        assert(SkipList_SL_Counted_remove(sl, i));
+        assert(SkipMap_SM_Counted_remove(sm, i, &v) && v == i * 2);
+    }
+    assert(generic_counting.live_bytes > 0);
+    SkipList_SL_Counted_destroy(&sl);
+    SkipMap_SM_Counted_destroy(&sm);
+    assert(generic_counting.allocs == generic_counting.frees && generic_counting.live_bytes == 0);
+
+    printf("[test_allocator_generic] runtime allocator with free_all\n");
+    BumpCtx bump = {0};
+    SkipListAllocator b = { bump_alloc, NULL, bump_free_all, &bump };
+    SkipList_SL_Counted * bl = SkipList_SL_Counted_create_with_allocator(0, &b);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(SkipList_SL_Counted_insert(bl, i));
+    }
+    SkipList_SL_Counted_destroy(&bl);
+    assert(bl == NULL && bump.blocks == NULL && bump.released == 1);
+    printf("[test_allocator_generic] ✅\n");
+}
+
+int main() {
+    test_allocator_i32();
+    test_allocator_u32();
+    test_allocator_i64();
+    test_allocator_u64();
+    test_allocator_generic();
+}
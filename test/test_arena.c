@@ -0,0 +1,221 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_SIZE 10000
+
+void test_arena_i32() {
+    printf("test_arena_i32()\n");
+    SkipList_i32 * sl = skipList_i32_create_with_arena();
+    SkipMap_i32 * sm = skipMap_i32_create_with_arena();
+
+    printf("[test_arena_i32] inserting %d elements into skiplist\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_i32_insert(sl, i));
+    }
+    assert(skipList_i32_getSize(sl) == TEST_SIZE);
+    // release every other node so the freelists get reused by the next inserts
+    printf("[test_arena_i32] removing and reinserting odd elements\n");
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        skipList_i32_remove(sl, i);
+        assert(!skipList_i32_search(sl, i));
+    }
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        assert(skipList_i32_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_i32_search(sl, i));
+    }
+    int32_t p;
+    assert(skipList_i32_pop(sl, &p) && p == 0);
+    assert(skipList_i32_getSize(sl) == TEST_SIZE - 1);
+    skipList_i32_destroy(&sl);
+    assert(sl == NULL);
+
+    printf("[test_arena_i32] inserting %d elements into skipMap\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int32_t * v = malloc(sizeof(int32_t));
+        *v = i;
+        assert(skipMap_i32_put(sm, i, v));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 3) {
+        int32_t * v = skipMap_i32_remove(sm, i);
+        assert(v && *v == (int32_t)i);
+        free(v);
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int32_t * v = skipMap_i32_get(sm, i);
+        assert(i % 3 == 0 ? v == NULL : *v == (int32_t)i);
+    }
+    struct SM_i32_kv kv;
+    assert(skipMap_i32_pop(sm, &kv) && kv.key == 1);
+    free(kv.value);
+    // destroy frees the remaining values and then the slabs
+    skipMap_i32_destroy(&sm);
+    assert(sm == NULL);
+    printf("[test_arena_i32] ✅\n");
+}
+
+void test_arena_u32() {
+    printf("test_arena_u32()\n");
+    SkipList_u32 * sl = skipList_u32_create_with_arena();
+    SkipMap_u32 * sm = skipMap_u32_create_with_arena();
+
+    printf("[test_arena_u32] inserting %d elements into skiplist\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_u32_insert(sl, i));
+    }
+    assert(skipList_u32_getSize(sl) == TEST_SIZE);
+    // release every other node so the freelists get reused by the next inserts
+    printf("[test_arena_u32] removing and reinserting odd elements\n");
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        skipList_u32_remove(sl, i);
+        assert(!skipList_u32_search(sl, i));
+    }
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        assert(skipList_u32_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_u32_search(sl, i));
+    }
+    uint32_t p;
+    assert(skipList_u32_pop(sl, &p) && p == 0);
+    assert(skipList_u32_getSize(sl) == TEST_SIZE - 1);
+    skipList_u32_destroy(&sl);
+    assert(sl == NULL);
+
+    printf("[test_arena_u32] inserting %d elements into skipMap\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint32_t * v = malloc(sizeof(uint32_t));
+        *v = i;
+        assert(skipMap_u32_put(sm, i, v));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 3) {
+        uint32_t * v = skipMap_u32_remove(sm, i);
+        assert(v && *v == (uint32_t)i);
+        free(v);
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint32_t * v = skipMap_u32_get(sm, i);
+        assert(i % 3 == 0 ? v == NULL : *v == (uint32_t)i);
+    }
+    struct SM_u32_kv kv;
+    assert(skipMap_u32_pop(sm, &kv) && kv.key == 1);
+    free(kv.value);
+    // destroy frees the remaining values and then the slabs
+    skipMap_u32_destroy(&sm);
+    assert(sm == NULL);
+    printf("[test_arena_u32] ✅\n");
+}
+
+void test_arena_i64() {
+    printf("test_arena_i64()\n");
+    SkipList_i64 * sl = skipList_i64_create_with_arena();
+    SkipMap_i64 * sm = skipMap_i64_create_with_arena();
+
+    printf("[test_arena_i64] inserting %d elements into skiplist\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_i64_insert(sl, i));
+    }
+    assert(skipList_i64_getSize(sl) == TEST_SIZE);
+    // release every other node so the freelists get reused by the next inserts
+    printf("[test_arena_i64] removing and reinserting odd elements\n");
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        skipList_i64_remove(sl, i);
+        assert(!skipList_i64_search(sl, i));
+    }
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        assert(skipList_i64_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_i64_search(sl, i));
+    }
+    int64_t p;
+    assert(skipList_i64_pop(sl, &p) && p == 0);
+    assert(skipList_i64_getSize(sl) == TEST_SIZE - 1);
+    skipList_i64_destroy(&sl);
+    assert(sl == NULL);
+
+    printf("[test_arena_i64] inserting %d elements into skipMap\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int64_t * v = malloc(sizeof(int64_t));
+        *v = i;
+        assert(skipMap_i64_put(sm, i, v));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 3) {
+        int64_t * v = skipMap_i64_remove(sm, i);
+        assert(v && *v == (int64_t)i);
+        free(v);
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int64_t * v = skipMap_i64_get(sm, i);
+        assert(i % 3 == 0 ? v == NULL : *v == (int64_t)i);
+    }
+    struct SM_i64_kv kv;
+    assert(skipMap_i64_pop(sm, &kv) && kv.key == 1);
+    free(kv.value);
+    // destroy frees the remaining values and then the slabs
+    skipMap_i64_destroy(&sm);
+    assert(sm == NULL);
+    printf("[test_arena_i64] ✅\n");
+}
+
+void test_arena_u64() {
+    printf("test_arena_u64()\n");
+    SkipList_u64 * sl = skipList_u64_create_with_arena();
+    SkipMap_u64 * sm = skipMap_u64_create_with_arena();
+
+    printf("[test_arena_u64] inserting %d elements into skiplist\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_u64_insert(sl, i));
+    }
+    assert(skipList_u64_getSize(sl) == TEST_SIZE);
+    // release every other node so the freelists get reused by the next inserts
+    printf("[test_arena_u64] removing and reinserting odd elements\n");
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        skipList_u64_remove(sl, i);
+        assert(!skipList_u64_search(sl, i));
+    }
+    for (int i = 1; i < TEST_SIZE; i += 2) {
+        assert(skipList_u64_insert(sl, i));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        assert(skipList_u64_search(sl, i));
+    }
+    uint64_t p;
+    assert(skipList_u64_pop(sl, &p) && p == 0);
+    assert(skipList_u64_getSize(sl) == TEST_SIZE - 1);
+    skipList_u64_destroy(&sl);
+    assert(sl == NULL);
+
+    printf("[test_arena_u64] inserting %d elements into skipMap\n", TEST_SIZE);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint64_t * v = malloc(sizeof(uint64_t));
+        *v = i;
+        assert(skipMap_u64_put(sm, i, v));
+    }
+    for (int i = 0; i < TEST_SIZE; i += 3) {
+        uint64_t * v = skipMap_u64_remove(sm, i);
+        assert(v && *v == (uint64_t)i);
+        free(v);
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint64_t * v = skipMap_u64_get(sm, i);
+        assert(i % 3 == 0 ? v == NULL : *v == (uint64_t)i);
+    }
+    struct SM_u64_kv kv;
+    assert(skipMap_u64_pop(sm, &kv) && kv.key == 1);
+    free(kv.value);
+    // destroy frees the remaining values and then the slabs
+    skipMap_u64_destroy(&sm);
+    assert(sm == NULL);
+    printf("[test_arena_u64] ✅\n");
+}
+
+int main() {
+    test_arena_i32();
+    test_arena_u32();
+    test_arena_i64();
+    test_arena_u64();
+}
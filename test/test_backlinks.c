@@ -0,0 +1,507 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define TEST_SIZE 4000
+#define KEY_RANGE 8000
+
+struct rev_state {
+    int64_t last;
+    uint32_t count;
+};
+
+// the backward walk has to be the exact mirror of the forward one
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void check_links_i32(SkipList_i32 * sl) {
+    static int32_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+    for (; skipList_i32_iter_valid(it); skipList_i32_iter_next(it)) {
+        keys[n++] = skipList_i32_iter_key(it);
+    }
+    assert(n == skipList_i32_getSize(sl));
+    skipList_i32_iter_last(it);
+    for (uint32_t i = n; i-- > 0; skipList_i32_iter_prev(it)) {
+        assert(skipList_i32_iter_valid(it) && skipList_i32_iter_key(it) == keys[i]);
+    }
+    assert(!skipList_i32_iter_valid(it));
+    skipList_i32_iter_destroy(&it);
+}
+
+static bool rev_visit_i32(int32_t key, void *ctx) {
+    struct rev_state *st = (struct rev_state *)ctx;
+    assert(st->count == 0 || (int64_t)key < st->last);
+    st->last = (int64_t)key;
+    st->count++;
+    return true;
+}
+
+static bool rev_visit_map_i32(int32_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)((int64_t)key + 4000 + 1));
+    return rev_visit_i32(key, ctx);
+}
+
+static void mixed_ops_i32(uint32_t flags) {
+    SkipList_i32 * sl = skipList_i32_create_with_flags(flags);
+    SkipListFinger_i32 * f = skipList_i32_finger_create(sl);
+    int32_t out;
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_i32_insert(sl, (int32_t)(-4000 + rand() % KEY_RANGE));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int32_t key = (int32_t)(-4000 + rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_i32_remove(sl, key); break;
+            case 1: skipList_i32_pop(sl, &out); break;
+            case 2: skipList_i32_finger_insert(f, key); break;
+            case 3: skipList_i32_finger_remove(f, key); break;
+            default: skipList_i32_insert(sl, key); break;
+        }
+    }
+    check_links_i32(sl);
+    // iterator removal walks back links instead of descending
+    SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+    for (int i = 0; skipList_i32_iter_valid(it); i++) {
+        if (i % 3 == 0) assert(skipList_i32_iter_remove(it));
+        skipList_i32_iter_next(it);
+    }
+    skipList_i32_iter_destroy(&it);
+    check_links_i32(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        assert(skipList_i32_select(sl, skipList_i32_getSize(sl) - 1, &out));
+        assert(skipList_i32_rank(sl, out) == skipList_i32_getSize(sl) - 1);
+    }
+    struct rev_state st = {0, 0};
+    int32_t lo = -3000, hi = -1000;
+    skipList_i32_scanReverse(sl, lo, hi, rev_visit_i32, &st);
+    uint32_t expected = 0;
+    for (int64_t k = -4000 + 1000; k < -4000 + 3000; k++) {
+        expected += skipList_i32_search(sl, (int32_t)k);
+    }
+    assert(st.count == expected);
+    skipList_i32_finger_destroy(&f);
+    skipList_i32_destroy(&sl);
+}
+
+void test_backlinks_i32() {
+    printf("test_backlinks_i32()\n");
+    printf("[test_backlinks_i32] mixed updates keep both directions in sync\n");
+    mixed_ops_i32(SKIPLIST_BACKLINKS);
+    mixed_ops_i32(SKIPLIST_BACKLINKS | SKIPLIST_INDEXABLE);
+    mixed_ops_i32(SKIPLIST_BACKLINKS | SKIPLIST_ARENA);
+    printf("[test_backlinks_i32] prev over a removed position\n");
+    SkipList_i32 * sl = skipList_i32_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 10; i++) skipList_i32_insert(sl, (int32_t)(-4000 + i));
+    SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+    skipList_i32_iter_seek(it, -3995);
+    skipList_i32_remove(sl, -3995);
+    skipList_i32_remove(sl, -3996);
+    assert(skipList_i32_iter_prev(it) && skipList_i32_iter_key(it) == -3997);
+    skipList_i32_iter_last(it);
+    assert(skipList_i32_iter_remove(it));
+    assert(skipList_i32_iter_prev(it) && skipList_i32_iter_key(it) == -3992);
+    skipList_i32_iter_seekBefore(it, (int32_t)-4000);
+    assert(!skipList_i32_iter_valid(it));
+    skipList_i32_iter_destroy(&it);
+    skipList_i32_destroy(&sl);
+    printf("[test_backlinks_i32] maps\n");
+    SkipMap_i32 * sm = skipMap_i32_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 100; i++) {
+        skipMap_i32_put(sm, (int32_t)(-4000 + i), (void *)(intptr_t)(i + 1));
+    }
+    struct rev_state st = {0, 0};
+    assert(skipMap_i32_scanReverse(sm, -3990, -3980, rev_visit_map_i32, &st) == 10);
+    assert(st.last == -4000 + 10);
+    it = skipMap_i32_iter_create(sm);
+    skipList_i32_iter_seek(it, -3950);
+    assert(skipMap_i32_iter_remove(it) == (void *)(intptr_t)51);
+    assert(skipMap_i32_get(sm, -3950) == NULL);
+    assert(skipList_i32_iter_prev(it));
+    assert(skipMap_i32_iter_value(it) == (void *)(intptr_t)50);
+    while (skipList_i32_iter_valid(it)) {
+        skipMap_i32_iter_remove(it);
+        skipList_i32_iter_prev(it);
+    }
+    skipList_i32_iter_destroy(&it);
+    assert(skipMap_i32_getSize(sm) == 49);
+    struct SM_i32_kv kv;
+    while (skipMap_i32_pop(sm, &kv));
+    skipMap_i32_destroy(&sm);
+    printf("[test_backlinks_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void check_links_u32(SkipList_u32 * sl) {
+    static uint32_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+    for (; skipList_u32_iter_valid(it); skipList_u32_iter_next(it)) {
+        keys[n++] = skipList_u32_iter_key(it);
+    }
+    assert(n == skipList_u32_getSize(sl));
+    skipList_u32_iter_last(it);
+    for (uint32_t i = n; i-- > 0; skipList_u32_iter_prev(it)) {
+        assert(skipList_u32_iter_valid(it) && skipList_u32_iter_key(it) == keys[i]);
+    }
+    assert(!skipList_u32_iter_valid(it));
+    skipList_u32_iter_destroy(&it);
+}
+
+static bool rev_visit_u32(uint32_t key, void *ctx) {
+    struct rev_state *st = (struct rev_state *)ctx;
+    assert(st->count == 0 || (int64_t)key < st->last);
+    st->last = (int64_t)key;
+    st->count++;
+    return true;
+}
+
+static bool rev_visit_map_u32(uint32_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)((int64_t)key + 1));
+    return rev_visit_u32(key, ctx);
+}
+
+static void mixed_ops_u32(uint32_t flags) {
+    SkipList_u32 * sl = skipList_u32_create_with_flags(flags);
+    SkipListFinger_u32 * f = skipList_u32_finger_create(sl);
+    uint32_t out;
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_u32_insert(sl, (uint32_t)(rand() % KEY_RANGE));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint32_t key = (uint32_t)(rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_u32_remove(sl, key); break;
+            case 1: skipList_u32_pop(sl, &out); break;
+            case 2: skipList_u32_finger_insert(f, key); break;
+            case 3: skipList_u32_finger_remove(f, key); break;
+            default: skipList_u32_insert(sl, key); break;
+        }
+    }
+    check_links_u32(sl);
+    // iterator removal walks back links instead of descending
+    SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+    for (int i = 0; skipList_u32_iter_valid(it); i++) {
+        if (i % 3 == 0) assert(skipList_u32_iter_remove(it));
+        skipList_u32_iter_next(it);
+    }
+    skipList_u32_iter_destroy(&it);
+    check_links_u32(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        assert(skipList_u32_select(sl, skipList_u32_getSize(sl) - 1, &out));
+        assert(skipList_u32_rank(sl, out) == skipList_u32_getSize(sl) - 1);
+    }
+    struct rev_state st = {0, 0};
+    uint32_t lo = 1000, hi = 3000;
+    skipList_u32_scanReverse(sl, lo, hi, rev_visit_u32, &st);
+    uint32_t expected = 0;
+    for (int64_t k = 1000; k < 3000; k++) {
+        expected += skipList_u32_search(sl, (uint32_t)k);
+    }
+    assert(st.count == expected);
+    skipList_u32_finger_destroy(&f);
+    skipList_u32_destroy(&sl);
+}
+
+void test_backlinks_u32() {
+    printf("test_backlinks_u32()\n");
+    printf("[test_backlinks_u32] mixed updates keep both directions in sync\n");
+    mixed_ops_u32(SKIPLIST_BACKLINKS);
+    mixed_ops_u32(SKIPLIST_BACKLINKS | SKIPLIST_INDEXABLE);
+    mixed_ops_u32(SKIPLIST_BACKLINKS | SKIPLIST_ARENA);
+    printf("[test_backlinks_u32] prev over a removed position\n");
+    SkipList_u32 * sl = skipList_u32_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 10; i++) skipList_u32_insert(sl, (uint32_t)i);
+    SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+    skipList_u32_iter_seek(it, 5);
+    skipList_u32_remove(sl, 5);
+    skipList_u32_remove(sl, 4);
+    assert(skipList_u32_iter_prev(it) && skipList_u32_iter_key(it) == 3);
+    skipList_u32_iter_last(it);
+    assert(skipList_u32_iter_remove(it));
+    assert(skipList_u32_iter_prev(it) && skipList_u32_iter_key(it) == 8);
+    skipList_u32_iter_seekBefore(it, 0);
+    assert(!skipList_u32_iter_valid(it));
+    skipList_u32_iter_destroy(&it);
+    skipList_u32_destroy(&sl);
+    printf("[test_backlinks_u32] maps\n");
+    SkipMap_u32 * sm = skipMap_u32_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 100; i++) {
+        skipMap_u32_put(sm, (uint32_t)i, (void *)(intptr_t)(i + 1));
+    }
+    struct rev_state st = {0, 0};
+    assert(skipMap_u32_scanReverse(sm, 10, 20, rev_visit_map_u32, &st) == 10);
+    assert(st.last == 10);
+    it = skipMap_u32_iter_create(sm);
+    skipList_u32_iter_seek(it, 50);
+    assert(skipMap_u32_iter_remove(it) == (void *)(intptr_t)51);
+    assert(skipMap_u32_get(sm, 50) == NULL);
+    assert(skipList_u32_iter_prev(it));
+    assert(skipMap_u32_iter_value(it) == (void *)(intptr_t)50);
+    while (skipList_u32_iter_valid(it)) {
+        skipMap_u32_iter_remove(it);
+        skipList_u32_iter_prev(it);
+    }
+    skipList_u32_iter_destroy(&it);
+    assert(skipMap_u32_getSize(sm) == 49);
+    struct SM_u32_kv kv;
+    while (skipMap_u32_pop(sm, &kv));
+    skipMap_u32_destroy(&sm);
+    printf("[test_backlinks_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void check_links_i64(SkipList_i64 * sl) {
+    static int64_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+    for (; skipList_i64_iter_valid(it); skipList_i64_iter_next(it)) {
+        keys[n++] = skipList_i64_iter_key(it);
+    }
+    assert(n == skipList_i64_getSize(sl));
+    skipList_i64_iter_last(it);
+    for (uint32_t i = n; i-- > 0; skipList_i64_iter_prev(it)) {
+        assert(skipList_i64_iter_valid(it) && skipList_i64_iter_key(it) == keys[i]);
+    }
+    assert(!skipList_i64_iter_valid(it));
+    skipList_i64_iter_destroy(&it);
+}
+
+static bool rev_visit_i64(int64_t key, void *ctx) {
+    struct rev_state *st = (struct rev_state *)ctx;
+    assert(st->count == 0 || (int64_t)key < st->last);
+    st->last = (int64_t)key;
+    st->count++;
+    return true;
+}
+
+static bool rev_visit_map_i64(int64_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)((int64_t)key + 4000 + 1));
+    return rev_visit_i64(key, ctx);
+}
+
+static void mixed_ops_i64(uint32_t flags) {
+    SkipList_i64 * sl = skipList_i64_create_with_flags(flags);
+    SkipListFinger_i64 * f = skipList_i64_finger_create(sl);
+    int64_t out;
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_i64_insert(sl, (int64_t)(-4000 + rand() % KEY_RANGE));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int64_t key = (int64_t)(-4000 + rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_i64_remove(sl, key); break;
+            case 1: skipList_i64_pop(sl, &out); break;
+            case 2: skipList_i64_finger_insert(f, key); break;
+            case 3: skipList_i64_finger_remove(f, key); break;
+            default: skipList_i64_insert(sl, key); break;
+        }
+    }
+    check_links_i64(sl);
+    // iterator removal walks back links instead of descending
+    SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+    for (int i = 0; skipList_i64_iter_valid(it); i++) {
+        if (i % 3 == 0) assert(skipList_i64_iter_remove(it));
+        skipList_i64_iter_next(it);
+    }
+    skipList_i64_iter_destroy(&it);
+    check_links_i64(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        assert(skipList_i64_select(sl, skipList_i64_getSize(sl) - 1, &out));
+        assert(skipList_i64_rank(sl, out) == skipList_i64_getSize(sl) - 1);
+    }
+    struct rev_state st = {0, 0};
+    int64_t lo = -3000, hi = -1000;
+    skipList_i64_scanReverse(sl, lo, hi, rev_visit_i64, &st);
+    uint32_t expected = 0;
+    for (int64_t k = -4000 + 1000; k < -4000 + 3000; k++) {
+        expected += skipList_i64_search(sl, (int64_t)k);
+    }
+    assert(st.count == expected);
+    skipList_i64_finger_destroy(&f);
+    skipList_i64_destroy(&sl);
+}
+
+void test_backlinks_i64() {
+    printf("test_backlinks_i64()\n");
+    printf("[test_backlinks_i64] mixed updates keep both directions in sync\n");
+    mixed_ops_i64(SKIPLIST_BACKLINKS);
+    mixed_ops_i64(SKIPLIST_BACKLINKS | SKIPLIST_INDEXABLE);
+    mixed_ops_i64(SKIPLIST_BACKLINKS | SKIPLIST_ARENA);
+    printf("[test_backlinks_i64] prev over a removed position\n");
+    SkipList_i64 * sl = skipList_i64_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 10; i++) skipList_i64_insert(sl, (int64_t)(-4000 + i));
+    SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+    skipList_i64_iter_seek(it, -3995);
+    skipList_i64_remove(sl, -3995);
+    skipList_i64_remove(sl, -3996);
+    assert(skipList_i64_iter_prev(it) && skipList_i64_iter_key(it) == -3997);
+    skipList_i64_iter_last(it);
+    assert(skipList_i64_iter_remove(it));
+    assert(skipList_i64_iter_prev(it) && skipList_i64_iter_key(it) == -3992);
+    skipList_i64_iter_seekBefore(it, (int64_t)-4000);
+    assert(!skipList_i64_iter_valid(it));
+    skipList_i64_iter_destroy(&it);
+    skipList_i64_destroy(&sl);
+    printf("[test_backlinks_i64] maps\n");
+    SkipMap_i64 * sm = skipMap_i64_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 100; i++) {
+        skipMap_i64_put(sm, (int64_t)(-4000 + i), (void *)(intptr_t)(i + 1));
+    }
+    struct rev_state st = {0, 0};
+    assert(skipMap_i64_scanReverse(sm, -3990, -3980, rev_visit_map_i64, &st) == 10);
+    assert(st.last == -4000 + 10);
+    it = skipMap_i64_iter_create(sm);
+    skipList_i64_iter_seek(it, -3950);
+    assert(skipMap_i64_iter_remove(it) == (void *)(intptr_t)51);
+    assert(skipMap_i64_get(sm, -3950) == NULL);
+    assert(skipList_i64_iter_prev(it));
+    assert(skipMap_i64_iter_value(it) == (void *)(intptr_t)50);
+    while (skipList_i64_iter_valid(it)) {
+        skipMap_i64_iter_remove(it);
+        skipList_i64_iter_prev(it);
+    }
+    skipList_i64_iter_destroy(&it);
+    assert(skipMap_i64_getSize(sm) == 49);
+    struct SM_i64_kv kv;
+    while (skipMap_i64_pop(sm, &kv));
+    skipMap_i64_destroy(&sm);
+    printf("[test_backlinks_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void check_links_u64(SkipList_u64 * sl) {
+    static uint64_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+    for (; skipList_u64_iter_valid(it); skipList_u64_iter_next(it)) {
+        keys[n++] = skipList_u64_iter_key(it);
+    }
+    assert(n == skipList_u64_getSize(sl));
+    skipList_u64_iter_last(it);
+    for (uint32_t i = n; i-- > 0; skipList_u64_iter_prev(it)) {
+        assert(skipList_u64_iter_valid(it) && skipList_u64_iter_key(it) == keys[i]);
+    }
+    assert(!skipList_u64_iter_valid(it));
+    skipList_u64_iter_destroy(&it);
+}
+
+static bool rev_visit_u64(uint64_t key, void *ctx) {
+    struct rev_state *st = (struct rev_state *)ctx;
+    assert(st->count == 0 || (int64_t)key < st->last);
+    st->last = (int64_t)key;
+    st->count++;
+    return true;
+}
+
+static bool rev_visit_map_u64(uint64_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)((int64_t)key + 1));
+    return rev_visit_u64(key, ctx);
+}
+
+static void mixed_ops_u64(uint32_t flags) {
+    SkipList_u64 * sl = skipList_u64_create_with_flags(flags);
+    SkipListFinger_u64 * f = skipList_u64_finger_create(sl);
+    uint64_t out;
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_u64_insert(sl, (uint64_t)(rand() % KEY_RANGE));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint64_t key = (uint64_t)(rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_u64_remove(sl, key); break;
+            case 1: skipList_u64_pop(sl, &out); break;
+            case 2: skipList_u64_finger_insert(f, key); break;
+            case 3: skipList_u64_finger_remove(f, key); break;
+            default: skipList_u64_insert(sl, key); break;
+        }
+    }
+    check_links_u64(sl);
+    // iterator removal walks back links instead of descending
+    SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+    for (int i = 0; skipList_u64_iter_valid(it); i++) {
+        if (i % 3 == 0) assert(skipList_u64_iter_remove(it));
+        skipList_u64_iter_next(it);
+    }
+    skipList_u64_iter_destroy(&it);
+    check_links_u64(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        assert(skipList_u64_select(sl, skipList_u64_getSize(sl) - 1, &out));
+        assert(skipList_u64_rank(sl, out) == skipList_u64_getSize(sl) - 1);
+    }
+    struct rev_state st = {0, 0};
+    uint64_t lo = 1000, hi = 3000;
+    skipList_u64_scanReverse(sl, lo, hi, rev_visit_u64, &st);
+    uint32_t expected = 0;
+    for (int64_t k = 1000; k < 3000; k++) {
+        expected += skipList_u64_search(sl, (uint64_t)k);
+    }
+    assert(st.count == expected);
+    skipList_u64_finger_destroy(&f);
+    skipList_u64_destroy(&sl);
+}
+
+void test_backlinks_u64() {
+    printf("test_backlinks_u64()\n");
+    printf("[test_backlinks_u64] mixed updates keep both directions in sync\n");
+    mixed_ops_u64(SKIPLIST_BACKLINKS);
+    mixed_ops_u64(SKIPLIST_BACKLINKS | SKIPLIST_INDEXABLE);
+    mixed_ops_u64(SKIPLIST_BACKLINKS | SKIPLIST_ARENA);
+    printf("[test_backlinks_u64] prev over a removed position\n");
+    SkipList_u64 * sl = skipList_u64_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 10; i++) skipList_u64_insert(sl, (uint64_t)i);
+    SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+    skipList_u64_iter_seek(it, 5);
+    skipList_u64_remove(sl, 5);
+    skipList_u64_remove(sl, 4);
+    assert(skipList_u64_iter_prev(it) && skipList_u64_iter_key(it) == 3);
+    skipList_u64_iter_last(it);
+    assert(skipList_u64_iter_remove(it));
+    assert(skipList_u64_iter_prev(it) && skipList_u64_iter_key(it) == 8);
+    skipList_u64_iter_seekBefore(it, 0);
+    assert(!skipList_u64_iter_valid(it));
+    skipList_u64_iter_destroy(&it);
+    skipList_u64_destroy(&sl);
+    printf("[test_backlinks_u64] maps\n");
+    SkipMap_u64 * sm = skipMap_u64_create_with_flags(SKIPLIST_BACKLINKS);
+    for (int i = 0; i < 100; i++) {
+        skipMap_u64_put(sm, (uint64_t)i, (void *)(intptr_t)(i + 1));
+    }
+    struct rev_state st = {0, 0};
+    assert(skipMap_u64_scanReverse(sm, 10, 20, rev_visit_map_u64, &st) == 10);
+    assert(st.last == 10);
+    it = skipMap_u64_iter_create(sm);
+    skipList_u64_iter_seek(it, 50);
+    assert(skipMap_u64_iter_remove(it) == (void *)(intptr_t)51);
+    assert(skipMap_u64_get(sm, 50) == NULL);
+    assert(skipList_u64_iter_prev(it));
+    assert(skipMap_u64_iter_value(it) == (void *)(intptr_t)50);
+    while (skipList_u64_iter_valid(it)) {
+        skipMap_u64_iter_remove(it);
+        skipList_u64_iter_prev(it);
+    }
+    skipList_u64_iter_destroy(&it);
+    assert(skipMap_u64_getSize(sm) == 49);
+    struct SM_u64_kv kv;
+    while (skipMap_u64_pop(sm, &kv));
+    skipMap_u64_destroy(&sm);
+    printf("[test_backlinks_u64] ✅\n");
+}
+
+
+int main() {
+    test_backlinks_i32();
+    test_backlinks_u32();
+    test_backlinks_i64();
+    test_backlinks_u64();
+    return 0;
+}
@@ -0,0 +1,392 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+// large enough that searchMany takes the interleaved path
+#define TEST_SIZE 80000
+#define BATCH 256
+
+void test_search_many_u64() {
+    printf("test_search_many_u64()\n");
+    SkipList_u64 * sl = skipList_u64_create();
+    // only even keys are present so every batch mixes hits and misses
+    for (uint64_t i = 0; i < TEST_SIZE; i += 2) {
+        assert(skipList_u64_insert(sl, i));
+    }
+    uint64_t keys[BATCH];
+    bool results[BATCH];
+    printf("[test_search_many_u64] probing %d random keys in batches of %d\n", TEST_SIZE, BATCH);
+    for (int b = 0; b < TEST_SIZE / BATCH; b++) {
+        uint32_t expected = 0;
+        for (int i = 0; i < BATCH; i++) {
+            keys[i] = (uint64_t)(rand() % (TEST_SIZE + 100));
+            expected += skipList_u64_search(sl, keys[i]);
+        }
+        assert(skipList_u64_searchMany(sl, keys, BATCH, results) == expected);
+        for (int i = 0; i < BATCH; i++) {
+            assert(results[i] == skipList_u64_search(sl, keys[i]));
+        }
+    }
+    // batches shorter than the interleave width and empty batches
+    keys[0] = 4; keys[1] = 5; keys[2] = 4;
+    assert(skipList_u64_searchMany(sl, keys, 3, results) == 2);
+    assert(results[0] && !results[1] && results[2]);
+    assert(skipList_u64_searchMany(sl, keys, 0, results) == 0);
+    skipList_u64_destroy(&sl);
+
+    SkipList_u64 * empty = skipList_u64_create();
+    assert(skipList_u64_searchMany(empty, keys, 3, results) == 0);
+    assert(!results[0] && !results[1] && !results[2]);
+    skipList_u64_destroy(&empty);
+    printf("[test_search_many_u64] ✅\n");
+}
+
+void test_get_many_u64() {
+    printf("test_get_many_u64()\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (uint64_t i = 0; i < TEST_SIZE; i += 2) {
+        uint64_t * v = malloc(sizeof(uint64_t));
+        *v = i;
+        assert(skipMap_u64_put(sm, i, v));
+    }
+    uint64_t keys[BATCH];
+    void * values[BATCH];
+    printf("[test_get_many_u64] probing %d random keys in batches of %d\n", TEST_SIZE, BATCH);
+    for (int b = 0; b < TEST_SIZE / BATCH; b++) {
+        for (int i = 0; i < BATCH; i++) {
+            keys[i] = (uint64_t)(rand() % (TEST_SIZE + 100));
+        }
+        skipMap_u64_getMany(sm, keys, BATCH, values);
+        for (int i = 0; i < BATCH; i++) {
+            uint64_t * v = values[i];
+            assert(v == skipMap_u64_get(sm, keys[i]));
+            assert(!v || *v == keys[i]);
+        }
+    }
+    skipMap_u64_destroy(&sm);
+    printf("[test_get_many_u64] ✅\n");
+}
+
+void test_search_sorted_u64() {
+    printf("test_search_sorted_u64()\n");
+    SkipList_u64 * sl = skipList_u64_create();
+    for (uint64_t i = 0; i < TEST_SIZE; i += 2) {
+        assert(skipList_u64_insert(sl, i));
+    }
+    uint64_t * keys = malloc(sizeof(uint64_t) * TEST_SIZE);
+    bool * results = malloc(sizeof(bool) * TEST_SIZE);
+    printf("[test_search_sorted_u64] dense sorted probe over %d keys\n", TEST_SIZE);
+    for (uint64_t i = 0; i < TEST_SIZE; i++) {
+        keys[i] = i;
+    }
+    assert(skipList_u64_searchSorted(sl, keys, TEST_SIZE, results) == TEST_SIZE / 2);
+    for (uint64_t i = 0; i < TEST_SIZE; i++) {
+        assert(results[i] == (i % 2 == 0));
+    }
+    printf("[test_search_sorted_u64] sparse sorted probe with repeats\n");
+    uint32_t n = 0;
+    for (uint64_t k = 0; k < TEST_SIZE + 500; k += (uint64_t)(rand() % 300)) {
+        keys[n++] = k;
+    }
+    skipList_u64_searchSorted(sl, keys, n, results);
+    for (uint32_t i = 0; i < n; i++) {
+        assert(results[i] == skipList_u64_search(sl, keys[i]));
+    }
+    // keys out of order still get correct answers
+    keys[0] = 100; keys[1] = 40; keys[2] = 41; keys[3] = 2; keys[4] = TEST_SIZE - 2;
+    assert(skipList_u64_searchSorted(sl, keys, 5, results) == 4);
+    assert(results[0] && results[1] && !results[2] && results[3] && results[4]);
+    free(keys);
+    free(results);
+    skipList_u64_destroy(&sl);
+    printf("[test_search_sorted_u64] ✅\n");
+}
+
+void test_get_sorted_u64() {
+    printf("test_get_sorted_u64()\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (uint64_t i = 0; i < TEST_SIZE; i += 3) {
+        uint64_t * v = malloc(sizeof(uint64_t));
+        *v = i;
+        assert(skipMap_u64_put(sm, i, v));
+    }
+    uint64_t keys[BATCH];
+    void * values[BATCH];
+    printf("[test_get_sorted_u64] sorted probes in batches of %d\n", BATCH);
+    for (uint64_t base = 0; base < TEST_SIZE; base += BATCH) {
+        for (int i = 0; i < BATCH; i++) {
+            keys[i] = base + (uint64_t)i;
+        }
+        skipMap_u64_getSorted(sm, keys, BATCH, values);
+        for (int i = 0; i < BATCH; i++) {
+            uint64_t * v = values[i];
+            assert(v == skipMap_u64_get(sm, keys[i]));
+            assert(!v || *v == keys[i]);
+        }
+    }
+    skipMap_u64_destroy(&sm);
+    printf("[test_get_sorted_u64] ✅\n");
+}
+
+#define UPDATE_RANGE 20000
+#define UPDATE_BATCH 10000
+
+// batch updates are checked against a presence table, batches are unsorted
+// and repeat keys so the internal sort and duplicate handling are exercised
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void run_batch_updates_i32(uint32_t flags) {
+    static bool present[UPDATE_RANGE];
+    static int32_t keys[UPDATE_BATCH];
+    for (int i = 0; i < UPDATE_RANGE; i++) present[i] = false;
+    SkipList_i32 * sl = skipList_i32_create_with_flags(flags);
+    for (int round = 0; round < 6; round++) {
+        uint32_t expected = 0;
+        bool removing = round % 2 == 1;
+        for (int i = 0; i < UPDATE_BATCH; i++) {
+            int k = rand() % UPDATE_RANGE;
+            keys[i] = (int32_t)(INT64_C(-10000) + k);
+            if (present[k] == removing) { expected++; present[k] = !removing; }
+        }
+        uint32_t changed = removing ? skipList_i32_removeBatch(sl, keys, UPDATE_BATCH)
+                                    : skipList_i32_insertBatch(sl, keys, UPDATE_BATCH);
+        assert(changed == expected);
+    }
+    uint32_t size = 0;
+    for (int k = 0; k < UPDATE_RANGE; k++) {
+        assert(skipList_i32_search(sl, (int32_t)(INT64_C(-10000) + k)) == present[k]);
+        if (present[k] && (flags & SKIPLIST_INDEXABLE)) {
+            assert(skipList_i32_rank(sl, (int32_t)(INT64_C(-10000) + k)) == size);
+        }
+        size += present[k];
+    }
+    assert(skipList_i32_getSize(sl) == size);
+    // already sorted batches skip the copy
+    for (int i = 0; i < UPDATE_BATCH; i++) keys[i] = (int32_t)(INT64_C(-10000) + 2 * i);
+    skipList_i32_insertBatch(sl, keys, UPDATE_BATCH);
+    assert(skipList_i32_removeBatch(sl, keys, UPDATE_BATCH) == UPDATE_BATCH);
+    assert(skipList_i32_insertBatch(sl, keys, 0) == 0);
+    skipList_i32_destroy(&sl);
+}
+
+void test_batch_updates_i32() {
+    printf("test_batch_updates_i32()\n");
+    printf("[test_batch_updates_i32] unsorted insert and remove batches\n");
+    run_batch_updates_i32(0);
+    run_batch_updates_i32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    printf("[test_batch_updates_i32] putBatch keeps the last value of a key\n");
+    SkipMap_i32 * sm = skipMap_i32_create();
+    skipMap_i32_put(sm, (int32_t)(INT64_C(-10000) + 5), (void *)1);
+    int32_t mkeys[6] = {(int32_t)(INT64_C(-10000) + 9), (int32_t)(INT64_C(-10000) + 5), (int32_t)(INT64_C(-10000) + 7), (int32_t)(INT64_C(-10000) + 9),
+                  (int32_t)(INT64_C(-10000) + 1), (int32_t)(INT64_C(-10000) + 9)};
+    void * mvalues[6] = {(void *)2, (void *)3, (void *)4, (void *)5, (void *)6, (void *)7};
+    assert(skipMap_i32_putBatch(sm, mkeys, mvalues, 6) == 3);
+    assert(skipMap_i32_get(sm, (int32_t)(INT64_C(-10000) + 5)) == (void *)3);
+    assert(skipMap_i32_get(sm, (int32_t)(INT64_C(-10000) + 9)) == (void *)7);
+    assert(skipMap_i32_get(sm, (int32_t)(INT64_C(-10000) + 1)) == (void *)6);
+    int32_t skeys[3] = {(int32_t)(INT64_C(-10000) + 1), (int32_t)(INT64_C(-10000) + 2), (int32_t)(INT64_C(-10000) + 3)};
+    assert(skipMap_i32_putBatch(sm, skeys, mvalues, 3) == 2);
+    assert(skipMap_i32_get(sm, (int32_t)(INT64_C(-10000) + 1)) == (void *)2);
+    struct SM_i32_kv kv;
+    while (skipMap_i32_pop(sm, &kv));
+    skipMap_i32_destroy(&sm);
+    printf("[test_batch_updates_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void run_batch_updates_u32(uint32_t flags) {
+    static bool present[UPDATE_RANGE];
+    static uint32_t keys[UPDATE_BATCH];
+    for (int i = 0; i < UPDATE_RANGE; i++) present[i] = false;
+    SkipList_u32 * sl = skipList_u32_create_with_flags(flags);
+    for (int round = 0; round < 6; round++) {
+        uint32_t expected = 0;
+        bool removing = round % 2 == 1;
+        for (int i = 0; i < UPDATE_BATCH; i++) {
+            int k = rand() % UPDATE_RANGE;
+            keys[i] = (uint32_t)k;
+            if (present[k] == removing) { expected++; present[k] = !removing; }
+        }
+        uint32_t changed = removing ? skipList_u32_removeBatch(sl, keys, UPDATE_BATCH)
+                                    : skipList_u32_insertBatch(sl, keys, UPDATE_BATCH);
+        assert(changed == expected);
+    }
+    uint32_t size = 0;
+    for (int k = 0; k < UPDATE_RANGE; k++) {
+        assert(skipList_u32_search(sl, (uint32_t)k) == present[k]);
+        if (present[k] && (flags & SKIPLIST_INDEXABLE)) {
+            assert(skipList_u32_rank(sl, (uint32_t)k) == size);
+        }
+        size += present[k];
+    }
+    assert(skipList_u32_getSize(sl) == size);
+    // already sorted batches skip the copy
+    for (int i = 0; i < UPDATE_BATCH; i++) keys[i] = (uint32_t)(2 * i);
+    skipList_u32_insertBatch(sl, keys, UPDATE_BATCH);
+    assert(skipList_u32_removeBatch(sl, keys, UPDATE_BATCH) == UPDATE_BATCH);
+    assert(skipList_u32_insertBatch(sl, keys, 0) == 0);
+    skipList_u32_destroy(&sl);
+}
+
+void test_batch_updates_u32() {
+    printf("test_batch_updates_u32()\n");
+    printf("[test_batch_updates_u32] unsorted insert and remove batches\n");
+    run_batch_updates_u32(0);
+    run_batch_updates_u32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    printf("[test_batch_updates_u32] putBatch keeps the last value of a key\n");
+    SkipMap_u32 * sm = skipMap_u32_create();
+    skipMap_u32_put(sm, 5, (void *)1);
+    uint32_t mkeys[6] = {9, 5, 7, 9,
+                  1, 9};
+    void * mvalues[6] = {(void *)2, (void *)3, (void *)4, (void *)5, (void *)6, (void *)7};
+    assert(skipMap_u32_putBatch(sm, mkeys, mvalues, 6) == 3);
+    assert(skipMap_u32_get(sm, 5) == (void *)3);
+    assert(skipMap_u32_get(sm, 9) == (void *)7);
+    assert(skipMap_u32_get(sm, 1) == (void *)6);
+    uint32_t skeys[3] = {1, 2, 3};
+    assert(skipMap_u32_putBatch(sm, skeys, mvalues, 3) == 2);
+    assert(skipMap_u32_get(sm, 1) == (void *)2);
+    struct SM_u32_kv kv;
+    while (skipMap_u32_pop(sm, &kv));
+    skipMap_u32_destroy(&sm);
+    printf("[test_batch_updates_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void run_batch_updates_i64(uint32_t flags) {
+    static bool present[UPDATE_RANGE];
+    static int64_t keys[UPDATE_BATCH];
+    for (int i = 0; i < UPDATE_RANGE; i++) present[i] = false;
+    SkipList_i64 * sl = skipList_i64_create_with_flags(flags);
+    for (int round = 0; round < 6; round++) {
+        uint32_t expected = 0;
+        bool removing = round % 2 == 1;
+        for (int i = 0; i < UPDATE_BATCH; i++) {
+            int k = rand() % UPDATE_RANGE;
+            keys[i] = (int64_t)(INT64_C(-10000) + k);
+            if (present[k] == removing) { expected++; present[k] = !removing; }
+        }
+        uint32_t changed = removing ? skipList_i64_removeBatch(sl, keys, UPDATE_BATCH)
+                                    : skipList_i64_insertBatch(sl, keys, UPDATE_BATCH);
+        assert(changed == expected);
+    }
+    uint32_t size = 0;
+    for (int k = 0; k < UPDATE_RANGE; k++) {
+        assert(skipList_i64_search(sl, (int64_t)(INT64_C(-10000) + k)) == present[k]);
+        if (present[k] && (flags & SKIPLIST_INDEXABLE)) {
+            assert(skipList_i64_rank(sl, (int64_t)(INT64_C(-10000) + k)) == size);
+        }
+        size += present[k];
+    }
+    assert(skipList_i64_getSize(sl) == size);
+    // already sorted batches skip the copy
+    for (int i = 0; i < UPDATE_BATCH; i++) keys[i] = (int64_t)(INT64_C(-10000) + 2 * i);
+    skipList_i64_insertBatch(sl, keys, UPDATE_BATCH);
+    assert(skipList_i64_removeBatch(sl, keys, UPDATE_BATCH) == UPDATE_BATCH);
+    assert(skipList_i64_insertBatch(sl, keys, 0) == 0);
+    skipList_i64_destroy(&sl);
+}
+
+void test_batch_updates_i64() {
+    printf("test_batch_updates_i64()\n");
+    printf("[test_batch_updates_i64] unsorted insert and remove batches\n");
+    run_batch_updates_i64(0);
+    run_batch_updates_i64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    printf("[test_batch_updates_i64] putBatch keeps the last value of a key\n");
+    SkipMap_i64 * sm = skipMap_i64_create();
+    skipMap_i64_put(sm, (int64_t)(INT64_C(-10000) + 5), (void *)1);
+    int64_t mkeys[6] = {(int64_t)(INT64_C(-10000) + 9), (int64_t)(INT64_C(-10000) + 5), (int64_t)(INT64_C(-10000) + 7), (int64_t)(INT64_C(-10000) + 9),
+                  (int64_t)(INT64_C(-10000) + 1), (int64_t)(INT64_C(-10000) + 9)};
+    void * mvalues[6] = {(void *)2, (void *)3, (void *)4, (void *)5, (void *)6, (void *)7};
+    assert(skipMap_i64_putBatch(sm, mkeys, mvalues, 6) == 3);
+    assert(skipMap_i64_get(sm, (int64_t)(INT64_C(-10000) + 5)) == (void *)3);
+    assert(skipMap_i64_get(sm, (int64_t)(INT64_C(-10000) + 9)) == (void *)7);
+    assert(skipMap_i64_get(sm, (int64_t)(INT64_C(-10000) + 1)) == (void *)6);
+    int64_t skeys[3] = {(int64_t)(INT64_C(-10000) + 1), (int64_t)(INT64_C(-10000) + 2), (int64_t)(INT64_C(-10000) + 3)};
+    assert(skipMap_i64_putBatch(sm, skeys, mvalues, 3) == 2);
+    assert(skipMap_i64_get(sm, (int64_t)(INT64_C(-10000) + 1)) == (void *)2);
+    struct SM_i64_kv kv;
+    while (skipMap_i64_pop(sm, &kv));
+    skipMap_i64_destroy(&sm);
+    printf("[test_batch_updates_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void run_batch_updates_u64(uint32_t flags) {
+    static bool present[UPDATE_RANGE];
+    static uint64_t keys[UPDATE_BATCH];
+    for (int i = 0; i < UPDATE_RANGE; i++) present[i] = false;
+    SkipList_u64 * sl = skipList_u64_create_with_flags(flags);
+    for (int round = 0; round < 6; round++) {
+        uint32_t expected = 0;
+        bool removing = round % 2 == 1;
+        for (int i = 0; i < UPDATE_BATCH; i++) {
+            int k = rand() % UPDATE_RANGE;
+            keys[i] = (uint64_t)k;
+            if (present[k] == removing) { expected++; present[k] = !removing; }
+        }
+        uint32_t changed = removing ? skipList_u64_removeBatch(sl, keys, UPDATE_BATCH)
+                                    : skipList_u64_insertBatch(sl, keys, UPDATE_BATCH);
+        assert(changed == expected);
+    }
+    uint32_t size = 0;
+    for (int k = 0; k < UPDATE_RANGE; k++) {
+        assert(skipList_u64_search(sl, (uint64_t)k) == present[k]);
+        if (present[k] && (flags & SKIPLIST_INDEXABLE)) {
+            assert(skipList_u64_rank(sl, (uint64_t)k) == size);
+        }
+        size += present[k];
+    }
+    assert(skipList_u64_getSize(sl) == size);
+    // already sorted batches skip the copy
+    for (int i = 0; i < UPDATE_BATCH; i++) keys[i] = (uint64_t)(2 * i);
+    skipList_u64_insertBatch(sl, keys, UPDATE_BATCH);
+    assert(skipList_u64_removeBatch(sl, keys, UPDATE_BATCH) == UPDATE_BATCH);
+    assert(skipList_u64_insertBatch(sl, keys, 0) == 0);
+    skipList_u64_destroy(&sl);
+}
+
+void test_batch_updates_u64() {
+    printf("test_batch_updates_u64()\n");
+    printf("[test_batch_updates_u64] unsorted insert and remove batches\n");
+    run_batch_updates_u64(0);
+    run_batch_updates_u64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    printf("[test_batch_updates_u64] putBatch keeps the last value of a key\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    skipMap_u64_put(sm, 5, (void *)1);
+    uint64_t mkeys[6] = {9, 5, 7, 9,
+                  1, 9};
+    void * mvalues[6] = {(void *)2, (void *)3, (void *)4, (void *)5, (void *)6, (void *)7};
+    assert(skipMap_u64_putBatch(sm, mkeys, mvalues, 6) == 3);
+    assert(skipMap_u64_get(sm, 5) == (void *)3);
+    assert(skipMap_u64_get(sm, 9) == (void *)7);
+    assert(skipMap_u64_get(sm, 1) == (void *)6);
+    uint64_t skeys[3] = {1, 2, 3};
+    assert(skipMap_u64_putBatch(sm, skeys, mvalues, 3) == 2);
+    assert(skipMap_u64_get(sm, 1) == (void *)2);
+    struct SM_u64_kv kv;
+    while (skipMap_u64_pop(sm, &kv));
+    skipMap_u64_destroy(&sm);
+    printf("[test_batch_updates_u64] ✅\n");
+}
+
+
+int main() {
+    srand(42);
+    test_search_many_u64();
+    test_get_many_u64();
+    test_search_sorted_u64();
+    test_get_sorted_u64();
+    test_batch_updates_i32();
+    test_batch_updates_u32();
+    test_batch_updates_i64();
+    test_batch_updates_u64();
+}
@@ -0,0 +1,146 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_SIZE 10000
+#define SEED 42
+
+void test_block_u32() {
+    printf("test_block_u32()\n");
+    SkipListBlock_u32 * sl = skipListBlock_u32_create();
+    assert(skipListBlock_u32_isEmpty(sl));
+
+    printf("[test_block_u32] inserting %d elements in descending order\n", TEST_SIZE);
+    // descending inserts keep replacing the minimum of the first block
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipListBlock_u32_insert(sl, (uint32_t)i));
+    }
+    assert(!skipListBlock_u32_insert(sl, 0));
+    assert(skipListBlock_u32_insert(sl, UINT32_MAX));
+    assert(skipListBlock_u32_search(sl, UINT32_MAX));
+    skipListBlock_u32_remove(sl, UINT32_MAX);
+    assert(!skipListBlock_u32_search(sl, UINT32_MAX));
+    assert(skipListBlock_u32_getSize(sl) == TEST_SIZE);
+    printf("[test_block_u32] removing and reinserting odd elements\n");
+    for (uint32_t i = 1; i < TEST_SIZE; i += 2) {
+        skipListBlock_u32_remove(sl, i);
+        assert(!skipListBlock_u32_search(sl, i));
+    }
+    assert(skipListBlock_u32_getSize(sl) == TEST_SIZE / 2);
+    for (uint32_t i = 1; i < TEST_SIZE; i += 2) {
+        assert(skipListBlock_u32_insert(sl, i));
+    }
+    for (uint32_t i = 0; i < TEST_SIZE; i++) {
+        assert(skipListBlock_u32_search(sl, i));
+    }
+    uint32_t p;
+    for (uint32_t i = 0; i < TEST_SIZE; i++) {
+        assert(skipListBlock_u32_pop(sl, &p) && p == i);
+    }
+    assert(!skipListBlock_u32_pop(sl, &p));
+    skipListBlock_u32_destroy(&sl);
+    assert(sl == NULL);
+
+    // random workload over a small key range so blocks keep splitting and merging
+    printf("[test_block_u32] random workload against SkipList_u32\n");
+    srand(SEED);
+    SkipListBlock_u32 * bl = skipListBlock_u32_create();
+    SkipList_u32 * ref = skipList_u32_create();
+    for (int i = 0; i < TEST_SIZE * 10; i++) {
+        uint32_t key = (uint32_t)(rand() % 2000);
+        switch (rand() % 3) {
+            case 0:
+                assert(skipListBlock_u32_insert(bl, key) == skipList_u32_insert(ref, key));
+                break;
+            case 1:
+                skipListBlock_u32_remove(bl, key);
+                skipList_u32_remove(ref, key);
+                break;
+            default:
+                assert(skipListBlock_u32_search(bl, key) == skipList_u32_search(ref, key));
+                break;
+        }
+        assert(skipListBlock_u32_getSize(bl) == skipList_u32_getSize(ref));
+    }
+    uint32_t a, b;
+    while (skipList_u32_pop(ref, &a)) {
+        assert(skipListBlock_u32_pop(bl, &b) && a == b);
+    }
+    assert(skipListBlock_u32_isEmpty(bl));
+    skipListBlock_u32_destroy(&bl);
+    skipList_u32_destroy(&ref);
+    printf("[test_block_u32] ✅\n");
+}
+
+void test_block_u64() {
+    printf("test_block_u64()\n");
+    SkipListBlock_u64 * sl = skipListBlock_u64_create();
+    assert(skipListBlock_u64_isEmpty(sl));
+
+    printf("[test_block_u64] inserting %d elements in descending order\n", TEST_SIZE);
+    // descending inserts keep replacing the minimum of the first block
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipListBlock_u64_insert(sl, (uint64_t)i));
+    }
+    assert(!skipListBlock_u64_insert(sl, 0));
+    assert(skipListBlock_u64_insert(sl, UINT64_MAX));
+    assert(skipListBlock_u64_search(sl, UINT64_MAX));
+    skipListBlock_u64_remove(sl, UINT64_MAX);
+    assert(!skipListBlock_u64_search(sl, UINT64_MAX));
+    assert(skipListBlock_u64_getSize(sl) == TEST_SIZE);
+    printf("[test_block_u64] removing and reinserting odd elements\n");
+    for (uint64_t i = 1; i < TEST_SIZE; i += 2) {
+        skipListBlock_u64_remove(sl, i);
+        assert(!skipListBlock_u64_search(sl, i));
+    }
+    assert(skipListBlock_u64_getSize(sl) == TEST_SIZE / 2);
+    for (uint64_t i = 1; i < TEST_SIZE; i += 2) {
+        assert(skipListBlock_u64_insert(sl, i));
+    }
+    for (uint64_t i = 0; i < TEST_SIZE; i++) {
+        assert(skipListBlock_u64_search(sl, i));
+    }
+    uint64_t p;
+    for (uint64_t i = 0; i < TEST_SIZE; i++) {
+        assert(skipListBlock_u64_pop(sl, &p) && p == i);
+    }
+    assert(!skipListBlock_u64_pop(sl, &p));
+    skipListBlock_u64_destroy(&sl);
+    assert(sl == NULL);
+
+    // random workload over a small key range so blocks keep splitting and merging
+    printf("[test_block_u64] random workload against SkipList_u64\n");
+    srand(SEED);
+    SkipListBlock_u64 * bl = skipListBlock_u64_create();
+    SkipList_u64 * ref = skipList_u64_create();
+    for (int i = 0; i < TEST_SIZE * 10; i++) {
+        uint64_t key = (uint64_t)(rand() % 2000);
+        switch (rand() % 3) {
+            case 0:
+                assert(skipListBlock_u64_insert(bl, key) == skipList_u64_insert(ref, key));
+                break;
+            case 1:
+                skipListBlock_u64_remove(bl, key);
+                skipList_u64_remove(ref, key);
+                break;
+            default:
+                assert(skipListBlock_u64_search(bl, key) == skipList_u64_search(ref, key));
+                break;
+        }
+        assert(skipListBlock_u64_getSize(bl) == skipList_u64_getSize(ref));
+    }
+    uint64_t a, b;
+    while (skipList_u64_pop(ref, &a)) {
+        assert(skipListBlock_u64_pop(bl, &b) && a == b);
+    }
+    assert(skipListBlock_u64_isEmpty(bl));
+    skipListBlock_u64_destroy(&bl);
+    skipList_u64_destroy(&ref);
+    printf("[test_block_u64] ✅\n");
+}
+
+int main() {
+    test_block_u32();
+    test_block_u64();
+}
@@ -0,0 +1,325 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define TEST_SIZE 30000
+
+// built lists have to behave exactly like inserted ones, including later updates
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void check_built_i32(uint32_t flags) {
+    static int32_t keys[TEST_SIZE];
+    uint32_t n = 0;
+    // ascending with every tenth key repeated
+    for (int i = 0; n < TEST_SIZE; i++) {
+        keys[n++] = (int32_t)(INT64_C(-30000) + 2 * i);
+        if (i % 10 == 0 && n < TEST_SIZE) keys[n++] = (int32_t)(INT64_C(-30000) + 2 * i);
+    }
+    SkipList_i32 * sl = flags == SKIPLIST_ARENA ? skipList_i32_buildFromSorted(keys, n)
+                                                : skipList_i32_buildFromSorted_with_flags(keys, n, flags);
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < n; i++) unique += i == 0 || keys[i] != keys[i - 1];
+    assert(skipList_i32_getSize(sl) == unique);
+    for (uint32_t i = 0; i < unique; i++) {
+        assert(skipList_i32_search(sl, (int32_t)(INT64_C(-30000) + 2 * i)));
+        assert(!skipList_i32_search(sl, (int32_t)(INT64_C(-30000) + 2 * i + 1)));
+    }
+    int32_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < unique; i += 7) {
+            assert(skipList_i32_select(sl, i, &out) && out == (int32_t)(INT64_C(-30000) + 2 * i));
+            assert(skipList_i32_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i32_iter_last(it); skipList_i32_iter_valid(it); skipList_i32_iter_prev(it)) walked++;
+        assert(walked == unique);
+        skipList_i32_iter_destroy(&it);
+    }
+    assert(skipList_i32_peekMax(sl, &out) && out == (int32_t)(INT64_C(-30000) + 2 * (unique - 1)));
+    // later updates see a consistent structure
+    for (uint32_t i = 0; i < unique; i += 3) skipList_i32_remove(sl, (int32_t)(INT64_C(-30000) + 2 * i));
+    for (uint32_t i = 0; i < unique; i += 5) skipList_i32_insert(sl, (int32_t)(INT64_C(-30000) + 2 * i + 1));
+    assert(skipList_i32_popMax(sl, &out));
+    if (flags & SKIPLIST_INDEXABLE) {
+        uint32_t size = skipList_i32_getSize(sl);
+        for (uint32_t i = 0; i < size; i += 11) {
+            assert(skipList_i32_select(sl, i, &out));
+            assert(skipList_i32_rank(sl, out) == i);
+        }
+    }
+    skipList_i32_destroy(&sl);
+}
+
+void test_build_i32() {
+    printf("test_build_i32()\n");
+    printf("[test_build_i32] building with every flag combination\n");
+    check_built_i32(SKIPLIST_ARENA);
+    check_built_i32(0);
+    check_built_i32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    check_built_i32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    SkipList_i32 * empty = skipList_i32_buildFromSorted(NULL, 0);
+    assert(skipList_i32_isEmpty(empty));
+    assert(skipList_i32_insert(empty, (int32_t)INT64_C(-30000)));
+    skipList_i32_destroy(&empty);
+    printf("[test_build_i32] maps take parallel value arrays\n");
+    int32_t keys[5] = {(int32_t)INT64_C(-30000), (int32_t)(INT64_C(-30000) + 1), (int32_t)(INT64_C(-30000) + 1), (int32_t)(INT64_C(-30000) + 4), (int32_t)(INT64_C(-30000) + 9)};
+    void * values[5] = {(void *)1, (void *)2, (void *)3, (void *)4, (void *)5};
+    SkipMap_i32 * sm = skipMap_i32_buildFromSorted_with_flags(keys, values, 5, 0);
+    assert(skipMap_i32_getSize(sm) == 4);
+    assert(skipMap_i32_get(sm, (int32_t)(INT64_C(-30000) + 1)) == (void *)3);
+    assert(skipMap_i32_get(sm, (int32_t)(INT64_C(-30000) + 9)) == (void *)5);
+    struct SM_i32_kv kv;
+    while (skipMap_i32_pop(sm, &kv));
+    skipMap_i32_destroy(&sm);
+    sm = skipMap_i32_buildFromSorted(keys, values, 5);
+    assert(skipMap_i32_popMax(sm, &kv) && kv.value == (void *)5);
+    while (skipMap_i32_pop(sm, &kv));
+    skipMap_i32_destroy(&sm);
+    printf("[test_build_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void check_built_u32(uint32_t flags) {
+    static uint32_t keys[TEST_SIZE];
+    uint32_t n = 0;
+    // ascending with every tenth key repeated
+    for (int i = 0; n < TEST_SIZE; i++) {
+        keys[n++] = (uint32_t)(2 * i);
+        if (i % 10 == 0 && n < TEST_SIZE) keys[n++] = (uint32_t)(2 * i);
+    }
+    SkipList_u32 * sl = flags == SKIPLIST_ARENA ? skipList_u32_buildFromSorted(keys, n)
+                                                : skipList_u32_buildFromSorted_with_flags(keys, n, flags);
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < n; i++) unique += i == 0 || keys[i] != keys[i - 1];
+    assert(skipList_u32_getSize(sl) == unique);
+    for (uint32_t i = 0; i < unique; i++) {
+        assert(skipList_u32_search(sl, (uint32_t)(2 * i)));
+        assert(!skipList_u32_search(sl, (uint32_t)(2 * i + 1)));
+    }
+    uint32_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < unique; i += 7) {
+            assert(skipList_u32_select(sl, i, &out) && out == (uint32_t)(2 * i));
+            assert(skipList_u32_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u32_iter_last(it); skipList_u32_iter_valid(it); skipList_u32_iter_prev(it)) walked++;
+        assert(walked == unique);
+        skipList_u32_iter_destroy(&it);
+    }
+    assert(skipList_u32_peekMax(sl, &out) && out == (uint32_t)(2 * (unique - 1)));
+    // later updates see a consistent structure
+    for (uint32_t i = 0; i < unique; i += 3) skipList_u32_remove(sl, (uint32_t)(2 * i));
+    for (uint32_t i = 0; i < unique; i += 5) skipList_u32_insert(sl, (uint32_t)(2 * i + 1));
+    assert(skipList_u32_popMax(sl, &out));
+    if (flags & SKIPLIST_INDEXABLE) {
+        uint32_t size = skipList_u32_getSize(sl);
+        for (uint32_t i = 0; i < size; i += 11) {
+            assert(skipList_u32_select(sl, i, &out));
+            assert(skipList_u32_rank(sl, out) == i);
+        }
+    }
+    skipList_u32_destroy(&sl);
+}
+
+void test_build_u32() {
+    printf("test_build_u32()\n");
+    printf("[test_build_u32] building with every flag combination\n");
+    check_built_u32(SKIPLIST_ARENA);
+    check_built_u32(0);
+    check_built_u32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    check_built_u32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    SkipList_u32 * empty = skipList_u32_buildFromSorted(NULL, 0);
+    assert(skipList_u32_isEmpty(empty));
+    assert(skipList_u32_insert(empty, 0));
+    skipList_u32_destroy(&empty);
+    printf("[test_build_u32] maps take parallel value arrays\n");
+    uint32_t keys[5] = {0, 1, 1, 4, 9};
+    void * values[5] = {(void *)1, (void *)2, (void *)3, (void *)4, (void *)5};
+    SkipMap_u32 * sm = skipMap_u32_buildFromSorted_with_flags(keys, values, 5, 0);
+    assert(skipMap_u32_getSize(sm) == 4);
+    assert(skipMap_u32_get(sm, 1) == (void *)3);
+    assert(skipMap_u32_get(sm, 9) == (void *)5);
+    struct SM_u32_kv kv;
+    while (skipMap_u32_pop(sm, &kv));
+    skipMap_u32_destroy(&sm);
+    sm = skipMap_u32_buildFromSorted(keys, values, 5);
+    assert(skipMap_u32_popMax(sm, &kv) && kv.value == (void *)5);
+    while (skipMap_u32_pop(sm, &kv));
+    skipMap_u32_destroy(&sm);
+    printf("[test_build_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void check_built_i64(uint32_t flags) {
+    static int64_t keys[TEST_SIZE];
+    uint32_t n = 0;
+    // ascending with every tenth key repeated
+    for (int i = 0; n < TEST_SIZE; i++) {
+        keys[n++] = (int64_t)(INT64_C(-30000) + 2 * i);
+        if (i % 10 == 0 && n < TEST_SIZE) keys[n++] = (int64_t)(INT64_C(-30000) + 2 * i);
+    }
+    SkipList_i64 * sl = flags == SKIPLIST_ARENA ? skipList_i64_buildFromSorted(keys, n)
+                                                : skipList_i64_buildFromSorted_with_flags(keys, n, flags);
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < n; i++) unique += i == 0 || keys[i] != keys[i - 1];
+    assert(skipList_i64_getSize(sl) == unique);
+    for (uint32_t i = 0; i < unique; i++) {
+        assert(skipList_i64_search(sl, (int64_t)(INT64_C(-30000) + 2 * i)));
+        assert(!skipList_i64_search(sl, (int64_t)(INT64_C(-30000) + 2 * i + 1)));
+    }
+    int64_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < unique; i += 7) {
+            assert(skipList_i64_select(sl, i, &out) && out == (int64_t)(INT64_C(-30000) + 2 * i));
+            assert(skipList_i64_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i64_iter_last(it); skipList_i64_iter_valid(it); skipList_i64_iter_prev(it)) walked++;
+        assert(walked == unique);
+        skipList_i64_iter_destroy(&it);
+    }
+    assert(skipList_i64_peekMax(sl, &out) && out == (int64_t)(INT64_C(-30000) + 2 * (unique - 1)));
+    // later updates see a consistent structure
+    for (uint32_t i = 0; i < unique; i += 3) skipList_i64_remove(sl, (int64_t)(INT64_C(-30000) + 2 * i));
+    for (uint32_t i = 0; i < unique; i += 5) skipList_i64_insert(sl, (int64_t)(INT64_C(-30000) + 2 * i + 1));
+    assert(skipList_i64_popMax(sl, &out));
+    if (flags & SKIPLIST_INDEXABLE) {
+        uint32_t size = skipList_i64_getSize(sl);
+        for (uint32_t i = 0; i < size; i += 11) {
+            assert(skipList_i64_select(sl, i, &out));
+            assert(skipList_i64_rank(sl, out) == i);
+        }
+    }
+    skipList_i64_destroy(&sl);
+}
+
+void test_build_i64() {
+    printf("test_build_i64()\n");
+    printf("[test_build_i64] building with every flag combination\n");
+    check_built_i64(SKIPLIST_ARENA);
+    check_built_i64(0);
+    check_built_i64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    check_built_i64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    SkipList_i64 * empty = skipList_i64_buildFromSorted(NULL, 0);
+    assert(skipList_i64_isEmpty(empty));
+    assert(skipList_i64_insert(empty, (int64_t)INT64_C(-30000)));
+    skipList_i64_destroy(&empty);
+    printf("[test_build_i64] maps take parallel value arrays\n");
+    int64_t keys[5] = {(int64_t)INT64_C(-30000), (int64_t)(INT64_C(-30000) + 1), (int64_t)(INT64_C(-30000) + 1), (int64_t)(INT64_C(-30000) + 4), (int64_t)(INT64_C(-30000) + 9)};
+    void * values[5] = {(void *)1, (void *)2, (void *)3, (void *)4, (void *)5};
+    SkipMap_i64 * sm = skipMap_i64_buildFromSorted_with_flags(keys, values, 5, 0);
+    assert(skipMap_i64_getSize(sm) == 4);
+    assert(skipMap_i64_get(sm, (int64_t)(INT64_C(-30000) + 1)) == (void *)3);
+    assert(skipMap_i64_get(sm, (int64_t)(INT64_C(-30000) + 9)) == (void *)5);
+    struct SM_i64_kv kv;
+    while (skipMap_i64_pop(sm, &kv));
+    skipMap_i64_destroy(&sm);
+    sm = skipMap_i64_buildFromSorted(keys, values, 5);
+    assert(skipMap_i64_popMax(sm, &kv) && kv.value == (void *)5);
+    while (skipMap_i64_pop(sm, &kv));
+    skipMap_i64_destroy(&sm);
+    printf("[test_build_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void check_built_u64(uint32_t flags) {
+    static uint64_t keys[TEST_SIZE];
+    uint32_t n = 0;
+    // ascending with every tenth key repeated
+    for (int i = 0; n < TEST_SIZE; i++) {
+        keys[n++] = (uint64_t)(2 * i);
+        if (i % 10 == 0 && n < TEST_SIZE) keys[n++] = (uint64_t)(2 * i);
+    }
+    SkipList_u64 * sl = flags == SKIPLIST_ARENA ? skipList_u64_buildFromSorted(keys, n)
+                                                : skipList_u64_buildFromSorted_with_flags(keys, n, flags);
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < n; i++) unique += i == 0 || keys[i] != keys[i - 1];
+    assert(skipList_u64_getSize(sl) == unique);
+    for (uint32_t i = 0; i < unique; i++) {
+        assert(skipList_u64_search(sl, (uint64_t)(2 * i)));
+        assert(!skipList_u64_search(sl, (uint64_t)(2 * i + 1)));
+    }
+    uint64_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < unique; i += 7) {
+            assert(skipList_u64_select(sl, i, &out) && out == (uint64_t)(2 * i));
+            assert(skipList_u64_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u64_iter_last(it); skipList_u64_iter_valid(it); skipList_u64_iter_prev(it)) walked++;
+        assert(walked == unique);
+        skipList_u64_iter_destroy(&it);
+    }
+    assert(skipList_u64_peekMax(sl, &out) && out == (uint64_t)(2 * (unique - 1)));
+    // later updates see a consistent structure
+    for (uint32_t i = 0; i < unique; i += 3) skipList_u64_remove(sl, (uint64_t)(2 * i));
+    for (uint32_t i = 0; i < unique; i += 5) skipList_u64_insert(sl, (uint64_t)(2 * i + 1));
+    assert(skipList_u64_popMax(sl, &out));
+    if (flags & SKIPLIST_INDEXABLE) {
+        uint32_t size = skipList_u64_getSize(sl);
+        for (uint32_t i = 0; i < size; i += 11) {
+            assert(skipList_u64_select(sl, i, &out));
+            assert(skipList_u64_rank(sl, out) == i);
+        }
+    }
+    skipList_u64_destroy(&sl);
+}
+
+void test_build_u64() {
+    printf("test_build_u64()\n");
+    printf("[test_build_u64] building with every flag combination\n");
+    check_built_u64(SKIPLIST_ARENA);
+    check_built_u64(0);
+    check_built_u64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    check_built_u64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    SkipList_u64 * empty = skipList_u64_buildFromSorted(NULL, 0);
+    assert(skipList_u64_isEmpty(empty));
+    assert(skipList_u64_insert(empty, 0));
+    skipList_u64_destroy(&empty);
+    printf("[test_build_u64] maps take parallel value arrays\n");
+    uint64_t keys[5] = {0, 1, 1, 4, 9};
+    void * values[5] = {(void *)1, (void *)2, (void *)3, (void *)4, (void *)5};
+    SkipMap_u64 * sm = skipMap_u64_buildFromSorted_with_flags(keys, values, 5, 0);
+    assert(skipMap_u64_getSize(sm) == 4);
+    assert(skipMap_u64_get(sm, 1) == (void *)3);
+    assert(skipMap_u64_get(sm, 9) == (void *)5);
+    struct SM_u64_kv kv;
+    while (skipMap_u64_pop(sm, &kv));
+    skipMap_u64_destroy(&sm);
+    sm = skipMap_u64_buildFromSorted(keys, values, 5);
+    assert(skipMap_u64_popMax(sm, &kv) && kv.value == (void *)5);
+    while (skipMap_u64_pop(sm, &kv));
+    skipMap_u64_destroy(&sm);
+    printf("[test_build_u64] ✅\n");
+}
+
+
+int main() {
+    test_build_i32();
+    test_build_u32();
+    test_build_i64();
+    test_build_u64();
+    return 0;
+}
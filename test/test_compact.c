@@ -0,0 +1,81 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define TEST_SIZE 10000
+#define SEED 42
+
+void test_compact_basic() {
+    printf("test_compact_basic()\n");
+    SkipListCompact_u32 * sl = skipListCompact_u32_create();
+    assert(skipListCompact_u32_isEmpty(sl));
+
+    printf("[test_compact_basic] inserting %d elements\n", TEST_SIZE);
+    for (uint32_t i = 0; i < TEST_SIZE; i++) {
+        assert(skipListCompact_u32_insert(sl, i));
+    }
+    // 0 is a legal key, the header owning index 0 must not shadow it
+    assert(!skipListCompact_u32_insert(sl, 0));
+    assert(skipListCompact_u32_getSize(sl) == TEST_SIZE);
+    printf("[test_compact_basic] removing and reinserting odd elements\n");
+    for (uint32_t i = 1; i < TEST_SIZE; i += 2) {
+        skipListCompact_u32_remove(sl, i);
+        assert(!skipListCompact_u32_search(sl, i));
+    }
+    assert(skipListCompact_u32_getSize(sl) == TEST_SIZE / 2);
+    for (uint32_t i = 1; i < TEST_SIZE; i += 2) {
+        assert(skipListCompact_u32_insert(sl, i));
+    }
+    for (uint32_t i = 0; i < TEST_SIZE; i++) {
+        assert(skipListCompact_u32_search(sl, i));
+    }
+    assert(!skipListCompact_u32_search(sl, TEST_SIZE));
+    assert(!skipListCompact_u32_search(sl, UINT32_MAX));
+    uint32_t p;
+    for (uint32_t i = 0; i < TEST_SIZE; i++) {
+        assert(skipListCompact_u32_pop(sl, &p) && p == i);
+    }
+    assert(!skipListCompact_u32_pop(sl, &p));
+    assert(skipListCompact_u32_isEmpty(sl));
+    skipListCompact_u32_destroy(&sl);
+    assert(sl == NULL);
+    printf("[test_compact_basic] ✅\n");
+}
+
+// random workload checked against the pointer based list
+void test_compact_matches_u32() {
+    printf("test_compact_matches_u32()\n");
+    srand(SEED);
+    SkipListCompact_u32 * cl = skipListCompact_u32_create();
+    SkipList_u32 * sl = skipList_u32_create();
+    for (int i = 0; i < TEST_SIZE * 4; i++) {
+        uint32_t key = (uint32_t)rand() % (TEST_SIZE * 2);
+        switch (rand() % 3) {
+            case 0:
+                assert(skipListCompact_u32_insert(cl, key) == skipList_u32_insert(sl, key));
+                break;
+            case 1:
+                skipListCompact_u32_remove(cl, key);
+                skipList_u32_remove(sl, key);
+                break;
+            default:
+                assert(skipListCompact_u32_search(cl, key) == skipList_u32_search(sl, key));
+                break;
+        }
+        assert(skipListCompact_u32_getSize(cl) == skipList_u32_getSize(sl));
+    }
+    uint32_t a, b;
+    while (skipList_u32_pop(sl, &a)) {
+        assert(skipListCompact_u32_pop(cl, &b) && a == b);
+    }
+    assert(skipListCompact_u32_isEmpty(cl));
+    skipListCompact_u32_destroy(&cl);
+    skipList_u32_destroy(&sl);
+    printf("[test_compact_matches_u32] ✅\n");
+}
+
+int main() {
+    test_compact_basic();
+    test_compact_matches_u32();
+}
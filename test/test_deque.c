@@ -0,0 +1,363 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define OPS 20000
+#define KEY_RANGE 3000
+
+// present[] is the reference set, min and max are found by scanning it
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void run_deque_i32(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_i32 * sl = skipList_i32_create_with_flags(flags);
+    int32_t out;
+    assert(!skipList_i32_peekMin(sl, &out) && !skipList_i32_peekMax(sl, &out));
+    assert(!skipList_i32_popMax(sl, &out));
+    for (int op = 0; op < OPS; op++) {
+        int k = rand() % KEY_RANGE;
+        switch (rand() % 6) {
+            case 0:
+            case 1:
+            case 2: skipList_i32_insert(sl, (int32_t)(-1500 + k)); present[k] = true; break;
+            case 3: skipList_i32_remove(sl, (int32_t)(-1500 + k)); present[k] = false; break;
+            case 4: {
+                int hi = KEY_RANGE - 1;
+                while (hi >= 0 && !present[hi]) hi--;
+                assert(skipList_i32_popMax(sl, &out) == (hi >= 0));
+                if (hi >= 0) { assert(out == (int32_t)(-1500 + hi)); present[hi] = false; }
+                break;
+            }
+            default: {
+                int lo = 0;
+                while (lo < KEY_RANGE && !present[lo]) lo++;
+                assert(skipList_i32_pop(sl, &out) == (lo < KEY_RANGE));
+                if (lo < KEY_RANGE) { assert(out == (int32_t)(-1500 + lo)); present[lo] = false; }
+                break;
+            }
+        }
+        int lo = 0, hi = KEY_RANGE - 1;
+        while (lo < KEY_RANGE && !present[lo]) lo++;
+        while (hi >= 0 && !present[hi]) hi--;
+        assert(skipList_i32_peekMin(sl, &out) == (lo < KEY_RANGE));
+        if (lo < KEY_RANGE) assert(out == (int32_t)(-1500 + lo));
+        assert(skipList_i32_peekMax(sl, &out) == (hi >= 0));
+        if (hi >= 0) assert(out == (int32_t)(-1500 + hi));
+    }
+    uint32_t n = skipList_i32_getSize(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i32_select(sl, i, &out));
+            assert(skipList_i32_rank(sl, out) == i);
+        }
+    }
+    SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+    skipList_i32_iter_last(it);
+    uint32_t walked = 0;
+    if (flags & SKIPLIST_BACKLINKS) {
+        for (; skipList_i32_iter_valid(it); skipList_i32_iter_prev(it)) walked++;
+        assert(walked == n);
+    }
+    skipList_i32_iter_destroy(&it);
+    while (skipList_i32_popMax(sl, &out)) n--;
+    assert(n == 0 && skipList_i32_isEmpty(sl));
+    assert(!skipList_i32_peekMax(sl, &out));
+    skipList_i32_insert(sl, (int32_t)-1500);
+    assert(skipList_i32_peekMax(sl, &out) && out == (int32_t)-1500);
+    skipList_i32_destroy(&sl);
+}
+
+void test_deque_i32() {
+    printf("test_deque_i32()\n");
+    printf("[test_deque_i32] random mix against a reference set\n");
+    run_deque_i32(0);
+    run_deque_i32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_deque_i32(SKIPLIST_ARENA);
+    printf("[test_deque_i32] maps\n");
+    SkipMap_i32 * sm = skipMap_i32_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_i32_put(sm, (int32_t)(-1500 + i), (void *)(intptr_t)i);
+    }
+    struct SM_i32_kv kv;
+    assert(skipMap_i32_peekMin(sm, &kv) && kv.value == (void *)(intptr_t)1);
+    assert(skipMap_i32_peekMax(sm, &kv) && kv.value == (void *)(intptr_t)100);
+    for (int i = 100; i > 0; i--) {
+        assert(skipMap_i32_popMax(sm, &kv));
+        assert(kv.key == (int32_t)(-1500 + i) && kv.value == (void *)(intptr_t)i);
+    }
+    assert(!skipMap_i32_popMax(sm, &kv) && !skipMap_i32_peekMin(sm, &kv));
+    skipMap_i32_destroy(&sm);
+    printf("[test_deque_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void run_deque_u32(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_u32 * sl = skipList_u32_create_with_flags(flags);
+    uint32_t out;
+    assert(!skipList_u32_peekMin(sl, &out) && !skipList_u32_peekMax(sl, &out));
+    assert(!skipList_u32_popMax(sl, &out));
+    for (int op = 0; op < OPS; op++) {
+        int k = rand() % KEY_RANGE;
+        switch (rand() % 6) {
+            case 0:
+            case 1:
+            case 2: skipList_u32_insert(sl, (uint32_t)k); present[k] = true; break;
+            case 3: skipList_u32_remove(sl, (uint32_t)k); present[k] = false; break;
+            case 4: {
+                int hi = KEY_RANGE - 1;
+                while (hi >= 0 && !present[hi]) hi--;
+                assert(skipList_u32_popMax(sl, &out) == (hi >= 0));
+                if (hi >= 0) { assert(out == (uint32_t)hi); present[hi] = false; }
+                break;
+            }
+            default: {
+                int lo = 0;
+                while (lo < KEY_RANGE && !present[lo]) lo++;
+                assert(skipList_u32_pop(sl, &out) == (lo < KEY_RANGE));
+                if (lo < KEY_RANGE) { assert(out == (uint32_t)lo); present[lo] = false; }
+                break;
+            }
+        }
+        int lo = 0, hi = KEY_RANGE - 1;
+        while (lo < KEY_RANGE && !present[lo]) lo++;
+        while (hi >= 0 && !present[hi]) hi--;
+        assert(skipList_u32_peekMin(sl, &out) == (lo < KEY_RANGE));
+        if (lo < KEY_RANGE) assert(out == (uint32_t)lo);
+        assert(skipList_u32_peekMax(sl, &out) == (hi >= 0));
+        if (hi >= 0) assert(out == (uint32_t)hi);
+    }
+    uint32_t n = skipList_u32_getSize(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u32_select(sl, i, &out));
+            assert(skipList_u32_rank(sl, out) == i);
+        }
+    }
+    SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+    skipList_u32_iter_last(it);
+    uint32_t walked = 0;
+    if (flags & SKIPLIST_BACKLINKS) {
+        for (; skipList_u32_iter_valid(it); skipList_u32_iter_prev(it)) walked++;
+        assert(walked == n);
+    }
+    skipList_u32_iter_destroy(&it);
+    while (skipList_u32_popMax(sl, &out)) n--;
+    assert(n == 0 && skipList_u32_isEmpty(sl));
+    assert(!skipList_u32_peekMax(sl, &out));
+    skipList_u32_insert(sl, 0);
+    assert(skipList_u32_peekMax(sl, &out) && out == 0);
+    skipList_u32_destroy(&sl);
+}
+
+void test_deque_u32() {
+    printf("test_deque_u32()\n");
+    printf("[test_deque_u32] random mix against a reference set\n");
+    run_deque_u32(0);
+    run_deque_u32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_deque_u32(SKIPLIST_ARENA);
+    printf("[test_deque_u32] maps\n");
+    SkipMap_u32 * sm = skipMap_u32_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_u32_put(sm, (uint32_t)i, (void *)(intptr_t)i);
+    }
+    struct SM_u32_kv kv;
+    assert(skipMap_u32_peekMin(sm, &kv) && kv.value == (void *)(intptr_t)1);
+    assert(skipMap_u32_peekMax(sm, &kv) && kv.value == (void *)(intptr_t)100);
+    for (int i = 100; i > 0; i--) {
+        assert(skipMap_u32_popMax(sm, &kv));
+        assert(kv.key == (uint32_t)i && kv.value == (void *)(intptr_t)i);
+    }
+    assert(!skipMap_u32_popMax(sm, &kv) && !skipMap_u32_peekMin(sm, &kv));
+    skipMap_u32_destroy(&sm);
+    printf("[test_deque_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void run_deque_i64(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_i64 * sl = skipList_i64_create_with_flags(flags);
+    int64_t out;
+    assert(!skipList_i64_peekMin(sl, &out) && !skipList_i64_peekMax(sl, &out));
+    assert(!skipList_i64_popMax(sl, &out));
+    for (int op = 0; op < OPS; op++) {
+        int k = rand() % KEY_RANGE;
+        switch (rand() % 6) {
+            case 0:
+            case 1:
+            case 2: skipList_i64_insert(sl, (int64_t)(-1500 + k)); present[k] = true; break;
+            case 3: skipList_i64_remove(sl, (int64_t)(-1500 + k)); present[k] = false; break;
+            case 4: {
+                int hi = KEY_RANGE - 1;
+                while (hi >= 0 && !present[hi]) hi--;
+                assert(skipList_i64_popMax(sl, &out) == (hi >= 0));
+                if (hi >= 0) { assert(out == (int64_t)(-1500 + hi)); present[hi] = false; }
+                break;
+            }
+            default: {
+                int lo = 0;
+                while (lo < KEY_RANGE && !present[lo]) lo++;
+                assert(skipList_i64_pop(sl, &out) == (lo < KEY_RANGE));
+                if (lo < KEY_RANGE) { assert(out == (int64_t)(-1500 + lo)); present[lo] = false; }
+                break;
+            }
+        }
+        int lo = 0, hi = KEY_RANGE - 1;
+        while (lo < KEY_RANGE && !present[lo]) lo++;
+        while (hi >= 0 && !present[hi]) hi--;
+        assert(skipList_i64_peekMin(sl, &out) == (lo < KEY_RANGE));
+        if (lo < KEY_RANGE) assert(out == (int64_t)(-1500 + lo));
+        assert(skipList_i64_peekMax(sl, &out) == (hi >= 0));
+        if (hi >= 0) assert(out == (int64_t)(-1500 + hi));
+    }
+    uint32_t n = skipList_i64_getSize(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i64_select(sl, i, &out));
+            assert(skipList_i64_rank(sl, out) == i);
+        }
+    }
+    SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+    skipList_i64_iter_last(it);
+    uint32_t walked = 0;
+    if (flags & SKIPLIST_BACKLINKS) {
+        for (; skipList_i64_iter_valid(it); skipList_i64_iter_prev(it)) walked++;
+        assert(walked == n);
+    }
+    skipList_i64_iter_destroy(&it);
+    while (skipList_i64_popMax(sl, &out)) n--;
+    assert(n == 0 && skipList_i64_isEmpty(sl));
+    assert(!skipList_i64_peekMax(sl, &out));
+    skipList_i64_insert(sl, (int64_t)-1500);
+    assert(skipList_i64_peekMax(sl, &out) && out == (int64_t)-1500);
+    skipList_i64_destroy(&sl);
+}
+
+void test_deque_i64() {
+    printf("test_deque_i64()\n");
+    printf("[test_deque_i64] random mix against a reference set\n");
+    run_deque_i64(0);
+    run_deque_i64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_deque_i64(SKIPLIST_ARENA);
+    printf("[test_deque_i64] maps\n");
+    SkipMap_i64 * sm = skipMap_i64_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_i64_put(sm, (int64_t)(-1500 + i), (void *)(intptr_t)i);
+    }
+    struct SM_i64_kv kv;
+    assert(skipMap_i64_peekMin(sm, &kv) && kv.value == (void *)(intptr_t)1);
+    assert(skipMap_i64_peekMax(sm, &kv) && kv.value == (void *)(intptr_t)100);
+    for (int i = 100; i > 0; i--) {
+        assert(skipMap_i64_popMax(sm, &kv));
+        assert(kv.key == (int64_t)(-1500 + i) && kv.value == (void *)(intptr_t)i);
+    }
+    assert(!skipMap_i64_popMax(sm, &kv) && !skipMap_i64_peekMin(sm, &kv));
+    skipMap_i64_destroy(&sm);
+    printf("[test_deque_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void run_deque_u64(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_u64 * sl = skipList_u64_create_with_flags(flags);
+    uint64_t out;
+    assert(!skipList_u64_peekMin(sl, &out) && !skipList_u64_peekMax(sl, &out));
+    assert(!skipList_u64_popMax(sl, &out));
+    for (int op = 0; op < OPS; op++) {
+        int k = rand() % KEY_RANGE;
+        switch (rand() % 6) {
+            case 0:
+            case 1:
+            case 2: skipList_u64_insert(sl, (uint64_t)k); present[k] = true; break;
+            case 3: skipList_u64_remove(sl, (uint64_t)k); present[k] = false; break;
+            case 4: {
+                int hi = KEY_RANGE - 1;
+                while (hi >= 0 && !present[hi]) hi--;
+                assert(skipList_u64_popMax(sl, &out) == (hi >= 0));
+                if (hi >= 0) { assert(out == (uint64_t)hi); present[hi] = false; }
+                break;
+            }
+            default: {
+                int lo = 0;
+                while (lo < KEY_RANGE && !present[lo]) lo++;
+                assert(skipList_u64_pop(sl, &out) == (lo < KEY_RANGE));
+                if (lo < KEY_RANGE) { assert(out == (uint64_t)lo); present[lo] = false; }
+                break;
+            }
+        }
+        int lo = 0, hi = KEY_RANGE - 1;
+        while (lo < KEY_RANGE && !present[lo]) lo++;
+        while (hi >= 0 && !present[hi]) hi--;
+        assert(skipList_u64_peekMin(sl, &out) == (lo < KEY_RANGE));
+        if (lo < KEY_RANGE) assert(out == (uint64_t)lo);
+        assert(skipList_u64_peekMax(sl, &out) == (hi >= 0));
+        if (hi >= 0) assert(out == (uint64_t)hi);
+    }
+    uint32_t n = skipList_u64_getSize(sl);
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u64_select(sl, i, &out));
+            assert(skipList_u64_rank(sl, out) == i);
+        }
+    }
+    SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+    skipList_u64_iter_last(it);
+    uint32_t walked = 0;
+    if (flags & SKIPLIST_BACKLINKS) {
+        for (; skipList_u64_iter_valid(it); skipList_u64_iter_prev(it)) walked++;
+        assert(walked == n);
+    }
+    skipList_u64_iter_destroy(&it);
+    while (skipList_u64_popMax(sl, &out)) n--;
+    assert(n == 0 && skipList_u64_isEmpty(sl));
+    assert(!skipList_u64_peekMax(sl, &out));
+    skipList_u64_insert(sl, 0);
+    assert(skipList_u64_peekMax(sl, &out) && out == 0);
+    skipList_u64_destroy(&sl);
+}
+
+void test_deque_u64() {
+    printf("test_deque_u64()\n");
+    printf("[test_deque_u64] random mix against a reference set\n");
+    run_deque_u64(0);
+    run_deque_u64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_deque_u64(SKIPLIST_ARENA);
+    printf("[test_deque_u64] maps\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_u64_put(sm, (uint64_t)i, (void *)(intptr_t)i);
+    }
+    struct SM_u64_kv kv;
+    assert(skipMap_u64_peekMin(sm, &kv) && kv.value == (void *)(intptr_t)1);
+    assert(skipMap_u64_peekMax(sm, &kv) && kv.value == (void *)(intptr_t)100);
+    for (int i = 100; i > 0; i--) {
+        assert(skipMap_u64_popMax(sm, &kv));
+        assert(kv.key == (uint64_t)i && kv.value == (void *)(intptr_t)i);
+    }
+    assert(!skipMap_u64_popMax(sm, &kv) && !skipMap_u64_peekMin(sm, &kv));
+    skipMap_u64_destroy(&sm);
+    printf("[test_deque_u64] ✅\n");
+}
+
+
+int main() {
+    test_deque_i32();
+    test_deque_u32();
+    test_deque_i64();
+    test_deque_u64();
+    return 0;
+}
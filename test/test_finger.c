@@ -0,0 +1,341 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define TEST_SIZE 20000
+
+// every finger result is checked against the plain search on the same list
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+void test_finger_list_i32() {
+    printf("test_finger_list_i32()\n");
+    SkipList_i32 * sl = skipList_i32_create();
+    SkipListFinger_i32 * f = skipList_i32_finger_create(sl);
+    printf("[test_finger_list_i32] sequential inserts through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        assert(skipList_i32_finger_insert(f, (int32_t)i));
+    }
+    assert(!skipList_i32_finger_insert(f, 0));
+    assert(skipList_i32_getSize(sl) == TEST_SIZE / 2);
+    printf("[test_finger_list_i32] backward walk and local jumps\n");
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_i32_finger_search(f, (int32_t)i) == ((i & 1) == 0));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int32_t key = (int32_t)((i * 7919) % TEST_SIZE);
+        assert(skipList_i32_finger_search(f, key) == skipList_i32_search(sl, key));
+    }
+    printf("[test_finger_list_i32] mixing finger and list modifications\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int32_t key = (int32_t)(rand() % TEST_SIZE);
+        switch (rand() % 4) {
+            case 0: skipList_i32_insert(sl, key); break;
+            case 1: skipList_i32_remove(sl, key); break;
+            case 2: skipList_i32_finger_insert(f, key); break;
+            default: skipList_i32_finger_remove(f, key); break;
+        }
+        int32_t probe = (int32_t)(rand() % TEST_SIZE);
+        assert(skipList_i32_finger_search(f, probe) == skipList_i32_search(sl, probe));
+    }
+    printf("[test_finger_list_i32] removing everything through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_i32_finger_remove(f, (int32_t)i);
+    }
+    assert(skipList_i32_isEmpty(sl));
+    assert(skipList_i32_finger_insert(f, 5));
+    assert(skipList_i32_search(sl, 5));
+    skipList_i32_finger_destroy(&f);
+    assert(f == NULL);
+    skipList_i32_destroy(&sl);
+    printf("[test_finger_list_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+void test_finger_list_u32() {
+    printf("test_finger_list_u32()\n");
+    SkipList_u32 * sl = skipList_u32_create();
+    SkipListFinger_u32 * f = skipList_u32_finger_create(sl);
+    printf("[test_finger_list_u32] sequential inserts through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        assert(skipList_u32_finger_insert(f, (uint32_t)i));
+    }
+    assert(!skipList_u32_finger_insert(f, 0));
+    assert(skipList_u32_getSize(sl) == TEST_SIZE / 2);
+    printf("[test_finger_list_u32] backward walk and local jumps\n");
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_u32_finger_search(f, (uint32_t)i) == ((i & 1) == 0));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint32_t key = (uint32_t)((i * 7919) % TEST_SIZE);
+        assert(skipList_u32_finger_search(f, key) == skipList_u32_search(sl, key));
+    }
+    printf("[test_finger_list_u32] mixing finger and list modifications\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint32_t key = (uint32_t)(rand() % TEST_SIZE);
+        switch (rand() % 4) {
+            case 0: skipList_u32_insert(sl, key); break;
+            case 1: skipList_u32_remove(sl, key); break;
+            case 2: skipList_u32_finger_insert(f, key); break;
+            default: skipList_u32_finger_remove(f, key); break;
+        }
+        uint32_t probe = (uint32_t)(rand() % TEST_SIZE);
+        assert(skipList_u32_finger_search(f, probe) == skipList_u32_search(sl, probe));
+    }
+    printf("[test_finger_list_u32] removing everything through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_u32_finger_remove(f, (uint32_t)i);
+    }
+    assert(skipList_u32_isEmpty(sl));
+    assert(skipList_u32_finger_insert(f, 5));
+    assert(skipList_u32_search(sl, 5));
+    skipList_u32_finger_destroy(&f);
+    assert(f == NULL);
+    skipList_u32_destroy(&sl);
+    printf("[test_finger_list_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+void test_finger_list_i64() {
+    printf("test_finger_list_i64()\n");
+    SkipList_i64 * sl = skipList_i64_create();
+    SkipListFinger_i64 * f = skipList_i64_finger_create(sl);
+    printf("[test_finger_list_i64] sequential inserts through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        assert(skipList_i64_finger_insert(f, (int64_t)i));
+    }
+    assert(!skipList_i64_finger_insert(f, 0));
+    assert(skipList_i64_getSize(sl) == TEST_SIZE / 2);
+    printf("[test_finger_list_i64] backward walk and local jumps\n");
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_i64_finger_search(f, (int64_t)i) == ((i & 1) == 0));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int64_t key = (int64_t)((i * 7919) % TEST_SIZE);
+        assert(skipList_i64_finger_search(f, key) == skipList_i64_search(sl, key));
+    }
+    printf("[test_finger_list_i64] mixing finger and list modifications\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int64_t key = (int64_t)(rand() % TEST_SIZE);
+        switch (rand() % 4) {
+            case 0: skipList_i64_insert(sl, key); break;
+            case 1: skipList_i64_remove(sl, key); break;
+            case 2: skipList_i64_finger_insert(f, key); break;
+            default: skipList_i64_finger_remove(f, key); break;
+        }
+        int64_t probe = (int64_t)(rand() % TEST_SIZE);
+        assert(skipList_i64_finger_search(f, probe) == skipList_i64_search(sl, probe));
+    }
+    printf("[test_finger_list_i64] removing everything through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_i64_finger_remove(f, (int64_t)i);
+    }
+    assert(skipList_i64_isEmpty(sl));
+    assert(skipList_i64_finger_insert(f, 5));
+    assert(skipList_i64_search(sl, 5));
+    skipList_i64_finger_destroy(&f);
+    assert(f == NULL);
+    skipList_i64_destroy(&sl);
+    printf("[test_finger_list_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+void test_finger_list_u64() {
+    printf("test_finger_list_u64()\n");
+    SkipList_u64 * sl = skipList_u64_create();
+    SkipListFinger_u64 * f = skipList_u64_finger_create(sl);
+    printf("[test_finger_list_u64] sequential inserts through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i += 2) {
+        assert(skipList_u64_finger_insert(f, (uint64_t)i));
+    }
+    assert(!skipList_u64_finger_insert(f, 0));
+    assert(skipList_u64_getSize(sl) == TEST_SIZE / 2);
+    printf("[test_finger_list_u64] backward walk and local jumps\n");
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_u64_finger_search(f, (uint64_t)i) == ((i & 1) == 0));
+    }
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint64_t key = (uint64_t)((i * 7919) % TEST_SIZE);
+        assert(skipList_u64_finger_search(f, key) == skipList_u64_search(sl, key));
+    }
+    printf("[test_finger_list_u64] mixing finger and list modifications\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint64_t key = (uint64_t)(rand() % TEST_SIZE);
+        switch (rand() % 4) {
+            case 0: skipList_u64_insert(sl, key); break;
+            case 1: skipList_u64_remove(sl, key); break;
+            case 2: skipList_u64_finger_insert(f, key); break;
+            default: skipList_u64_finger_remove(f, key); break;
+        }
+        uint64_t probe = (uint64_t)(rand() % TEST_SIZE);
+        assert(skipList_u64_finger_search(f, probe) == skipList_u64_search(sl, probe));
+    }
+    printf("[test_finger_list_u64] removing everything through the finger\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_u64_finger_remove(f, (uint64_t)i);
+    }
+    assert(skipList_u64_isEmpty(sl));
+    assert(skipList_u64_finger_insert(f, 5));
+    assert(skipList_u64_search(sl, 5));
+    skipList_u64_finger_destroy(&f);
+    assert(f == NULL);
+    skipList_u64_destroy(&sl);
+    printf("[test_finger_list_u64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+void test_finger_map_i32() {
+    printf("test_finger_map_i32()\n");
+    SkipMap_i32 * sm = skipMap_i32_create();
+    SkipListFinger_i32 * f = skipMap_i32_finger_create(sm);
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        assert(skipMap_i32_finger_put(f, (int32_t)i, (void *)(intptr_t)i));
+    }
+    printf("[test_finger_map_i32] put overwrites existing values\n");
+    assert(skipMap_i32_finger_put(f, 3, (void *)(intptr_t)33));
+    assert(skipMap_i32_get(sm, 3) == (void *)(intptr_t)33);
+    for (int i = TEST_SIZE; i > 3; i--) {
+        assert(skipMap_i32_finger_get(f, (int32_t)i) == (void *)(intptr_t)i);
+    }
+    assert(skipMap_i32_finger_get(f, 0) == NULL);
+    printf("[test_finger_map_i32] removals return the stored value\n");
+    skipMap_i32_remove(sm, 10);
+    assert(skipMap_i32_finger_get(f, 10) == NULL);
+    assert(skipMap_i32_finger_remove(f, 11) == (void *)(intptr_t)11);
+    assert(skipMap_i32_finger_remove(f, 11) == NULL);
+    assert(skipMap_i32_get(sm, 12) == (void *)(intptr_t)12);
+    assert(skipMap_i32_getSize(sm) == TEST_SIZE - 2);
+    // destroy frees stored values, so drain the fake pointers first
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        skipMap_i32_finger_remove(f, (int32_t)i);
+    }
+    assert(skipMap_i32_isEmpty(sm));
+    skipList_i32_finger_destroy(&f);
+    skipMap_i32_destroy(&sm);
+    printf("[test_finger_map_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+void test_finger_map_u32() {
+    printf("test_finger_map_u32()\n");
+    SkipMap_u32 * sm = skipMap_u32_create();
+    SkipListFinger_u32 * f = skipMap_u32_finger_create(sm);
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        assert(skipMap_u32_finger_put(f, (uint32_t)i, (void *)(intptr_t)i));
+    }
+    printf("[test_finger_map_u32] put overwrites existing values\n");
+    assert(skipMap_u32_finger_put(f, 3, (void *)(intptr_t)33));
+    assert(skipMap_u32_get(sm, 3) == (void *)(intptr_t)33);
+    for (int i = TEST_SIZE; i > 3; i--) {
+        assert(skipMap_u32_finger_get(f, (uint32_t)i) == (void *)(intptr_t)i);
+    }
+    assert(skipMap_u32_finger_get(f, 0) == NULL);
+    printf("[test_finger_map_u32] removals return the stored value\n");
+    skipMap_u32_remove(sm, 10);
+    assert(skipMap_u32_finger_get(f, 10) == NULL);
+    assert(skipMap_u32_finger_remove(f, 11) == (void *)(intptr_t)11);
+    assert(skipMap_u32_finger_remove(f, 11) == NULL);
+    assert(skipMap_u32_get(sm, 12) == (void *)(intptr_t)12);
+    assert(skipMap_u32_getSize(sm) == TEST_SIZE - 2);
+    // destroy frees stored values, so drain the fake pointers first
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        skipMap_u32_finger_remove(f, (uint32_t)i);
+    }
+    assert(skipMap_u32_isEmpty(sm));
+    skipList_u32_finger_destroy(&f);
+    skipMap_u32_destroy(&sm);
+    printf("[test_finger_map_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+void test_finger_map_i64() {
+    printf("test_finger_map_i64()\n");
+    SkipMap_i64 * sm = skipMap_i64_create();
+    SkipListFinger_i64 * f = skipMap_i64_finger_create(sm);
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        assert(skipMap_i64_finger_put(f, (int64_t)i, (void *)(intptr_t)i));
+    }
+    printf("[test_finger_map_i64] put overwrites existing values\n");
+    assert(skipMap_i64_finger_put(f, 3, (void *)(intptr_t)33));
+    assert(skipMap_i64_get(sm, 3) == (void *)(intptr_t)33);
+    for (int i = TEST_SIZE; i > 3; i--) {
+        assert(skipMap_i64_finger_get(f, (int64_t)i) == (void *)(intptr_t)i);
+    }
+    assert(skipMap_i64_finger_get(f, 0) == NULL);
+    printf("[test_finger_map_i64] removals return the stored value\n");
+    skipMap_i64_remove(sm, 10);
+    assert(skipMap_i64_finger_get(f, 10) == NULL);
+    assert(skipMap_i64_finger_remove(f, 11) == (void *)(intptr_t)11);
+    assert(skipMap_i64_finger_remove(f, 11) == NULL);
+    assert(skipMap_i64_get(sm, 12) == (void *)(intptr_t)12);
+    assert(skipMap_i64_getSize(sm) == TEST_SIZE - 2);
+    // destroy frees stored values, so drain the fake pointers first
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        skipMap_i64_finger_remove(f, (int64_t)i);
+    }
+    assert(skipMap_i64_isEmpty(sm));
+    skipList_i64_finger_destroy(&f);
+    skipMap_i64_destroy(&sm);
+    printf("[test_finger_map_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+void test_finger_map_u64() {
+    printf("test_finger_map_u64()\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    SkipListFinger_u64 * f = skipMap_u64_finger_create(sm);
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        assert(skipMap_u64_finger_put(f, (uint64_t)i, (void *)(intptr_t)i));
+    }
+    printf("[test_finger_map_u64] put overwrites existing values\n");
+    assert(skipMap_u64_finger_put(f, 3, (void *)(intptr_t)33));
+    assert(skipMap_u64_get(sm, 3) == (void *)(intptr_t)33);
+    for (int i = TEST_SIZE; i > 3; i--) {
+        assert(skipMap_u64_finger_get(f, (uint64_t)i) == (void *)(intptr_t)i);
+    }
+    assert(skipMap_u64_finger_get(f, 0) == NULL);
+    printf("[test_finger_map_u64] removals return the stored value\n");
+    skipMap_u64_remove(sm, 10);
+    assert(skipMap_u64_finger_get(f, 10) == NULL);
+    assert(skipMap_u64_finger_remove(f, 11) == (void *)(intptr_t)11);
+    assert(skipMap_u64_finger_remove(f, 11) == NULL);
+    assert(skipMap_u64_get(sm, 12) == (void *)(intptr_t)12);
+    assert(skipMap_u64_getSize(sm) == TEST_SIZE - 2);
+    // destroy frees stored values, so drain the fake pointers first
+    for (int i = 1; i <= TEST_SIZE; i++) {
+        skipMap_u64_finger_remove(f, (uint64_t)i);
+    }
+    assert(skipMap_u64_isEmpty(sm));
+    skipList_u64_finger_destroy(&f);
+    skipMap_u64_destroy(&sm);
+    printf("[test_finger_map_u64] ✅\n");
+}
+
+
+int main() {
+    test_finger_list_i32();
+    test_finger_list_u32();
+    test_finger_list_i64();
+    test_finger_list_u64();
+    test_finger_map_i32();
+    test_finger_map_u32();
+    test_finger_map_i64();
+    test_finger_map_u64();
+    return 0;
+}
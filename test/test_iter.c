@@ -0,0 +1,345 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define TEST_SIZE 10000
+
+
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+void test_iter_i32() {
+    printf("test_iter_i32()\n");
+    const int64_t base = -10000;
+    SkipList_i32 * sl = skipList_i32_create();
+    SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+    assert(!skipList_i32_iter_valid(it));
+    assert(!skipList_i32_iter_next(it));
+    skipList_i32_iter_destroy(&it);
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_i32_insert(sl, (int32_t)(base + 2 * i)));
+    }
+    printf("[test_iter_i32] full walk in ascending order\n");
+    it = skipList_i32_iter_create(sl);
+    int count = 0;
+    for (; skipList_i32_iter_valid(it); skipList_i32_iter_next(it)) {
+        assert(skipList_i32_iter_key(it) == (int32_t)(base + 2 * count));
+        count++;
+    }
+    assert(count == TEST_SIZE);
+    printf("[test_iter_i32] seek\n");
+    skipList_i32_iter_seek(it, (int32_t)(base + 101));
+    assert(skipList_i32_iter_key(it) == (int32_t)(base + 102));
+    skipList_i32_iter_seek(it, (int32_t)(base + 2 * TEST_SIZE));
+    assert(!skipList_i32_iter_valid(it));
+    printf("[test_iter_i32] removing the current entry through the list\n");
+    skipList_i32_iter_seek(it, (int32_t)(base + 10));
+    skipList_i32_remove(sl, (int32_t)(base + 10));
+    skipList_i32_remove(sl, (int32_t)(base + 12));
+    assert(skipList_i32_iter_valid(it));
+    assert(skipList_i32_iter_key(it) == (int32_t)(base + 10));
+    assert(!skipList_i32_iter_remove(it));
+    assert(skipList_i32_iter_next(it));
+    assert(skipList_i32_iter_key(it) == (int32_t)(base + 14));
+    // entries inserted ahead of the iterator are visited
+    skipList_i32_insert(sl, (int32_t)(base + 15));
+    assert(skipList_i32_iter_next(it));
+    assert(skipList_i32_iter_key(it) == (int32_t)(base + 15));
+    printf("[test_iter_i32] expiring entries while iterating\n");
+    skipList_i32_iter_seek(it, (int32_t)base);
+    while (skipList_i32_iter_valid(it)) {
+        int32_t key = skipList_i32_iter_key(it);
+        if (((int64_t)key - base) % 4 == 0) assert(skipList_i32_iter_remove(it));
+        skipList_i32_iter_next(it);
+    }
+    count = 0;
+    for (skipList_i32_iter_seek(it, (int32_t)base); skipList_i32_iter_valid(it);
+         skipList_i32_iter_next(it)) {
+        assert(((int64_t)skipList_i32_iter_key(it) - base) % 4 != 0);
+        count++;
+    }
+    assert((uint32_t)count == skipList_i32_getSize(sl));
+    skipList_i32_iter_destroy(&it);
+    assert(it == NULL);
+    skipList_i32_destroy(&sl);
+
+    printf("[test_iter_i32] map values\n");
+    SkipMap_i32 * sm = skipMap_i32_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_i32_put(sm, (int32_t)i, (void *)(intptr_t)i);
+    }
+    it = skipMap_i32_iter_create(sm);
+    assert(skipMap_i32_iter_value(it) == (void *)(intptr_t)1);
+    assert(skipMap_i32_iter_remove(it) == (void *)(intptr_t)1);
+    assert(skipMap_i32_iter_value(it) == NULL);
+    assert(skipMap_i32_iter_remove(it) == NULL);
+    assert(skipList_i32_iter_next(it));
+    assert(skipMap_i32_iter_value(it) == (void *)(intptr_t)2);
+    skipMap_i32_remove(sm, 2);
+    assert(skipMap_i32_iter_value(it) == NULL);
+    while (skipList_i32_iter_valid(it)) {
+        skipMap_i32_iter_remove(it);
+        skipList_i32_iter_next(it);
+    }
+    assert(skipMap_i32_isEmpty(sm));
+    skipList_i32_iter_destroy(&it);
+    skipMap_i32_destroy(&sm);
+    printf("[test_iter_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+void test_iter_u32() {
+    printf("test_iter_u32()\n");
+    const int64_t base = 0;
+    SkipList_u32 * sl = skipList_u32_create();
+    SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+    assert(!skipList_u32_iter_valid(it));
+    assert(!skipList_u32_iter_next(it));
+    skipList_u32_iter_destroy(&it);
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_u32_insert(sl, (uint32_t)(base + 2 * i)));
+    }
+    printf("[test_iter_u32] full walk in ascending order\n");
+    it = skipList_u32_iter_create(sl);
+    int count = 0;
+    for (; skipList_u32_iter_valid(it); skipList_u32_iter_next(it)) {
+        assert(skipList_u32_iter_key(it) == (uint32_t)(base + 2 * count));
+        count++;
+    }
+    assert(count == TEST_SIZE);
+    printf("[test_iter_u32] seek\n");
+    skipList_u32_iter_seek(it, (uint32_t)(base + 101));
+    assert(skipList_u32_iter_key(it) == (uint32_t)(base + 102));
+    skipList_u32_iter_seek(it, (uint32_t)(base + 2 * TEST_SIZE));
+    assert(!skipList_u32_iter_valid(it));
+    printf("[test_iter_u32] removing the current entry through the list\n");
+    skipList_u32_iter_seek(it, (uint32_t)(base + 10));
+    skipList_u32_remove(sl, (uint32_t)(base + 10));
+    skipList_u32_remove(sl, (uint32_t)(base + 12));
+    assert(skipList_u32_iter_valid(it));
+    assert(skipList_u32_iter_key(it) == (uint32_t)(base + 10));
+    assert(!skipList_u32_iter_remove(it));
+    assert(skipList_u32_iter_next(it));
+    assert(skipList_u32_iter_key(it) == (uint32_t)(base + 14));
+    // entries inserted ahead of the iterator are visited
+    skipList_u32_insert(sl, (uint32_t)(base + 15));
+    assert(skipList_u32_iter_next(it));
+    assert(skipList_u32_iter_key(it) == (uint32_t)(base + 15));
+    printf("[test_iter_u32] expiring entries while iterating\n");
+    skipList_u32_iter_seek(it, (uint32_t)base);
+    while (skipList_u32_iter_valid(it)) {
+        uint32_t key = skipList_u32_iter_key(it);
+        if (((int64_t)key - base) % 4 == 0) assert(skipList_u32_iter_remove(it));
+        skipList_u32_iter_next(it);
+    }
+    count = 0;
+    for (skipList_u32_iter_seek(it, (uint32_t)base); skipList_u32_iter_valid(it);
+         skipList_u32_iter_next(it)) {
+        assert(((int64_t)skipList_u32_iter_key(it) - base) % 4 != 0);
+        count++;
+    }
+    assert((uint32_t)count == skipList_u32_getSize(sl));
+    skipList_u32_iter_destroy(&it);
+    assert(it == NULL);
+    skipList_u32_destroy(&sl);
+
+    printf("[test_iter_u32] map values\n");
+    SkipMap_u32 * sm = skipMap_u32_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_u32_put(sm, (uint32_t)i, (void *)(intptr_t)i);
+    }
+    it = skipMap_u32_iter_create(sm);
+    assert(skipMap_u32_iter_value(it) == (void *)(intptr_t)1);
+    assert(skipMap_u32_iter_remove(it) == (void *)(intptr_t)1);
+    assert(skipMap_u32_iter_value(it) == NULL);
+    assert(skipMap_u32_iter_remove(it) == NULL);
+    assert(skipList_u32_iter_next(it));
+    assert(skipMap_u32_iter_value(it) == (void *)(intptr_t)2);
+    skipMap_u32_remove(sm, 2);
+    assert(skipMap_u32_iter_value(it) == NULL);
+    while (skipList_u32_iter_valid(it)) {
+        skipMap_u32_iter_remove(it);
+        skipList_u32_iter_next(it);
+    }
+    assert(skipMap_u32_isEmpty(sm));
+    skipList_u32_iter_destroy(&it);
+    skipMap_u32_destroy(&sm);
+    printf("[test_iter_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+void test_iter_i64() {
+    printf("test_iter_i64()\n");
+    const int64_t base = -10000;
+    SkipList_i64 * sl = skipList_i64_create();
+    SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+    assert(!skipList_i64_iter_valid(it));
+    assert(!skipList_i64_iter_next(it));
+    skipList_i64_iter_destroy(&it);
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_i64_insert(sl, (int64_t)(base + 2 * i)));
+    }
+    printf("[test_iter_i64] full walk in ascending order\n");
+    it = skipList_i64_iter_create(sl);
+    int count = 0;
+    for (; skipList_i64_iter_valid(it); skipList_i64_iter_next(it)) {
+        assert(skipList_i64_iter_key(it) == (int64_t)(base + 2 * count));
+        count++;
+    }
+    assert(count == TEST_SIZE);
+    printf("[test_iter_i64] seek\n");
+    skipList_i64_iter_seek(it, (int64_t)(base + 101));
+    assert(skipList_i64_iter_key(it) == (int64_t)(base + 102));
+    skipList_i64_iter_seek(it, (int64_t)(base + 2 * TEST_SIZE));
+    assert(!skipList_i64_iter_valid(it));
+    printf("[test_iter_i64] removing the current entry through the list\n");
+    skipList_i64_iter_seek(it, (int64_t)(base + 10));
+    skipList_i64_remove(sl, (int64_t)(base + 10));
+    skipList_i64_remove(sl, (int64_t)(base + 12));
+    assert(skipList_i64_iter_valid(it));
+    assert(skipList_i64_iter_key(it) == (int64_t)(base + 10));
+    assert(!skipList_i64_iter_remove(it));
+    assert(skipList_i64_iter_next(it));
+    assert(skipList_i64_iter_key(it) == (int64_t)(base + 14));
+    // entries inserted ahead of the iterator are visited
+    skipList_i64_insert(sl, (int64_t)(base + 15));
+    assert(skipList_i64_iter_next(it));
+    assert(skipList_i64_iter_key(it) == (int64_t)(base + 15));
+    printf("[test_iter_i64] expiring entries while iterating\n");
+    skipList_i64_iter_seek(it, (int64_t)base);
+    while (skipList_i64_iter_valid(it)) {
+        int64_t key = skipList_i64_iter_key(it);
+        if (((int64_t)key - base) % 4 == 0) assert(skipList_i64_iter_remove(it));
+        skipList_i64_iter_next(it);
+    }
+    count = 0;
+    for (skipList_i64_iter_seek(it, (int64_t)base); skipList_i64_iter_valid(it);
+         skipList_i64_iter_next(it)) {
+        assert(((int64_t)skipList_i64_iter_key(it) - base) % 4 != 0);
+        count++;
+    }
+    assert((uint32_t)count == skipList_i64_getSize(sl));
+    skipList_i64_iter_destroy(&it);
+    assert(it == NULL);
+    skipList_i64_destroy(&sl);
+
+    printf("[test_iter_i64] map values\n");
+    SkipMap_i64 * sm = skipMap_i64_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_i64_put(sm, (int64_t)i, (void *)(intptr_t)i);
+    }
+    it = skipMap_i64_iter_create(sm);
+    assert(skipMap_i64_iter_value(it) == (void *)(intptr_t)1);
+    assert(skipMap_i64_iter_remove(it) == (void *)(intptr_t)1);
+    assert(skipMap_i64_iter_value(it) == NULL);
+    assert(skipMap_i64_iter_remove(it) == NULL);
+    assert(skipList_i64_iter_next(it));
+    assert(skipMap_i64_iter_value(it) == (void *)(intptr_t)2);
+    skipMap_i64_remove(sm, 2);
+    assert(skipMap_i64_iter_value(it) == NULL);
+    while (skipList_i64_iter_valid(it)) {
+        skipMap_i64_iter_remove(it);
+        skipList_i64_iter_next(it);
+    }
+    assert(skipMap_i64_isEmpty(sm));
+    skipList_i64_iter_destroy(&it);
+    skipMap_i64_destroy(&sm);
+    printf("[test_iter_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+void test_iter_u64() {
+    printf("test_iter_u64()\n");
+    const int64_t base = 0;
+    SkipList_u64 * sl = skipList_u64_create();
+    SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+    assert(!skipList_u64_iter_valid(it));
+    assert(!skipList_u64_iter_next(it));
+    skipList_u64_iter_destroy(&it);
+    for (int i = TEST_SIZE - 1; i >= 0; i--) {
+        assert(skipList_u64_insert(sl, (uint64_t)(base + 2 * i)));
+    }
+    printf("[test_iter_u64] full walk in ascending order\n");
+    it = skipList_u64_iter_create(sl);
+    int count = 0;
+    for (; skipList_u64_iter_valid(it); skipList_u64_iter_next(it)) {
+        assert(skipList_u64_iter_key(it) == (uint64_t)(base + 2 * count));
+        count++;
+    }
+    assert(count == TEST_SIZE);
+    printf("[test_iter_u64] seek\n");
+    skipList_u64_iter_seek(it, (uint64_t)(base + 101));
+    assert(skipList_u64_iter_key(it) == (uint64_t)(base + 102));
+    skipList_u64_iter_seek(it, (uint64_t)(base + 2 * TEST_SIZE));
+    assert(!skipList_u64_iter_valid(it));
+    printf("[test_iter_u64] removing the current entry through the list\n");
+    skipList_u64_iter_seek(it, (uint64_t)(base + 10));
+    skipList_u64_remove(sl, (uint64_t)(base + 10));
+    skipList_u64_remove(sl, (uint64_t)(base + 12));
+    assert(skipList_u64_iter_valid(it));
+    assert(skipList_u64_iter_key(it) == (uint64_t)(base + 10));
+    assert(!skipList_u64_iter_remove(it));
+    assert(skipList_u64_iter_next(it));
+    assert(skipList_u64_iter_key(it) == (uint64_t)(base + 14));
+    // entries inserted ahead of the iterator are visited
+    skipList_u64_insert(sl, (uint64_t)(base + 15));
+    assert(skipList_u64_iter_next(it));
+    assert(skipList_u64_iter_key(it) == (uint64_t)(base + 15));
+    printf("[test_iter_u64] expiring entries while iterating\n");
+    skipList_u64_iter_seek(it, (uint64_t)base);
+    while (skipList_u64_iter_valid(it)) {
+        uint64_t key = skipList_u64_iter_key(it);
+        if (((int64_t)key - base) % 4 == 0) assert(skipList_u64_iter_remove(it));
+        skipList_u64_iter_next(it);
+    }
+    count = 0;
+    for (skipList_u64_iter_seek(it, (uint64_t)base); skipList_u64_iter_valid(it);
+         skipList_u64_iter_next(it)) {
+        assert(((int64_t)skipList_u64_iter_key(it) - base) % 4 != 0);
+        count++;
+    }
+    assert((uint32_t)count == skipList_u64_getSize(sl));
+    skipList_u64_iter_destroy(&it);
+    assert(it == NULL);
+    skipList_u64_destroy(&sl);
+
+    printf("[test_iter_u64] map values\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (int i = 1; i <= 100; i++) {
+        skipMap_u64_put(sm, (uint64_t)i, (void *)(intptr_t)i);
+    }
+    it = skipMap_u64_iter_create(sm);
+    assert(skipMap_u64_iter_value(it) == (void *)(intptr_t)1);
+    assert(skipMap_u64_iter_remove(it) == (void *)(intptr_t)1);
+    assert(skipMap_u64_iter_value(it) == NULL);
+    assert(skipMap_u64_iter_remove(it) == NULL);
+    assert(skipList_u64_iter_next(it));
+    assert(skipMap_u64_iter_value(it) == (void *)(intptr_t)2);
+    skipMap_u64_remove(sm, 2);
+    assert(skipMap_u64_iter_value(it) == NULL);
+    while (skipList_u64_iter_valid(it)) {
+        skipMap_u64_iter_remove(it);
+        skipList_u64_iter_next(it);
+    }
+    assert(skipMap_u64_isEmpty(sm));
+    skipList_u64_iter_destroy(&it);
+    skipMap_u64_destroy(&sm);
+    printf("[test_iter_u64] ✅\n");
+}
+
+
+int main() {
+    test_iter_i32();
+    test_iter_u32();
+    test_iter_i64();
+    test_iter_u64();
+    return 0;
+}
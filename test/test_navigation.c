@@ -0,0 +1,252 @@
+#include <skiplist.h>
+#include <skiplist_generic.h>
+#include <skipmap_generic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+// members are every third key from base, probes cover the gaps and both ends
+#define MEMBERS 2000
+#define STRIDE 3
+
+#define INT_COMP_FUNC(a,b) ((a > b) - (a < b))
+DEFINE_GENERIC_SKIPLIST(NAV_I32, int32_t, INT_COMP_FUNC, NO_OP)
+DEFINE_GENERIC_SKIPMAP(NAV_MAP_I32, int32_t, int32_t, INT_COMP_FUNC, NO_OP, NO_OP)
+
+// brute force reference over the sorted member keys, index -1 or MEMBERS when absent
+static int expected_index(int64_t base, int64_t q, bool upward, bool inclusive) {
+    if (upward) {
+        for (int i = 0; i < MEMBERS; i++) {
+            int64_t k = base + (int64_t)i * STRIDE;
+            if (k > q || (inclusive && k == q)) return i;
+        }
+        return MEMBERS;
+    }
+    for (int i = MEMBERS - 1; i >= 0; i--) {
+        int64_t k = base + (int64_t)i * STRIDE;
+        if (k < q || (inclusive && k == q)) return i;
+    }
+    return -1;
+}
+
+#define CHECK_NAV(call, base, q, upward, inclusive, out_key)                           \
+    do {                                                                                \
+        int idx = expected_index(base, q, upward, inclusive);                           \
+        bool found = (call);                                                            \
+        assert(found == (idx >= 0 && idx < MEMBERS));                                   \
+        if (found) assert((int64_t)(out_key) == (base) + (int64_t)idx * STRIDE);        \
+    } while (0)
+
+
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+void test_navigation_i32() {
+    printf("test_navigation_i32()\n");
+    const int64_t base = -3000;
+    SkipList_i32 * sl = skipList_i32_create();
+    SkipMap_i32 * sm = skipMap_i32_create();
+    int32_t out = 0;
+    struct SM_i32_kv kv;
+    assert(!skipList_i32_ceiling(sl, 0, &out));
+    assert(!skipList_i32_floor(sl, 0, &out));
+    assert(!skipMap_i32_lower(sm, 0, &kv));
+    // insert out of order so tower heights are unrelated to key order
+    for (int i = MEMBERS - 1; i >= 0; i--) {
+        int32_t key = (int32_t)(base + (int64_t)i * STRIDE);
+        assert(skipList_i32_insert(sl, key));
+        assert(skipMap_i32_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_navigation_i32] probing every key around the members\n");
+    for (int64_t q = base; q < base + (int64_t)MEMBERS * STRIDE + 2; q++) {
+        CHECK_NAV(skipList_i32_ceiling(sl, (int32_t)q, &out), base, q, true, true, out);
+        CHECK_NAV(skipList_i32_floor(sl, (int32_t)q, &out), base, q, false, true, out);
+        CHECK_NAV(skipList_i32_higher(sl, (int32_t)q, &out), base, q, true, false, out);
+        CHECK_NAV(skipList_i32_lower(sl, (int32_t)q, &out), base, q, false, false, out);
+        CHECK_NAV(skipMap_i32_ceiling(sm, (int32_t)q, &kv), base, q, true, true, kv.key);
+        if (skipMap_i32_floor(sm, (int32_t)q, &kv)) {
+            assert(kv.value == (void *)(intptr_t)((kv.key - base) / STRIDE + 1));
+        }
+    }
+    // out is optional
+    assert(skipList_i32_higher(sl, (int32_t)base, NULL));
+    assert(skipMap_i32_lower(sm, (int32_t)(base + 1), NULL));
+    skipList_i32_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_i32_pop(sm, &kv));
+    skipMap_i32_destroy(&sm);
+    printf("[test_navigation_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+void test_navigation_u32() {
+    printf("test_navigation_u32()\n");
+    const int64_t base = 1;
+    SkipList_u32 * sl = skipList_u32_create();
+    SkipMap_u32 * sm = skipMap_u32_create();
+    uint32_t out = 0;
+    struct SM_u32_kv kv;
+    assert(!skipList_u32_ceiling(sl, 0, &out));
+    assert(!skipList_u32_floor(sl, 0, &out));
+    assert(!skipMap_u32_lower(sm, 0, &kv));
+    // insert out of order so tower heights are unrelated to key order
+    for (int i = MEMBERS - 1; i >= 0; i--) {
+        uint32_t key = (uint32_t)(base + (int64_t)i * STRIDE);
+        assert(skipList_u32_insert(sl, key));
+        assert(skipMap_u32_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_navigation_u32] probing every key around the members\n");
+    for (int64_t q = base; q < base + (int64_t)MEMBERS * STRIDE + 2; q++) {
+        CHECK_NAV(skipList_u32_ceiling(sl, (uint32_t)q, &out), base, q, true, true, out);
+        CHECK_NAV(skipList_u32_floor(sl, (uint32_t)q, &out), base, q, false, true, out);
+        CHECK_NAV(skipList_u32_higher(sl, (uint32_t)q, &out), base, q, true, false, out);
+        CHECK_NAV(skipList_u32_lower(sl, (uint32_t)q, &out), base, q, false, false, out);
+        CHECK_NAV(skipMap_u32_ceiling(sm, (uint32_t)q, &kv), base, q, true, true, kv.key);
+        if (skipMap_u32_floor(sm, (uint32_t)q, &kv)) {
+            assert(kv.value == (void *)(intptr_t)((kv.key - base) / STRIDE + 1));
+        }
+    }
+    // out is optional
+    assert(skipList_u32_higher(sl, (uint32_t)base, NULL));
+    assert(skipMap_u32_lower(sm, (uint32_t)(base + 1), NULL));
+    skipList_u32_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_u32_pop(sm, &kv));
+    skipMap_u32_destroy(&sm);
+    printf("[test_navigation_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+void test_navigation_i64() {
+    printf("test_navigation_i64()\n");
+    const int64_t base = -3000;
+    SkipList_i64 * sl = skipList_i64_create();
+    SkipMap_i64 * sm = skipMap_i64_create();
+    int64_t out = 0;
+    struct SM_i64_kv kv;
+    assert(!skipList_i64_ceiling(sl, 0, &out));
+    assert(!skipList_i64_floor(sl, 0, &out));
+    assert(!skipMap_i64_lower(sm, 0, &kv));
+    // insert out of order so tower heights are unrelated to key order
+    for (int i = MEMBERS - 1; i >= 0; i--) {
+        int64_t key = (int64_t)(base + (int64_t)i * STRIDE);
+        assert(skipList_i64_insert(sl, key));
+        assert(skipMap_i64_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_navigation_i64] probing every key around the members\n");
+    for (int64_t q = base; q < base + (int64_t)MEMBERS * STRIDE + 2; q++) {
+        CHECK_NAV(skipList_i64_ceiling(sl, (int64_t)q, &out), base, q, true, true, out);
+        CHECK_NAV(skipList_i64_floor(sl, (int64_t)q, &out), base, q, false, true, out);
+        CHECK_NAV(skipList_i64_higher(sl, (int64_t)q, &out), base, q, true, false, out);
+        CHECK_NAV(skipList_i64_lower(sl, (int64_t)q, &out), base, q, false, false, out);
+        CHECK_NAV(skipMap_i64_ceiling(sm, (int64_t)q, &kv), base, q, true, true, kv.key);
+        if (skipMap_i64_floor(sm, (int64_t)q, &kv)) {
+            assert(kv.value == (void *)(intptr_t)((kv.key - base) / STRIDE + 1));
+        }
+    }
+    // out is optional
+    assert(skipList_i64_higher(sl, (int64_t)base, NULL));
+    assert(skipMap_i64_lower(sm, (int64_t)(base + 1), NULL));
+    skipList_i64_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_i64_pop(sm, &kv));
+    skipMap_i64_destroy(&sm);
+    printf("[test_navigation_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+void test_navigation_u64() {
+    printf("test_navigation_u64()\n");
+    const int64_t base = 1;
+    SkipList_u64 * sl = skipList_u64_create();
+    SkipMap_u64 * sm = skipMap_u64_create();
+    uint64_t out = 0;
+    struct SM_u64_kv kv;
+    assert(!skipList_u64_ceiling(sl, 0, &out));
+    assert(!skipList_u64_floor(sl, 0, &out));
+    assert(!skipMap_u64_lower(sm, 0, &kv));
+    // insert out of order so tower heights are unrelated to key order
+    for (int i = MEMBERS - 1; i >= 0; i--) {
+        uint64_t key = (uint64_t)(base + (int64_t)i * STRIDE);
+        assert(skipList_u64_insert(sl, key));
+        assert(skipMap_u64_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_navigation_u64] probing every key around the members\n");
+    for (int64_t q = base; q < base + (int64_t)MEMBERS * STRIDE + 2; q++) {
+        CHECK_NAV(skipList_u64_ceiling(sl, (uint64_t)q, &out), base, q, true, true, out);
+        CHECK_NAV(skipList_u64_floor(sl, (uint64_t)q, &out), base, q, false, true, out);
+        CHECK_NAV(skipList_u64_higher(sl, (uint64_t)q, &out), base, q, true, false, out);
+        CHECK_NAV(skipList_u64_lower(sl, (uint64_t)q, &out), base, q, false, false, out);
+        CHECK_NAV(skipMap_u64_ceiling(sm, (uint64_t)q, &kv), base, q, true, true, kv.key);
+        if (skipMap_u64_floor(sm, (uint64_t)q, &kv)) {
+            assert(kv.value == (void *)(intptr_t)((kv.key - base) / STRIDE + 1));
+        }
+    }
+    // out is optional
+    assert(skipList_u64_higher(sl, (uint64_t)base, NULL));
+    assert(skipMap_u64_lower(sm, (uint64_t)(base + 1), NULL));
+    skipList_u64_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_u64_pop(sm, &kv));
+    skipMap_u64_destroy(&sm);
+    printf("[test_navigation_u64] ✅\n");
+}
+
+
+void test_navigation_generic() {
+    printf("test_navigation_generic()\n");
+    SkipList_NAV_I32 * sl = SkipList_NAV_I32_create(INT32_MIN);
+    SkipMap_NAV_MAP_I32 * sm = SkipMap_NAV_MAP_I32_create(INT32_MIN, 0);
+    for (int i = 0; i < MEMBERS; i++) {
+        assert(SkipList_NAV_I32_insert(sl, i * STRIDE));
+        assert(SkipMap_NAV_MAP_I32_put(sm, i * STRIDE, i));
+    }
+    int32_t out = 0;
+    struct SM_NAV_MAP_I32_kv kv;
+    for (int64_t q = -1; q < (int64_t)MEMBERS * STRIDE + 2; q++) {
+        CHECK_NAV(SkipList_NAV_I32_ceiling(sl, (int32_t)q, &out), 0, q, true, true, out);
+        CHECK_NAV(SkipList_NAV_I32_floor(sl, (int32_t)q, &out), 0, q, false, true, out);
+        CHECK_NAV(SkipList_NAV_I32_higher(sl, (int32_t)q, &out), 0, q, true, false, out);
+        CHECK_NAV(SkipList_NAV_I32_lower(sl, (int32_t)q, &out), 0, q, false, false, out);
+        CHECK_NAV(SkipMap_NAV_MAP_I32_higher(sm, (int32_t)q, &kv), 0, q, true, false, kv.key);
+        if (SkipMap_NAV_MAP_I32_ceiling(sm, (int32_t)q, &kv)) assert(kv.value == kv.key / STRIDE);
+    }
+    SkipList_NAV_I32_destroy(&sl);
+    SkipMap_NAV_MAP_I32_destroy(&sm);
+    printf("[test_navigation_generic] ✅\n");
+}
+
+void test_navigation_dispatch() {
+    printf("test_navigation_dispatch()\n");
+    SkipList_u64 * sl = skipList_create((uint64_t)0);
+    SkipMap_i32 * sm = skipMap_create((int32_t)0);
+    skipList_insert(sl, (uint64_t)10);
+    skipList_insert(sl, (uint64_t)20);
+    skipMap_put(sm, (int32_t)-5, NULL);
+    uint64_t out = 0;
+    struct SM_i32_kv kv;
+    assert(skipList_ceiling(sl, (uint64_t)11, &out) && out == 20);
+    assert(skipList_floor(sl, (uint64_t)11, &out) && out == 10);
+    assert(!skipList_higher(sl, (uint64_t)20, &out));
+    assert(skipMap_lower(sm, (int32_t)0, &kv) && kv.key == -5);
+    skipList_destroy(&sl);
+    skipMap_destroy(&sm);
+    printf("[test_navigation_dispatch] ✅\n");
+}
+
+int main() {
+    test_navigation_i32();
+    test_navigation_u32();
+    test_navigation_i64();
+    test_navigation_u64();
+    test_navigation_generic();
+    test_navigation_dispatch();
+    return 0;
+}
@@ -0,0 +1,303 @@
+#include <skiplist.h>
+#include <skiplist_generic.h>
+#include "../src/skiplist_random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define N 20000
+
+#define cmp_int_func(a,b) ((a > b) - (a < b))
+DEFINE_GENERIC_SKIPLIST(Shaped, int32_t, cmp_int_func, NO_OP)
+
+static void test_fixed_growth() {
+    printf("test_fixed_growth()\n");
+    printf("[test_fixed_growth] a fixed p ignores the size\n");
+    SkipListRandom r;
+    skipListRandom_seed(&r, 1);
+    skipListRandom_level(&r, 16, 8, SL_MAX_HEIGHT, 0.25, 0.25);
+    assert(r.p == 0.25);
+    skipListRandom_level(&r, 1000000, 2, SL_MAX_HEIGHT, 0.25, 0.25);
+    assert(r.p == 0.25);
+    printf("[test_fixed_growth] ✅\n");
+}
+
+// counts the bytes a list holds from its allocator
+static long long live_bytes;
+
+static void * counting_alloc(void * ctx, size_t size) {
+    (void)ctx;
+    live_bytes += size;
+    return malloc(size);
+}
+
+static void counting_free(void * ctx, void * ptr, size_t size) {
+    (void)ctx;
+    live_bytes -= size;
+    free(ptr);
+}
+
+// a short list pays for its own height only: header links, tails and the
+// arena size classes all shrink with max_height
+static void test_footprint() {
+    printf("test_footprint()\n");
+    printf("[test_footprint] a short arena list is smaller than a default one\n");
+    SkipListAllocator counting = { counting_alloc, counting_free, NULL, NULL };
+    SkipListOptions options = { .flags = SKIPLIST_ARENA, .allocator = &counting };
+    SkipList_u64 * tall = skipList_u64_create_with_options(&options);
+    long long tall_bytes = live_bytes;
+    options.max_height = 4;
+    SkipList_u64 * small = skipList_u64_create_with_options(&options);
+    long long small_bytes = live_bytes - tall_bytes;
+    assert(small_bytes + (SL_MAX_HEIGHT - 4) * 2 * (long long)sizeof(void *) <= tall_bytes);
+    for (uint64_t i = 0; i < 1000; i++) assert(skipList_u64_insert(small, i));
+    SkipList_u64 * snap = skipList_u64_snapshot(small);
+    SkipList_u64 * copy = skipList_u64_clone(small);
+    skipList_u64_remove(small, 500);
+    assert(skipList_u64_search(snap, 500) && skipList_u64_search(copy, 500));
+    skipList_u64_destroy(&snap);
+    skipList_u64_destroy(&copy);
+    skipList_u64_destroy(&small);
+    skipList_u64_destroy(&tall);
+    assert(live_bytes == 0);
+    printf("[test_footprint] ✅\n");
+}
+
+// towers never outgrow max_height and the header is only that tall, the
+// generic list is a header so its nodes can be checked directly
+static void test_generic() {
+    printf("test_generic()\n");
+    printf("[test_generic] max height caps header and towers\n");
+    SkipListOptions options = { .max_height = 3, .p = 0.5, .growth = SKIPLIST_GROWTH_FIXED };
+    SkipList_Shaped * sl = SkipList_Shaped_create_with_options(0, &options);
+    assert(sl->header->height == 3);
+    uint32_t above[4] = {0};
+    for (int32_t i = 1; i <= N; i++) assert(SkipList_Shaped_insert(sl, i));
+    for (Node_Shaped * x = sl->header->forward[0]; x; x = x->forward[0]) {
+        assert(x->height <= 3);
+        for (uint32_t l = 1; l < x->height; l++) above[l]++;
+    }
+    // half of the towers reach level 2, a quarter level 3
+    assert(above[1] > N / 2 * 0.9 && above[1] < N / 2 * 1.1);
+    assert(above[2] > N / 4 * 0.9 && above[2] < N / 4 * 1.1);
+    for (int32_t i = 1; i <= N; i += 2) assert(SkipList_Shaped_remove(sl, i));
+    for (int32_t i = 1; i <= N; i++) assert(SkipList_Shaped_search(sl, i) == (i % 2 == 0));
+    SkipList_Shaped_destroy(&sl);
+    sl = SkipList_Shaped_create_with_options(0, NULL);
+    assert(sl->header->height == SL_MAX_HEIGHT);
+    SkipList_Shaped_destroy(&sl);
+    printf("[test_generic] ✅\n");
+}
+
+// a short header has to hold through every path that builds or moves towers:
+// spans, split and concat between siblings, clones, snapshots and set results
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+void test_shape_i32() {
+    printf("test_shape_i32()\n");
+    printf("[test_shape_i32] short towers with spans and back links\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS | SKIPLIST_ARENA,
+                                .seed = 3, .max_height = 4, .p = 0.25,
+                                .growth = SKIPLIST_GROWTH_FIXED };
+    SkipList_i32 * sl = skipList_i32_create_with_options(&options);
+    for (int32_t i = 0; i < N; i++) assert(skipList_i32_insert(sl, i * 2));
+    for (int32_t i = 0; i < N; i += 3) skipList_i32_remove(sl, i * 2);
+    uint32_t size = skipList_i32_getSize(sl);
+    int32_t out;
+    for (uint32_t r = 0; r < size; r += 97) {
+        assert(skipList_i32_select(sl, r, &out));
+        assert(skipList_i32_rank(sl, out) == r);
+    }
+    printf("[test_shape_i32] split, concat, clone and snapshot\n");
+    SkipList_i32 * right = NULL;
+    skipList_i32_split(sl, N, &right);
+    for (int32_t i = N; i < 2 * N; i += 2) skipList_i32_insert(right, i + 1);
+    skipList_i32_concat(sl, &right);
+    assert(!right);
+    SkipList_i32 * copy = skipList_i32_clone(sl);
+    SkipList_i32 * snap = skipList_i32_snapshot(sl);
+    skipList_i32_insert(sl, 2 * N + 1);
+    assert(skipList_i32_getSize(copy) == skipList_i32_getSize(snap));
+    assert(skipList_i32_getSize(sl) == skipList_i32_getSize(copy) + 1);
+    SkipList_i32 * both = skipList_i32_union(copy, snap);
+    assert(skipList_i32_getSize(both) == skipList_i32_getSize(copy));
+    size = skipList_i32_getSize(copy);
+    for (uint32_t r = 0; r < size; r += 89) {
+        assert(skipList_i32_select(copy, r, &out));
+        assert(skipList_i32_rank(snap, out) == r && skipList_i32_rank(both, out) == r);
+    }
+    skipList_i32_destroy(&both);
+    skipList_i32_destroy(&snap);
+    skipList_i32_destroy(&copy);
+    skipList_i32_destroy(&sl);
+    printf("[test_shape_i32] a single level is a sorted linked list\n");
+    SkipListOptions flat = { .flags = SKIPLIST_INDEXABLE, .max_height = 1 };
+    SkipMap_i32 * sm = skipMap_i32_create_with_options(&flat);
+    for (int32_t i = 0; i < 1000; i++) skipMap_i32_put(sm, 999 - i, NULL);
+    assert(skipMap_i32_rank(sm, 500) == 500);
+    skipMap_i32_destroy(&sm);
+    printf("[test_shape_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+void test_shape_u32() {
+    printf("test_shape_u32()\n");
+    printf("[test_shape_u32] short towers with spans and back links\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS | SKIPLIST_ARENA,
+                                .seed = 3, .max_height = 4, .p = 0.25,
+                                .growth = SKIPLIST_GROWTH_FIXED };
+    SkipList_u32 * sl = skipList_u32_create_with_options(&options);
+    for (uint32_t i = 0; i < N; i++) assert(skipList_u32_insert(sl, i * 2));
+    for (uint32_t i = 0; i < N; i += 3) skipList_u32_remove(sl, i * 2);
+    uint32_t size = skipList_u32_getSize(sl);
+    uint32_t out;
+    for (uint32_t r = 0; r < size; r += 97) {
+        assert(skipList_u32_select(sl, r, &out));
+        assert(skipList_u32_rank(sl, out) == r);
+    }
+    printf("[test_shape_u32] split, concat, clone and snapshot\n");
+    SkipList_u32 * right = NULL;
+    skipList_u32_split(sl, N, &right);
+    for (uint32_t i = N; i < 2 * N; i += 2) skipList_u32_insert(right, i + 1);
+    skipList_u32_concat(sl, &right);
+    assert(!right);
+    SkipList_u32 * copy = skipList_u32_clone(sl);
+    SkipList_u32 * snap = skipList_u32_snapshot(sl);
+    skipList_u32_insert(sl, 2 * N + 1);
+    assert(skipList_u32_getSize(copy) == skipList_u32_getSize(snap));
+    assert(skipList_u32_getSize(sl) == skipList_u32_getSize(copy) + 1);
+    SkipList_u32 * both = skipList_u32_union(copy, snap);
+    assert(skipList_u32_getSize(both) == skipList_u32_getSize(copy));
+    size = skipList_u32_getSize(copy);
+    for (uint32_t r = 0; r < size; r += 89) {
+        assert(skipList_u32_select(copy, r, &out));
+        assert(skipList_u32_rank(snap, out) == r && skipList_u32_rank(both, out) == r);
+    }
+    skipList_u32_destroy(&both);
+    skipList_u32_destroy(&snap);
+    skipList_u32_destroy(&copy);
+    skipList_u32_destroy(&sl);
+    printf("[test_shape_u32] a single level is a sorted linked list\n");
+    SkipListOptions flat = { .flags = SKIPLIST_INDEXABLE, .max_height = 1 };
+    SkipMap_u32 * sm = skipMap_u32_create_with_options(&flat);
+    for (uint32_t i = 0; i < 1000; i++) skipMap_u32_put(sm, 999 - i, NULL);
+    assert(skipMap_u32_rank(sm, 500) == 500);
+    skipMap_u32_destroy(&sm);
+    printf("[test_shape_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+void test_shape_i64() {
+    printf("test_shape_i64()\n");
+    printf("[test_shape_i64] short towers with spans and back links\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS | SKIPLIST_ARENA,
+                                .seed = 3, .max_height = 4, .p = 0.25,
+                                .growth = SKIPLIST_GROWTH_FIXED };
+    SkipList_i64 * sl = skipList_i64_create_with_options(&options);
+    for (int64_t i = 0; i < N; i++) assert(skipList_i64_insert(sl, i * 2));
+    for (int64_t i = 0; i < N; i += 3) skipList_i64_remove(sl, i * 2);
+    uint32_t size = skipList_i64_getSize(sl);
+    int64_t out;
+    for (uint32_t r = 0; r < size; r += 97) {
+        assert(skipList_i64_select(sl, r, &out));
+        assert(skipList_i64_rank(sl, out) == r);
+    }
+    printf("[test_shape_i64] split, concat, clone and snapshot\n");
+    SkipList_i64 * right = NULL;
+    skipList_i64_split(sl, N, &right);
+    for (int64_t i = N; i < 2 * N; i += 2) skipList_i64_insert(right, i + 1);
+    skipList_i64_concat(sl, &right);
+    assert(!right);
+    SkipList_i64 * copy = skipList_i64_clone(sl);
+    SkipList_i64 * snap = skipList_i64_snapshot(sl);
+    skipList_i64_insert(sl, 2 * N + 1);
+    assert(skipList_i64_getSize(copy) == skipList_i64_getSize(snap));
+    assert(skipList_i64_getSize(sl) == skipList_i64_getSize(copy) + 1);
+    SkipList_i64 * both = skipList_i64_union(copy, snap);
+    assert(skipList_i64_getSize(both) == skipList_i64_getSize(copy));
+    size = skipList_i64_getSize(copy);
+    for (uint32_t r = 0; r < size; r += 89) {
+        assert(skipList_i64_select(copy, r, &out));
+        assert(skipList_i64_rank(snap, out) == r && skipList_i64_rank(both, out) == r);
+    }
+    skipList_i64_destroy(&both);
+    skipList_i64_destroy(&snap);
+    skipList_i64_destroy(&copy);
+    skipList_i64_destroy(&sl);
+    printf("[test_shape_i64] a single level is a sorted linked list\n");
+    SkipListOptions flat = { .flags = SKIPLIST_INDEXABLE, .max_height = 1 };
+    SkipMap_i64 * sm = skipMap_i64_create_with_options(&flat);
+    for (int64_t i = 0; i < 1000; i++) skipMap_i64_put(sm, 999 - i, NULL);
+    assert(skipMap_i64_rank(sm, 500) == 500);
+    skipMap_i64_destroy(&sm);
+    printf("[test_shape_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+void test_shape_u64() {
+    printf("test_shape_u64()\n");
+    printf("[test_shape_u64] short towers with spans and back links\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS | SKIPLIST_ARENA,
+                                .seed = 3, .max_height = 4, .p = 0.25,
+                                .growth = SKIPLIST_GROWTH_FIXED };
+    SkipList_u64 * sl = skipList_u64_create_with_options(&options);
+    for (uint64_t i = 0; i < N; i++) assert(skipList_u64_insert(sl, i * 2));
+    for (uint64_t i = 0; i < N; i += 3) skipList_u64_remove(sl, i * 2);
+    uint32_t size = skipList_u64_getSize(sl);
+    uint64_t out;
+    for (uint32_t r = 0; r < size; r += 97) {
+        assert(skipList_u64_select(sl, r, &out));
+        assert(skipList_u64_rank(sl, out) == r);
+    }
+    printf("[test_shape_u64] split, concat, clone and snapshot\n");
+    SkipList_u64 * right = NULL;
+    skipList_u64_split(sl, N, &right);
+    for (uint64_t i = N; i < 2 * N; i += 2) skipList_u64_insert(right, i + 1);
+    skipList_u64_concat(sl, &right);
+    assert(!right);
+    SkipList_u64 * copy = skipList_u64_clone(sl);
+    SkipList_u64 * snap = skipList_u64_snapshot(sl);
+    skipList_u64_insert(sl, 2 * N + 1);
+    assert(skipList_u64_getSize(copy) == skipList_u64_getSize(snap));
+    assert(skipList_u64_getSize(sl) == skipList_u64_getSize(copy) + 1);
+    SkipList_u64 * both = skipList_u64_union(copy, snap);
+    assert(skipList_u64_getSize(both) == skipList_u64_getSize(copy));
+    size = skipList_u64_getSize(copy);
+    for (uint32_t r = 0; r < size; r += 89) {
+        assert(skipList_u64_select(copy, r, &out));
+        assert(skipList_u64_rank(snap, out) == r && skipList_u64_rank(both, out) == r);
+    }
+    skipList_u64_destroy(&both);
+    skipList_u64_destroy(&snap);
+    skipList_u64_destroy(&copy);
+    skipList_u64_destroy(&sl);
+    printf("[test_shape_u64] a single level is a sorted linked list\n");
+    SkipListOptions flat = { .flags = SKIPLIST_INDEXABLE, .max_height = 1 };
+    SkipMap_u64 * sm = skipMap_u64_create_with_options(&flat);
+    for (uint64_t i = 0; i < 1000; i++) skipMap_u64_put(sm, 999 - i, NULL);
+    assert(skipMap_u64_rank(sm, 500) == 500);
+    skipMap_u64_destroy(&sm);
+    printf("[test_shape_u64] ✅\n");
+}
+
+
+int main() {
+    test_fixed_growth();
+    test_generic();
+    test_footprint();
+    test_shape_i32();
+    test_shape_u32();
+    test_shape_i64();
+    test_shape_u64();
+    printf("[test_options] ✅\n");
+    return 0;
+}
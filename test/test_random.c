@@ -0,0 +1,154 @@
+#include <skiplist.h>
+#include "../src/skiplist_random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define DRAWS 200000
+
+// the generator is internal, its contract is checked directly: equal seeds
+// give equal heights and the heights follow p^h for the cached p
+static void test_generator() {
+    printf("test_generator()\n");
+    printf("[test_generator] equal seeds draw equal heights\n");
+    SkipListRandom a, b, c;
+    skipListRandom_seed(&a, 42);
+    skipListRandom_seed(&b, 42);
+    skipListRandom_seed(&c, 43);
+    bool differs = false;
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint32_t h = skipListRandom_level(&a, i, 4, SL_MAX_HEIGHT, 0.33, 0.70);
+        assert(h == skipListRandom_level(&b, i, 4, SL_MAX_HEIGHT, 0.33, 0.70));
+        differs |= h != skipListRandom_level(&c, i, 4, SL_MAX_HEIGHT, 0.33, 0.70);
+        assert(h >= 1 && h <= SL_MAX_HEIGHT);
+    }
+    assert(differs);
+    printf("[test_generator] heights follow the cached probability\n");
+    uint32_t cap = 6;
+    uint32_t above[8] = {0};
+    for (uint32_t i = 0; i < DRAWS; i++) {
+        uint32_t h = skipListRandom_level(&a, 1000000, 5, cap, 0.33, 0.70);
+        assert(h <= cap);
+        for (uint32_t l = 1; l < h; l++) above[l]++;
+    }
+    // 1e6^(-1/5) is below the floor so p is 0.33
+    assert(a.p == 0.33);
+    double expect = DRAWS;
+    for (uint32_t l = 1; l < 4; l++) {
+        expect *= 0.33;
+        assert(above[l] > expect * 0.9 && above[l] < expect * 1.1);
+    }
+    printf("[test_generator] p is recomputed once the size leaves its band\n");
+    skipListRandom_level(&a, 16, 8, SL_MAX_HEIGHT, 0.33, 0.70);
+    assert(a.p == 0.70 && a.from == 14 && a.until == 19);
+    skipListRandom_level(&a, 18, 8, SL_MAX_HEIGHT, 0.33, 0.70);
+    assert(a.from == 14);
+    skipListRandom_level(&a, 18, 3, SL_MAX_HEIGHT, 0.33, 0.70);
+    assert(a.level == 3 && a.p < 0.70); // a new level lowers p
+    printf("[test_generator] ✅\n");
+}
+
+
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+void test_options_i32() {
+    printf("test_options_i32()\n");
+    printf("[test_options_i32] seeded lists with flags\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE, .seed = 7 };
+    SkipList_i32 * sl = skipList_i32_create_with_options(&options);
+    for (int32_t i = 0; i < 1000; i++) skipList_i32_insert(sl, i * 3);
+    assert(skipList_i32_getSize(sl) == 1000);
+    assert(skipList_i32_rank(sl, 300) == 100);
+    skipList_i32_destroy(&sl);
+    sl = skipList_i32_create_with_options(NULL);
+    skipList_i32_insert(sl, 1);
+    assert(skipList_i32_search(sl, 1));
+    skipList_i32_destroy(&sl);
+    SkipMap_i32 * sm = skipMap_i32_create_with_options(&options);
+    skipMap_i32_put(sm, 5, NULL);
+    assert(skipMap_i32_contains(sm, 5) && skipMap_i32_rank(sm, 5) == 0);
+    skipMap_i32_destroy(&sm);
+    printf("[test_options_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+void test_options_u32() {
+    printf("test_options_u32()\n");
+    printf("[test_options_u32] seeded lists with flags\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE, .seed = 7 };
+    SkipList_u32 * sl = skipList_u32_create_with_options(&options);
+    for (uint32_t i = 0; i < 1000; i++) skipList_u32_insert(sl, i * 3);
+    assert(skipList_u32_getSize(sl) == 1000);
+    assert(skipList_u32_rank(sl, 300) == 100);
+    skipList_u32_destroy(&sl);
+    sl = skipList_u32_create_with_options(NULL);
+    skipList_u32_insert(sl, 1);
+    assert(skipList_u32_search(sl, 1));
+    skipList_u32_destroy(&sl);
+    SkipMap_u32 * sm = skipMap_u32_create_with_options(&options);
+    skipMap_u32_put(sm, 5, NULL);
+    assert(skipMap_u32_contains(sm, 5) && skipMap_u32_rank(sm, 5) == 0);
+    skipMap_u32_destroy(&sm);
+    printf("[test_options_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+void test_options_i64() {
+    printf("test_options_i64()\n");
+    printf("[test_options_i64] seeded lists with flags\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE, .seed = 7 };
+    SkipList_i64 * sl = skipList_i64_create_with_options(&options);
+    for (int64_t i = 0; i < 1000; i++) skipList_i64_insert(sl, i * 3);
+    assert(skipList_i64_getSize(sl) == 1000);
+    assert(skipList_i64_rank(sl, 300) == 100);
+    skipList_i64_destroy(&sl);
+    sl = skipList_i64_create_with_options(NULL);
+    skipList_i64_insert(sl, 1);
+    assert(skipList_i64_search(sl, 1));
+    skipList_i64_destroy(&sl);
+    SkipMap_i64 * sm = skipMap_i64_create_with_options(&options);
+    skipMap_i64_put(sm, 5, NULL);
+    assert(skipMap_i64_contains(sm, 5) && skipMap_i64_rank(sm, 5) == 0);
+    skipMap_i64_destroy(&sm);
+    printf("[test_options_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+void test_options_u64() {
+    printf("test_options_u64()\n");
+    printf("[test_options_u64] seeded lists with flags\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE, .seed = 7 };
+    SkipList_u64 * sl = skipList_u64_create_with_options(&options);
+    for (uint64_t i = 0; i < 1000; i++) skipList_u64_insert(sl, i * 3);
+    assert(skipList_u64_getSize(sl) == 1000);
+    assert(skipList_u64_rank(sl, 300) == 100);
+    skipList_u64_destroy(&sl);
+    sl = skipList_u64_create_with_options(NULL);
+    skipList_u64_insert(sl, 1);
+    assert(skipList_u64_search(sl, 1));
+    skipList_u64_destroy(&sl);
+    SkipMap_u64 * sm = skipMap_u64_create_with_options(&options);
+    skipMap_u64_put(sm, 5, NULL);
+    assert(skipMap_u64_contains(sm, 5) && skipMap_u64_rank(sm, 5) == 0);
+    skipMap_u64_destroy(&sm);
+    printf("[test_options_u64] ✅\n");
+}
+
+
+int main() {
+    test_generator();
+    test_options_i32();
+    test_options_u32();
+    test_options_i64();
+    test_options_u64();
+    return 0;
+}
@@ -0,0 +1,322 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#define TEST_SIZE 4000
+#define KEY_RANGE 8000
+
+// rank / select / countRange are checked against an in order walk of the list
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void check_index_i32(SkipList_i32 * sl) {
+    static int32_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+    for (; skipList_i32_iter_valid(it); skipList_i32_iter_next(it)) {
+        keys[n++] = skipList_i32_iter_key(it);
+    }
+    skipList_i32_iter_destroy(&it);
+    assert(n == skipList_i32_getSize(sl));
+    int32_t out;
+    for (uint32_t i = 0; i < n; i++) {
+        assert(skipList_i32_select(sl, i, &out) && out == keys[i]);
+        assert(skipList_i32_rank(sl, keys[i]) == i);
+    }
+    assert(!skipList_i32_select(sl, n, &out));
+    for (int r = 0; r < 100; r++) {
+        int32_t lo = (int32_t)(-4000 + rand() % KEY_RANGE);
+        int32_t hi = (int32_t)(lo + rand() % 500);
+        uint32_t expected = 0;
+        for (uint32_t i = 0; i < n; i++) expected += keys[i] >= lo && keys[i] < hi;
+        assert(skipList_i32_countRange(sl, lo, hi) == expected);
+    }
+}
+
+void test_rank_i32() {
+    printf("test_rank_i32()\n");
+    SkipList_i32 * sl = skipList_i32_create_with_flags(SKIPLIST_INDEXABLE);
+    int32_t out;
+    assert(skipList_i32_rank(sl, 0) == 0);
+    assert(!skipList_i32_select(sl, 0, &out));
+    printf("[test_rank_i32] random inserts\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_i32_insert(sl, (int32_t)(-4000 + rand() % KEY_RANGE));
+    }
+    check_index_i32(sl);
+    printf("[test_rank_i32] removes, pops and finger updates\n");
+    SkipListFinger_i32 * f = skipList_i32_finger_create(sl);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int32_t key = (int32_t)(-4000 + rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_i32_remove(sl, key); break;
+            case 1: skipList_i32_pop(sl, &out); break;
+            case 2: skipList_i32_finger_insert(f, key); break;
+            case 3: skipList_i32_finger_remove(f, key); break;
+            default: skipList_i32_insert(sl, key); break;
+        }
+    }
+    skipList_i32_finger_destroy(&f);
+    check_index_i32(sl);
+    while (skipList_i32_pop(sl, &out));
+    assert(!skipList_i32_select(sl, 0, &out));
+    skipList_i32_insert(sl, (int32_t)-4000);
+    check_index_i32(sl);
+    skipList_i32_destroy(&sl);
+
+    printf("[test_rank_i32] arena backed indexable map\n");
+    SkipMap_i32 * sm = skipMap_i32_create_with_flags(SKIPLIST_INDEXABLE | SKIPLIST_ARENA);
+    for (int i = 0; i < 1000; i++) {
+        skipMap_i32_put(sm, (int32_t)(-4000 + 2 * i), (void *)(intptr_t)(i + 1));
+    }
+    struct SM_i32_kv kv;
+    // the 99th percentile of 1000 entries
+    assert(skipMap_i32_select(sm, 990, &kv));
+    assert(kv.key == -2020 && kv.value == (void *)(intptr_t)991);
+    assert(skipMap_i32_rank(sm, -3899) == 51);
+    assert(skipMap_i32_countRange(sm, -3990, -3980) == 5);
+    skipMap_i32_remove(sm, -3988);
+    assert(skipMap_i32_countRange(sm, -3990, -3980) == 4);
+    while (skipMap_i32_pop(sm, &kv));
+    skipMap_i32_destroy(&sm);
+    printf("[test_rank_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void check_index_u32(SkipList_u32 * sl) {
+    static uint32_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+    for (; skipList_u32_iter_valid(it); skipList_u32_iter_next(it)) {
+        keys[n++] = skipList_u32_iter_key(it);
+    }
+    skipList_u32_iter_destroy(&it);
+    assert(n == skipList_u32_getSize(sl));
+    uint32_t out;
+    for (uint32_t i = 0; i < n; i++) {
+        assert(skipList_u32_select(sl, i, &out) && out == keys[i]);
+        assert(skipList_u32_rank(sl, keys[i]) == i);
+    }
+    assert(!skipList_u32_select(sl, n, &out));
+    for (int r = 0; r < 100; r++) {
+        uint32_t lo = (uint32_t)(rand() % KEY_RANGE);
+        uint32_t hi = (uint32_t)(lo + rand() % 500);
+        uint32_t expected = 0;
+        for (uint32_t i = 0; i < n; i++) expected += keys[i] >= lo && keys[i] < hi;
+        assert(skipList_u32_countRange(sl, lo, hi) == expected);
+    }
+}
+
+void test_rank_u32() {
+    printf("test_rank_u32()\n");
+    SkipList_u32 * sl = skipList_u32_create_with_flags(SKIPLIST_INDEXABLE);
+    uint32_t out;
+    assert(skipList_u32_rank(sl, 0) == 0);
+    assert(!skipList_u32_select(sl, 0, &out));
+    printf("[test_rank_u32] random inserts\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_u32_insert(sl, (uint32_t)(rand() % KEY_RANGE));
+    }
+    check_index_u32(sl);
+    printf("[test_rank_u32] removes, pops and finger updates\n");
+    SkipListFinger_u32 * f = skipList_u32_finger_create(sl);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint32_t key = (uint32_t)(rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_u32_remove(sl, key); break;
+            case 1: skipList_u32_pop(sl, &out); break;
+            case 2: skipList_u32_finger_insert(f, key); break;
+            case 3: skipList_u32_finger_remove(f, key); break;
+            default: skipList_u32_insert(sl, key); break;
+        }
+    }
+    skipList_u32_finger_destroy(&f);
+    check_index_u32(sl);
+    while (skipList_u32_pop(sl, &out));
+    assert(!skipList_u32_select(sl, 0, &out));
+    skipList_u32_insert(sl, 0);
+    check_index_u32(sl);
+    skipList_u32_destroy(&sl);
+
+    printf("[test_rank_u32] arena backed indexable map\n");
+    SkipMap_u32 * sm = skipMap_u32_create_with_flags(SKIPLIST_INDEXABLE | SKIPLIST_ARENA);
+    for (int i = 0; i < 1000; i++) {
+        skipMap_u32_put(sm, (uint32_t)(2 * i), (void *)(intptr_t)(i + 1));
+    }
+    struct SM_u32_kv kv;
+    // the 99th percentile of 1000 entries
+    assert(skipMap_u32_select(sm, 990, &kv));
+    assert(kv.key == 1980 && kv.value == (void *)(intptr_t)991);
+    assert(skipMap_u32_rank(sm, 101) == 51);
+    assert(skipMap_u32_countRange(sm, 10, 20) == 5);
+    skipMap_u32_remove(sm, 12);
+    assert(skipMap_u32_countRange(sm, 10, 20) == 4);
+    while (skipMap_u32_pop(sm, &kv));
+    skipMap_u32_destroy(&sm);
+    printf("[test_rank_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void check_index_i64(SkipList_i64 * sl) {
+    static int64_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+    for (; skipList_i64_iter_valid(it); skipList_i64_iter_next(it)) {
+        keys[n++] = skipList_i64_iter_key(it);
+    }
+    skipList_i64_iter_destroy(&it);
+    assert(n == skipList_i64_getSize(sl));
+    int64_t out;
+    for (uint32_t i = 0; i < n; i++) {
+        assert(skipList_i64_select(sl, i, &out) && out == keys[i]);
+        assert(skipList_i64_rank(sl, keys[i]) == i);
+    }
+    assert(!skipList_i64_select(sl, n, &out));
+    for (int r = 0; r < 100; r++) {
+        int64_t lo = (int64_t)(-4000 + rand() % KEY_RANGE);
+        int64_t hi = (int64_t)(lo + rand() % 500);
+        uint32_t expected = 0;
+        for (uint32_t i = 0; i < n; i++) expected += keys[i] >= lo && keys[i] < hi;
+        assert(skipList_i64_countRange(sl, lo, hi) == expected);
+    }
+}
+
+void test_rank_i64() {
+    printf("test_rank_i64()\n");
+    SkipList_i64 * sl = skipList_i64_create_with_flags(SKIPLIST_INDEXABLE);
+    int64_t out;
+    assert(skipList_i64_rank(sl, 0) == 0);
+    assert(!skipList_i64_select(sl, 0, &out));
+    printf("[test_rank_i64] random inserts\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_i64_insert(sl, (int64_t)(-4000 + rand() % KEY_RANGE));
+    }
+    check_index_i64(sl);
+    printf("[test_rank_i64] removes, pops and finger updates\n");
+    SkipListFinger_i64 * f = skipList_i64_finger_create(sl);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        int64_t key = (int64_t)(-4000 + rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_i64_remove(sl, key); break;
+            case 1: skipList_i64_pop(sl, &out); break;
+            case 2: skipList_i64_finger_insert(f, key); break;
+            case 3: skipList_i64_finger_remove(f, key); break;
+            default: skipList_i64_insert(sl, key); break;
+        }
+    }
+    skipList_i64_finger_destroy(&f);
+    check_index_i64(sl);
+    while (skipList_i64_pop(sl, &out));
+    assert(!skipList_i64_select(sl, 0, &out));
+    skipList_i64_insert(sl, (int64_t)-4000);
+    check_index_i64(sl);
+    skipList_i64_destroy(&sl);
+
+    printf("[test_rank_i64] arena backed indexable map\n");
+    SkipMap_i64 * sm = skipMap_i64_create_with_flags(SKIPLIST_INDEXABLE | SKIPLIST_ARENA);
+    for (int i = 0; i < 1000; i++) {
+        skipMap_i64_put(sm, (int64_t)(-4000 + 2 * i), (void *)(intptr_t)(i + 1));
+    }
+    struct SM_i64_kv kv;
+    // the 99th percentile of 1000 entries
+    assert(skipMap_i64_select(sm, 990, &kv));
+    assert(kv.key == -2020 && kv.value == (void *)(intptr_t)991);
+    assert(skipMap_i64_rank(sm, -3899) == 51);
+    assert(skipMap_i64_countRange(sm, -3990, -3980) == 5);
+    skipMap_i64_remove(sm, -3988);
+    assert(skipMap_i64_countRange(sm, -3990, -3980) == 4);
+    while (skipMap_i64_pop(sm, &kv));
+    skipMap_i64_destroy(&sm);
+    printf("[test_rank_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void check_index_u64(SkipList_u64 * sl) {
+    static uint64_t keys[KEY_RANGE];
+    uint32_t n = 0;
+    SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+    for (; skipList_u64_iter_valid(it); skipList_u64_iter_next(it)) {
+        keys[n++] = skipList_u64_iter_key(it);
+    }
+    skipList_u64_iter_destroy(&it);
+    assert(n == skipList_u64_getSize(sl));
+    uint64_t out;
+    for (uint32_t i = 0; i < n; i++) {
+        assert(skipList_u64_select(sl, i, &out) && out == keys[i]);
+        assert(skipList_u64_rank(sl, keys[i]) == i);
+    }
+    assert(!skipList_u64_select(sl, n, &out));
+    for (int r = 0; r < 100; r++) {
+        uint64_t lo = (uint64_t)(rand() % KEY_RANGE);
+        uint64_t hi = (uint64_t)(lo + rand() % 500);
+        uint32_t expected = 0;
+        for (uint32_t i = 0; i < n; i++) expected += keys[i] >= lo && keys[i] < hi;
+        assert(skipList_u64_countRange(sl, lo, hi) == expected);
+    }
+}
+
+void test_rank_u64() {
+    printf("test_rank_u64()\n");
+    SkipList_u64 * sl = skipList_u64_create_with_flags(SKIPLIST_INDEXABLE);
+    uint64_t out;
+    assert(skipList_u64_rank(sl, 0) == 0);
+    assert(!skipList_u64_select(sl, 0, &out));
+    printf("[test_rank_u64] random inserts\n");
+    for (int i = 0; i < TEST_SIZE; i++) {
+        skipList_u64_insert(sl, (uint64_t)(rand() % KEY_RANGE));
+    }
+    check_index_u64(sl);
+    printf("[test_rank_u64] removes, pops and finger updates\n");
+    SkipListFinger_u64 * f = skipList_u64_finger_create(sl);
+    for (int i = 0; i < TEST_SIZE; i++) {
+        uint64_t key = (uint64_t)(rand() % KEY_RANGE);
+        switch (rand() % 5) {
+            case 0: skipList_u64_remove(sl, key); break;
+            case 1: skipList_u64_pop(sl, &out); break;
+            case 2: skipList_u64_finger_insert(f, key); break;
+            case 3: skipList_u64_finger_remove(f, key); break;
+            default: skipList_u64_insert(sl, key); break;
+        }
+    }
+    skipList_u64_finger_destroy(&f);
+    check_index_u64(sl);
+    while (skipList_u64_pop(sl, &out));
+    assert(!skipList_u64_select(sl, 0, &out));
+    skipList_u64_insert(sl, 0);
+    check_index_u64(sl);
+    skipList_u64_destroy(&sl);
+
+    printf("[test_rank_u64] arena backed indexable map\n");
+    SkipMap_u64 * sm = skipMap_u64_create_with_flags(SKIPLIST_INDEXABLE | SKIPLIST_ARENA);
+    for (int i = 0; i < 1000; i++) {
+        skipMap_u64_put(sm, (uint64_t)(2 * i), (void *)(intptr_t)(i + 1));
+    }
+    struct SM_u64_kv kv;
+    // the 99th percentile of 1000 entries
+    assert(skipMap_u64_select(sm, 990, &kv));
+    assert(kv.key == 1980 && kv.value == (void *)(intptr_t)991);
+    assert(skipMap_u64_rank(sm, 101) == 51);
+    assert(skipMap_u64_countRange(sm, 10, 20) == 5);
+    skipMap_u64_remove(sm, 12);
+    assert(skipMap_u64_countRange(sm, 10, 20) == 4);
+    while (skipMap_u64_pop(sm, &kv));
+    skipMap_u64_destroy(&sm);
+    printf("[test_rank_u64] ✅\n");
+}
+
+
+int main() {
+    test_rank_i32();
+    test_rank_u32();
+    test_rank_i64();
+    test_rank_u64();
+    return 0;
+}
@@ -0,0 +1,415 @@
+#include <skiplist.h>
+#include <skiplist_generic.h>
+#include <skipmap_generic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define N 20000
+
+#define cmp_int_func(a,b) ((a > b) - (a < b))
+DEFINE_GENERIC_SKIPLIST(Relevel, int32_t, cmp_int_func, NO_OP)
+DEFINE_GENERIC_SKIPMAP(RelevelMap, int32_t, int32_t, cmp_int_func, NO_OP, NO_OP)
+
+// the generic nodes are visible, after a pass the n-th node is promoted once
+// per time 3 (1/P rounded) divides n
+static void test_generic() {
+    printf("test_generic()\n");
+    printf("[test_generic] heights follow the position after a pass\n");
+    SkipList_Relevel * sl = SkipList_Relevel_create(0);
+    for (int32_t i = 1; i <= N; i++) SkipList_Relevel_insert(sl, i);
+    for (int32_t i = 1; i <= N; i++) if (i % 4) SkipList_Relevel_remove(sl, i);
+    assert(SkipList_Relevel_rebalance(sl) > 0);
+    uint32_t n = 0;
+    for (Node_Relevel * x = sl->header->forward[0]; x; x = x->forward[0]) {
+        uint32_t height = 1;
+        for (uint32_t m = ++n; m % 3 == 0; m /= 3) height++;
+        assert(x->height == height);
+    }
+    assert(n == N / 4);
+    assert(SkipList_Relevel_rebalance(sl) == 0);
+    for (int32_t i = 1; i <= N; i++) assert(SkipList_Relevel_search(sl, i) == (i % 4 == 0));
+    SkipList_Relevel_destroy(&sl);
+    printf("[test_generic] maps keep their values\n");
+    SkipMap_RelevelMap * sm = SkipMap_RelevelMap_create(0, 0);
+    for (int32_t i = 1; i <= 1000; i++) SkipMap_RelevelMap_put(sm, i, -i);
+    SkipMap_RelevelMap_rebalance(sm);
+    for (int32_t i = 1; i <= 1000; i++) {
+        int32_t value = 0;
+        assert(SkipMap_RelevelMap_get(sm, i, &value) && value == -i);
+    }
+    SkipMap_RelevelMap_destroy(&sm);
+    printf("[test_generic] ✅\n");
+}
+
+// a pass has to keep spans, back links and tails right while towers move, a
+// second pass finds nothing to change. With a rebalance_step the puts after a
+// mass delete, which only replace values, do the same work a little at a time
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+void test_rebalance_i32() {
+    printf("test_rebalance_i32()\n");
+    printf("[test_rebalance_i32] full pass after mass deletes\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS, .seed = 11 };
+    SkipList_i32 * sl = skipList_i32_create_with_options(&options);
+    for (int32_t i = 0; i < N; i++) skipList_i32_insert(sl, i);
+    for (int32_t i = 0; i < N; i++) if (i % 4) skipList_i32_remove(sl, i);
+    assert(skipList_i32_rebalance(sl) > 0);
+    assert(skipList_i32_rebalance(sl) == 0);
+    assert(skipList_i32_getSize(sl) == N / 4);
+    int32_t out;
+    for (uint32_t r = 0; r < N / 4; r++) {
+        assert(skipList_i32_select(sl, r, &out) && out == (int32_t)(r * 4));
+        assert(skipList_i32_rank(sl, out) == r);
+    }
+    SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+    skipList_i32_iter_last(it);
+    for (int32_t i = N - 4; skipList_i32_iter_valid(it); i -= 4) {
+        assert(skipList_i32_iter_key(it) == i);
+        skipList_i32_iter_prev(it);
+    }
+    skipList_i32_iter_destroy(&it);
+    for (int32_t i = 0; i < N; i++) skipList_i32_insert(sl, i);
+    assert(skipList_i32_getSize(sl) == N);
+    assert(skipList_i32_rank(sl, N - 1) == N - 1);
+    skipList_i32_destroy(&sl);
+    printf("[test_rebalance_i32] incremental passes\n");
+    SkipMap_i32 * plain = skipMap_i32_create_with_options(&options);
+    options.rebalance_step = 8;
+    SkipMap_i32 * stepped = skipMap_i32_create_with_options(&options);
+    for (int32_t i = 0; i < N; i++) {
+        skipMap_i32_put(plain, i, NULL);
+        skipMap_i32_put(stepped, i, NULL);
+    }
+    for (int32_t i = 0; i < N; i++) {
+        if (i % 4) {
+            skipMap_i32_remove(plain, i);
+            skipMap_i32_remove(stepped, i);
+        }
+    }
+    for (int32_t i = 0; i < N; i += 4) {
+        int32_t * a = malloc(sizeof(int32_t)), * b = malloc(sizeof(int32_t));
+        *a = *b = i;
+        skipMap_i32_put(plain, i, a);
+        skipMap_i32_put(stepped, i, b);
+    }
+    for (int32_t i = 0; i < N; i += 4) {
+        assert(*(int32_t *)skipMap_i32_get(stepped, i) == i);
+        assert(skipMap_i32_rank(stepped, i) == (uint32_t)i / 4);
+    }
+    uint32_t left = skipMap_i32_rebalance(stepped);
+    uint32_t changed = skipMap_i32_rebalance(plain);
+    assert(left * 4 < changed);
+    skipMap_i32_destroy(&plain);
+    skipMap_i32_destroy(&stepped);
+    printf("[test_rebalance_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+void test_rebalance_u32() {
+    printf("test_rebalance_u32()\n");
+    printf("[test_rebalance_u32] full pass after mass deletes\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS, .seed = 11 };
+    SkipList_u32 * sl = skipList_u32_create_with_options(&options);
+    for (uint32_t i = 0; i < N; i++) skipList_u32_insert(sl, i);
+    for (uint32_t i = 0; i < N; i++) if (i % 4) skipList_u32_remove(sl, i);
+    assert(skipList_u32_rebalance(sl) > 0);
+    assert(skipList_u32_rebalance(sl) == 0);
+    assert(skipList_u32_getSize(sl) == N / 4);
+    uint32_t out;
+    for (uint32_t r = 0; r < N / 4; r++) {
+        assert(skipList_u32_select(sl, r, &out) && out == (uint32_t)(r * 4));
+        assert(skipList_u32_rank(sl, out) == r);
+    }
+    SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+    skipList_u32_iter_last(it);
+    for (uint32_t i = N - 4; skipList_u32_iter_valid(it); i -= 4) {
+        assert(skipList_u32_iter_key(it) == i);
+        skipList_u32_iter_prev(it);
+    }
+    skipList_u32_iter_destroy(&it);
+    for (uint32_t i = 0; i < N; i++) skipList_u32_insert(sl, i);
+    assert(skipList_u32_getSize(sl) == N);
+    assert(skipList_u32_rank(sl, N - 1) == N - 1);
+    skipList_u32_destroy(&sl);
+    printf("[test_rebalance_u32] incremental passes\n");
+    SkipMap_u32 * plain = skipMap_u32_create_with_options(&options);
+    options.rebalance_step = 8;
+    SkipMap_u32 * stepped = skipMap_u32_create_with_options(&options);
+    for (uint32_t i = 0; i < N; i++) {
+        skipMap_u32_put(plain, i, NULL);
+        skipMap_u32_put(stepped, i, NULL);
+    }
+    for (uint32_t i = 0; i < N; i++) {
+        if (i % 4) {
+            skipMap_u32_remove(plain, i);
+            skipMap_u32_remove(stepped, i);
+        }
+    }
+    for (uint32_t i = 0; i < N; i += 4) {
+        uint32_t * a = malloc(sizeof(uint32_t)), * b = malloc(sizeof(uint32_t));
+        *a = *b = i;
+        skipMap_u32_put(plain, i, a);
+        skipMap_u32_put(stepped, i, b);
+    }
+    for (uint32_t i = 0; i < N; i += 4) {
+        assert(*(uint32_t *)skipMap_u32_get(stepped, i) == i);
+        assert(skipMap_u32_rank(stepped, i) == (uint32_t)i / 4);
+    }
+    uint32_t left = skipMap_u32_rebalance(stepped);
+    uint32_t changed = skipMap_u32_rebalance(plain);
+    assert(left * 4 < changed);
+    skipMap_u32_destroy(&plain);
+    skipMap_u32_destroy(&stepped);
+    printf("[test_rebalance_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+void test_rebalance_i64() {
+    printf("test_rebalance_i64()\n");
+    printf("[test_rebalance_i64] full pass after mass deletes\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS, .seed = 11 };
+    SkipList_i64 * sl = skipList_i64_create_with_options(&options);
+    for (int64_t i = 0; i < N; i++) skipList_i64_insert(sl, i);
+    for (int64_t i = 0; i < N; i++) if (i % 4) skipList_i64_remove(sl, i);
+    assert(skipList_i64_rebalance(sl) > 0);
+    assert(skipList_i64_rebalance(sl) == 0);
+    assert(skipList_i64_getSize(sl) == N / 4);
+    int64_t out;
+    for (uint32_t r = 0; r < N / 4; r++) {
+        assert(skipList_i64_select(sl, r, &out) && out == (int64_t)(r * 4));
+        assert(skipList_i64_rank(sl, out) == r);
+    }
+    SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+    skipList_i64_iter_last(it);
+    for (int64_t i = N - 4; skipList_i64_iter_valid(it); i -= 4) {
+        assert(skipList_i64_iter_key(it) == i);
+        skipList_i64_iter_prev(it);
+    }
+    skipList_i64_iter_destroy(&it);
+    for (int64_t i = 0; i < N; i++) skipList_i64_insert(sl, i);
+    assert(skipList_i64_getSize(sl) == N);
+    assert(skipList_i64_rank(sl, N - 1) == N - 1);
+    skipList_i64_destroy(&sl);
+    printf("[test_rebalance_i64] incremental passes\n");
+    SkipMap_i64 * plain = skipMap_i64_create_with_options(&options);
+    options.rebalance_step = 8;
+    SkipMap_i64 * stepped = skipMap_i64_create_with_options(&options);
+    for (int64_t i = 0; i < N; i++) {
+        skipMap_i64_put(plain, i, NULL);
+        skipMap_i64_put(stepped, i, NULL);
+    }
+    for (int64_t i = 0; i < N; i++) {
+        if (i % 4) {
+            skipMap_i64_remove(plain, i);
+            skipMap_i64_remove(stepped, i);
+        }
+    }
+    for (int64_t i = 0; i < N; i += 4) {
+        int64_t * a = malloc(sizeof(int64_t)), * b = malloc(sizeof(int64_t));
+        *a = *b = i;
+        skipMap_i64_put(plain, i, a);
+        skipMap_i64_put(stepped, i, b);
+    }
+    for (int64_t i = 0; i < N; i += 4) {
+        assert(*(int64_t *)skipMap_i64_get(stepped, i) == i);
+        assert(skipMap_i64_rank(stepped, i) == (uint32_t)i / 4);
+    }
+    uint32_t left = skipMap_i64_rebalance(stepped);
+    uint32_t changed = skipMap_i64_rebalance(plain);
+    assert(left * 4 < changed);
+    skipMap_i64_destroy(&plain);
+    skipMap_i64_destroy(&stepped);
+    printf("[test_rebalance_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+void test_rebalance_u64() {
+    printf("test_rebalance_u64()\n");
+    printf("[test_rebalance_u64] full pass after mass deletes\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS, .seed = 11 };
+    SkipList_u64 * sl = skipList_u64_create_with_options(&options);
+    for (uint64_t i = 0; i < N; i++) skipList_u64_insert(sl, i);
+    for (uint64_t i = 0; i < N; i++) if (i % 4) skipList_u64_remove(sl, i);
+    assert(skipList_u64_rebalance(sl) > 0);
+    assert(skipList_u64_rebalance(sl) == 0);
+    assert(skipList_u64_getSize(sl) == N / 4);
+    uint64_t out;
+    for (uint32_t r = 0; r < N / 4; r++) {
+        assert(skipList_u64_select(sl, r, &out) && out == (uint64_t)(r * 4));
+        assert(skipList_u64_rank(sl, out) == r);
+    }
+    SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+    skipList_u64_iter_last(it);
+    for (uint64_t i = N - 4; skipList_u64_iter_valid(it); i -= 4) {
+        assert(skipList_u64_iter_key(it) == i);
+        skipList_u64_iter_prev(it);
+    }
+    skipList_u64_iter_destroy(&it);
+    for (uint64_t i = 0; i < N; i++) skipList_u64_insert(sl, i);
+    assert(skipList_u64_getSize(sl) == N);
+    assert(skipList_u64_rank(sl, N - 1) == N - 1);
+    skipList_u64_destroy(&sl);
+    printf("[test_rebalance_u64] incremental passes\n");
+    SkipMap_u64 * plain = skipMap_u64_create_with_options(&options);
+    options.rebalance_step = 8;
+    SkipMap_u64 * stepped = skipMap_u64_create_with_options(&options);
+    for (uint64_t i = 0; i < N; i++) {
+        skipMap_u64_put(plain, i, NULL);
+        skipMap_u64_put(stepped, i, NULL);
+    }
+    for (uint64_t i = 0; i < N; i++) {
+        if (i % 4) {
+            skipMap_u64_remove(plain, i);
+            skipMap_u64_remove(stepped, i);
+        }
+    }
+    for (uint64_t i = 0; i < N; i += 4) {
+        uint64_t * a = malloc(sizeof(uint64_t)), * b = malloc(sizeof(uint64_t));
+        *a = *b = i;
+        skipMap_u64_put(plain, i, a);
+        skipMap_u64_put(stepped, i, b);
+    }
+    for (uint64_t i = 0; i < N; i += 4) {
+        assert(*(uint64_t *)skipMap_u64_get(stepped, i) == i);
+        assert(skipMap_u64_rank(stepped, i) == (uint32_t)i / 4);
+    }
+    uint32_t left = skipMap_u64_rebalance(stepped);
+    uint32_t changed = skipMap_u64_rebalance(plain);
+    assert(left * 4 < changed);
+    skipMap_u64_destroy(&plain);
+    skipMap_u64_destroy(&stepped);
+    printf("[test_rebalance_u64] ✅\n");
+}
+
+
+// pops, range removals and batches drive the incremental pass as well, a mass
+// delete through them leaves a full pass little or nothing to do
+void test_bulk_steps_i32() {
+    printf("test_bulk_steps_i32()\n");
+    printf("[test_bulk_steps_i32] removeRange and removeBatch finish the pass they start\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE, .seed = 5 };
+    SkipList_i32 * plain = skipList_i32_create_with_options(&options);
+    options.rebalance_step = 8;
+    SkipList_i32 * stepped = skipList_i32_create_with_options(&options);
+    for (int32_t i = 0; i < N; i++) {
+        skipList_i32_insert(plain, i);
+        skipList_i32_insert(stepped, i);
+    }
+    assert(skipList_i32_removeRange(plain, 0, N / 4 * 3, NULL, NULL) == N / 4 * 3);
+    assert(skipList_i32_removeRange(stepped, 0, N / 4 * 3, NULL, NULL) == N / 4 * 3);
+    assert(skipList_i32_rebalance(plain) > 0);
+    assert(skipList_i32_rebalance(stepped) == 0);
+    static int32_t drop[N];
+    uint32_t n = 0;
+    for (int32_t i = 0; i < N / 4 * 3; i++) {
+        skipList_i32_insert(plain, i);
+        skipList_i32_insert(stepped, i);
+    }
+    for (int32_t i = 0; i < N; i++) {
+        if (i % 4) drop[n++] = i;
+    }
+    assert(skipList_i32_removeBatch(plain, drop, n) == n);
+    assert(skipList_i32_removeBatch(stepped, drop, n) == n);
+    assert(skipList_i32_rebalance(plain) > 0);
+    assert(skipList_i32_rebalance(stepped) == 0);
+    printf("[test_bulk_steps_i32] pop and popMax step like remove\n");
+    for (int32_t i = 0; i < N; i++) {
+        skipList_i32_insert(plain, i);
+        skipList_i32_insert(stepped, i);
+    }
+    skipList_i32_rebalance(plain);
+    skipList_i32_rebalance(stepped);
+    int32_t out;
+    for (uint32_t i = 0; i < N / 8 * 3 - 1; i++) {
+        assert(skipList_i32_pop(plain, &out));
+        assert(skipList_i32_pop(stepped, &out));
+        assert(skipList_i32_popMax(plain, &out));
+        assert(skipList_i32_popMax(stepped, &out));
+    }
+    assert(skipList_i32_getSize(stepped) == N / 4 + 2);
+    // every pop shifts the rank of the keys already visited, so the pass can
+    // not finish the way it does for removals past the front
+    uint32_t left = skipList_i32_rebalance(stepped);
+    uint32_t changed = skipList_i32_rebalance(plain);
+    assert(left * 2 < changed);
+    skipList_i32_destroy(&plain);
+    skipList_i32_destroy(&stepped);
+    printf("[test_bulk_steps_i32] ✅\n");
+}
+
+// pops, range removals and batches drive the incremental pass as well, a mass
+// delete through them leaves a full pass little or nothing to do
+void test_bulk_steps_u64() {
+    printf("test_bulk_steps_u64()\n");
+    printf("[test_bulk_steps_u64] removeRange and removeBatch finish the pass they start\n");
+    SkipListOptions options = { .flags = SKIPLIST_INDEXABLE, .seed = 5 };
+    SkipList_u64 * plain = skipList_u64_create_with_options(&options);
+    options.rebalance_step = 8;
+    SkipList_u64 * stepped = skipList_u64_create_with_options(&options);
+    for (uint64_t i = 0; i < N; i++) {
+        skipList_u64_insert(plain, i);
+        skipList_u64_insert(stepped, i);
+    }
+    assert(skipList_u64_removeRange(plain, 0, N / 4 * 3, NULL, NULL) == N / 4 * 3);
+    assert(skipList_u64_removeRange(stepped, 0, N / 4 * 3, NULL, NULL) == N / 4 * 3);
+    assert(skipList_u64_rebalance(plain) > 0);
+    assert(skipList_u64_rebalance(stepped) == 0);
+    static uint64_t drop[N];
+    uint32_t n = 0;
+    for (uint64_t i = 0; i < N / 4 * 3; i++) {
+        skipList_u64_insert(plain, i);
+        skipList_u64_insert(stepped, i);
+    }
+    for (uint64_t i = 0; i < N; i++) {
+        if (i % 4) drop[n++] = i;
+    }
+    assert(skipList_u64_removeBatch(plain, drop, n) == n);
+    assert(skipList_u64_removeBatch(stepped, drop, n) == n);
+    assert(skipList_u64_rebalance(plain) > 0);
+    assert(skipList_u64_rebalance(stepped) == 0);
+    printf("[test_bulk_steps_u64] pop and popMax step like remove\n");
+    for (uint64_t i = 0; i < N; i++) {
+        skipList_u64_insert(plain, i);
+        skipList_u64_insert(stepped, i);
+    }
+    skipList_u64_rebalance(plain);
+    skipList_u64_rebalance(stepped);
+    uint64_t out;
+    for (uint32_t i = 0; i < N / 8 * 3 - 1; i++) {
+        assert(skipList_u64_pop(plain, &out));
+        assert(skipList_u64_pop(stepped, &out));
+        assert(skipList_u64_popMax(plain, &out));
+        assert(skipList_u64_popMax(stepped, &out));
+    }
+    assert(skipList_u64_getSize(stepped) == N / 4 + 2);
+    // every pop shifts the rank of the keys already visited, so the pass can
+    // not finish the way it does for removals past the front
+    uint32_t left = skipList_u64_rebalance(stepped);
+    uint32_t changed = skipList_u64_rebalance(plain);
+    assert(left * 2 < changed);
+    skipList_u64_destroy(&plain);
+    skipList_u64_destroy(&stepped);
+    printf("[test_bulk_steps_u64] ✅\n");
+}
+
+int main() {
+    test_generic();
+    test_rebalance_i32();
+    test_rebalance_u32();
+    test_rebalance_i64();
+    test_rebalance_u64();
+    test_bulk_steps_i32();
+    test_bulk_steps_u64();
+    printf("[test_rebalance] ✅\n");
+    return 0;
+}
@@ -0,0 +1,395 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define ROUNDS 300
+#define KEY_RANGE 2000
+
+// present[] is the reference set, the callback checks keys arrive ascending
+// inside the requested range and counts them
+struct seen { int64_t prev; int64_t lo; int64_t hi; uint32_t count; intptr_t sum; };
+
+
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void onKey_i32(int32_t key, void *ctx) {
+    struct seen *s = ctx;
+    assert((int64_t)key >= s->lo && (int64_t)key < s->hi && (int64_t)key > s->prev);
+    s->prev = key;
+    s->count++;
+}
+
+static void onEntry_i32(int32_t key, void *value, void *ctx) {
+    struct seen *s = ctx;
+    assert((intptr_t)value == (intptr_t)((int64_t)key + 1000) + 1);
+    s->count++;
+    s->sum += (intptr_t)value;
+}
+
+static void run_remove_range_i32(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_i32 * sl = skipList_i32_create_with_flags(flags);
+    assert(skipList_i32_removeRange(sl, (int32_t)-1000, -990, NULL, NULL) == 0);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 40; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_i32_insert(sl, (int32_t)(-1000 + k));
+            present[k] = true;
+        }
+        int lo = rand() % KEY_RANGE, hi = lo + rand() % 64;
+        if (round % 50 == 0) hi = KEY_RANGE;
+        uint32_t expect = 0;
+        for (int k = lo; k < hi && k < KEY_RANGE; k++) {
+            if (present[k]) { expect++; present[k] = false; }
+        }
+        struct seen s = { INT64_MIN, (int64_t)-1000 + lo, (int64_t)-1000 + hi, 0, 0 };
+        uint32_t got = skipList_i32_removeRange(sl, (int32_t)(-1000 + lo), (int32_t)(-1000 + hi),
+                                                  onKey_i32, &s);
+        assert(got == expect && s.count == expect);
+        uint32_t n = 0;
+        for (int k = 0; k < KEY_RANGE; k++) {
+            assert(skipList_i32_search(sl, (int32_t)(-1000 + k)) == present[k]);
+            n += present[k];
+        }
+        assert(skipList_i32_getSize(sl) == n);
+        int32_t out;
+        if (flags & SKIPLIST_INDEXABLE) {
+            for (uint32_t i = 0; i < n; i++) {
+                assert(skipList_i32_select(sl, i, &out));
+                assert(skipList_i32_rank(sl, out) == i);
+            }
+        }
+        int max = KEY_RANGE - 1;
+        while (max >= 0 && !present[max]) max--;
+        assert(skipList_i32_peekMax(sl, &out) == (max >= 0));
+        if (max >= 0) assert(out == (int32_t)(-1000 + max));
+        if (flags & SKIPLIST_BACKLINKS) {
+            SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+            uint32_t walked = 0;
+            for (skipList_i32_iter_last(it); skipList_i32_iter_valid(it);
+                 skipList_i32_iter_prev(it)) walked++;
+            assert(walked == n);
+            skipList_i32_iter_destroy(&it);
+        }
+    }
+    skipList_i32_removeRange(sl, (int32_t)-1000, (int32_t)(-1000 + KEY_RANGE), NULL, NULL);
+    assert(skipList_i32_isEmpty(sl));
+    skipList_i32_insert(sl, (int32_t)-1000);
+    assert(skipList_i32_search(sl, (int32_t)-1000) && skipList_i32_getSize(sl) == 1);
+    skipList_i32_destroy(&sl);
+}
+
+void test_remove_range_i32() {
+    printf("test_remove_range_i32()\n");
+    printf("[test_remove_range_i32] random ranges against a reference set\n");
+    run_remove_range_i32(0);
+    run_remove_range_i32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_remove_range_i32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_remove_range_i32] maps hand values to the callback\n");
+    SkipMap_i32 * sm = skipMap_i32_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_i32_put(sm, (int32_t)(-1000 + i), (void *)(intptr_t)(i + 1));
+    }
+    struct seen s = { 0, 0, 0, 0, 0 };
+    assert(skipMap_i32_removeRange(sm, -990, -980,
+                                     onEntry_i32, &s) == 10);
+    assert(s.count == 10 && s.sum == 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19 + 20);
+    assert(skipMap_i32_get(sm, -991) && !skipMap_i32_get(sm, -990));
+    assert(skipMap_i32_removeRange(sm, (int32_t)-1000, -900, onEntry_i32, &s) == 90);
+    assert(s.count == 100 && skipMap_i32_getSize(sm) == 0);
+    skipMap_i32_destroy(&sm);
+    printf("[test_remove_range_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void onKey_u32(uint32_t key, void *ctx) {
+    struct seen *s = ctx;
+    assert((int64_t)key >= s->lo && (int64_t)key < s->hi && (int64_t)key > s->prev);
+    s->prev = key;
+    s->count++;
+}
+
+static void onEntry_u32(uint32_t key, void *value, void *ctx) {
+    struct seen *s = ctx;
+    assert((intptr_t)value == (intptr_t)((int64_t)key) + 1);
+    s->count++;
+    s->sum += (intptr_t)value;
+}
+
+static void run_remove_range_u32(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_u32 * sl = skipList_u32_create_with_flags(flags);
+    assert(skipList_u32_removeRange(sl, 0, 10, NULL, NULL) == 0);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 40; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_u32_insert(sl, (uint32_t)k);
+            present[k] = true;
+        }
+        int lo = rand() % KEY_RANGE, hi = lo + rand() % 64;
+        if (round % 50 == 0) hi = KEY_RANGE;
+        uint32_t expect = 0;
+        for (int k = lo; k < hi && k < KEY_RANGE; k++) {
+            if (present[k]) { expect++; present[k] = false; }
+        }
+        struct seen s = { INT64_MIN, 0 + lo, 0 + hi, 0, 0 };
+        uint32_t got = skipList_u32_removeRange(sl, (uint32_t)lo, (uint32_t)hi,
+                                                  onKey_u32, &s);
+        assert(got == expect && s.count == expect);
+        uint32_t n = 0;
+        for (int k = 0; k < KEY_RANGE; k++) {
+            assert(skipList_u32_search(sl, (uint32_t)k) == present[k]);
+            n += present[k];
+        }
+        assert(skipList_u32_getSize(sl) == n);
+        uint32_t out;
+        if (flags & SKIPLIST_INDEXABLE) {
+            for (uint32_t i = 0; i < n; i++) {
+                assert(skipList_u32_select(sl, i, &out));
+                assert(skipList_u32_rank(sl, out) == i);
+            }
+        }
+        int max = KEY_RANGE - 1;
+        while (max >= 0 && !present[max]) max--;
+        assert(skipList_u32_peekMax(sl, &out) == (max >= 0));
+        if (max >= 0) assert(out == (uint32_t)max);
+        if (flags & SKIPLIST_BACKLINKS) {
+            SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+            uint32_t walked = 0;
+            for (skipList_u32_iter_last(it); skipList_u32_iter_valid(it);
+                 skipList_u32_iter_prev(it)) walked++;
+            assert(walked == n);
+            skipList_u32_iter_destroy(&it);
+        }
+    }
+    skipList_u32_removeRange(sl, 0, (uint32_t)KEY_RANGE, NULL, NULL);
+    assert(skipList_u32_isEmpty(sl));
+    skipList_u32_insert(sl, 0);
+    assert(skipList_u32_search(sl, 0) && skipList_u32_getSize(sl) == 1);
+    skipList_u32_destroy(&sl);
+}
+
+void test_remove_range_u32() {
+    printf("test_remove_range_u32()\n");
+    printf("[test_remove_range_u32] random ranges against a reference set\n");
+    run_remove_range_u32(0);
+    run_remove_range_u32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_remove_range_u32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_remove_range_u32] maps hand values to the callback\n");
+    SkipMap_u32 * sm = skipMap_u32_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_u32_put(sm, (uint32_t)i, (void *)(intptr_t)(i + 1));
+    }
+    struct seen s = { 0, 0, 0, 0, 0 };
+    assert(skipMap_u32_removeRange(sm, 10, 20,
+                                     onEntry_u32, &s) == 10);
+    assert(s.count == 10 && s.sum == 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19 + 20);
+    assert(skipMap_u32_get(sm, 9) && !skipMap_u32_get(sm, 10));
+    assert(skipMap_u32_removeRange(sm, 0, 100, onEntry_u32, &s) == 90);
+    assert(s.count == 100 && skipMap_u32_getSize(sm) == 0);
+    skipMap_u32_destroy(&sm);
+    printf("[test_remove_range_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void onKey_i64(int64_t key, void *ctx) {
+    struct seen *s = ctx;
+    assert((int64_t)key >= s->lo && (int64_t)key < s->hi && (int64_t)key > s->prev);
+    s->prev = key;
+    s->count++;
+}
+
+static void onEntry_i64(int64_t key, void *value, void *ctx) {
+    struct seen *s = ctx;
+    assert((intptr_t)value == (intptr_t)((int64_t)key + 1000) + 1);
+    s->count++;
+    s->sum += (intptr_t)value;
+}
+
+static void run_remove_range_i64(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_i64 * sl = skipList_i64_create_with_flags(flags);
+    assert(skipList_i64_removeRange(sl, (int64_t)-1000, -990, NULL, NULL) == 0);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 40; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_i64_insert(sl, (int64_t)(-1000 + k));
+            present[k] = true;
+        }
+        int lo = rand() % KEY_RANGE, hi = lo + rand() % 64;
+        if (round % 50 == 0) hi = KEY_RANGE;
+        uint32_t expect = 0;
+        for (int k = lo; k < hi && k < KEY_RANGE; k++) {
+            if (present[k]) { expect++; present[k] = false; }
+        }
+        struct seen s = { INT64_MIN, (int64_t)-1000 + lo, (int64_t)-1000 + hi, 0, 0 };
+        uint32_t got = skipList_i64_removeRange(sl, (int64_t)(-1000 + lo), (int64_t)(-1000 + hi),
+                                                  onKey_i64, &s);
+        assert(got == expect && s.count == expect);
+        uint32_t n = 0;
+        for (int k = 0; k < KEY_RANGE; k++) {
+            assert(skipList_i64_search(sl, (int64_t)(-1000 + k)) == present[k]);
+            n += present[k];
+        }
+        assert(skipList_i64_getSize(sl) == n);
+        int64_t out;
+        if (flags & SKIPLIST_INDEXABLE) {
+            for (uint32_t i = 0; i < n; i++) {
+                assert(skipList_i64_select(sl, i, &out));
+                assert(skipList_i64_rank(sl, out) == i);
+            }
+        }
+        int max = KEY_RANGE - 1;
+        while (max >= 0 && !present[max]) max--;
+        assert(skipList_i64_peekMax(sl, &out) == (max >= 0));
+        if (max >= 0) assert(out == (int64_t)(-1000 + max));
+        if (flags & SKIPLIST_BACKLINKS) {
+            SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+            uint32_t walked = 0;
+            for (skipList_i64_iter_last(it); skipList_i64_iter_valid(it);
+                 skipList_i64_iter_prev(it)) walked++;
+            assert(walked == n);
+            skipList_i64_iter_destroy(&it);
+        }
+    }
+    skipList_i64_removeRange(sl, (int64_t)-1000, (int64_t)(-1000 + KEY_RANGE), NULL, NULL);
+    assert(skipList_i64_isEmpty(sl));
+    skipList_i64_insert(sl, (int64_t)-1000);
+    assert(skipList_i64_search(sl, (int64_t)-1000) && skipList_i64_getSize(sl) == 1);
+    skipList_i64_destroy(&sl);
+}
+
+void test_remove_range_i64() {
+    printf("test_remove_range_i64()\n");
+    printf("[test_remove_range_i64] random ranges against a reference set\n");
+    run_remove_range_i64(0);
+    run_remove_range_i64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_remove_range_i64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_remove_range_i64] maps hand values to the callback\n");
+    SkipMap_i64 * sm = skipMap_i64_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_i64_put(sm, (int64_t)(-1000 + i), (void *)(intptr_t)(i + 1));
+    }
+    struct seen s = { 0, 0, 0, 0, 0 };
+    assert(skipMap_i64_removeRange(sm, -990, -980,
+                                     onEntry_i64, &s) == 10);
+    assert(s.count == 10 && s.sum == 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19 + 20);
+    assert(skipMap_i64_get(sm, -991) && !skipMap_i64_get(sm, -990));
+    assert(skipMap_i64_removeRange(sm, (int64_t)-1000, -900, onEntry_i64, &s) == 90);
+    assert(s.count == 100 && skipMap_i64_getSize(sm) == 0);
+    skipMap_i64_destroy(&sm);
+    printf("[test_remove_range_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void onKey_u64(uint64_t key, void *ctx) {
+    struct seen *s = ctx;
+    assert((int64_t)key >= s->lo && (int64_t)key < s->hi && (int64_t)key > s->prev);
+    s->prev = key;
+    s->count++;
+}
+
+static void onEntry_u64(uint64_t key, void *value, void *ctx) {
+    struct seen *s = ctx;
+    assert((intptr_t)value == (intptr_t)((int64_t)key) + 1);
+    s->count++;
+    s->sum += (intptr_t)value;
+}
+
+static void run_remove_range_u64(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_u64 * sl = skipList_u64_create_with_flags(flags);
+    assert(skipList_u64_removeRange(sl, 0, 10, NULL, NULL) == 0);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 40; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_u64_insert(sl, (uint64_t)k);
+            present[k] = true;
+        }
+        int lo = rand() % KEY_RANGE, hi = lo + rand() % 64;
+        if (round % 50 == 0) hi = KEY_RANGE;
+        uint32_t expect = 0;
+        for (int k = lo; k < hi && k < KEY_RANGE; k++) {
+            if (present[k]) { expect++; present[k] = false; }
+        }
+        struct seen s = { INT64_MIN, 0 + lo, 0 + hi, 0, 0 };
+        uint32_t got = skipList_u64_removeRange(sl, (uint64_t)lo, (uint64_t)hi,
+                                                  onKey_u64, &s);
+        assert(got == expect && s.count == expect);
+        uint32_t n = 0;
+        for (int k = 0; k < KEY_RANGE; k++) {
+            assert(skipList_u64_search(sl, (uint64_t)k) == present[k]);
+            n += present[k];
+        }
+        assert(skipList_u64_getSize(sl) == n);
+        uint64_t out;
+        if (flags & SKIPLIST_INDEXABLE) {
+            for (uint32_t i = 0; i < n; i++) {
+                assert(skipList_u64_select(sl, i, &out));
+                assert(skipList_u64_rank(sl, out) == i);
+            }
+        }
+        int max = KEY_RANGE - 1;
+        while (max >= 0 && !present[max]) max--;
+        assert(skipList_u64_peekMax(sl, &out) == (max >= 0));
+        if (max >= 0) assert(out == (uint64_t)max);
+        if (flags & SKIPLIST_BACKLINKS) {
+            SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+            uint32_t walked = 0;
+            for (skipList_u64_iter_last(it); skipList_u64_iter_valid(it);
+                 skipList_u64_iter_prev(it)) walked++;
+            assert(walked == n);
+            skipList_u64_iter_destroy(&it);
+        }
+    }
+    skipList_u64_removeRange(sl, 0, (uint64_t)KEY_RANGE, NULL, NULL);
+    assert(skipList_u64_isEmpty(sl));
+    skipList_u64_insert(sl, 0);
+    assert(skipList_u64_search(sl, 0) && skipList_u64_getSize(sl) == 1);
+    skipList_u64_destroy(&sl);
+}
+
+void test_remove_range_u64() {
+    printf("test_remove_range_u64()\n");
+    printf("[test_remove_range_u64] random ranges against a reference set\n");
+    run_remove_range_u64(0);
+    run_remove_range_u64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_remove_range_u64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_remove_range_u64] maps hand values to the callback\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_u64_put(sm, (uint64_t)i, (void *)(intptr_t)(i + 1));
+    }
+    struct seen s = { 0, 0, 0, 0, 0 };
+    assert(skipMap_u64_removeRange(sm, 10, 20,
+                                     onEntry_u64, &s) == 10);
+    assert(s.count == 10 && s.sum == 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19 + 20);
+    assert(skipMap_u64_get(sm, 9) && !skipMap_u64_get(sm, 10));
+    assert(skipMap_u64_removeRange(sm, 0, 100, onEntry_u64, &s) == 90);
+    assert(s.count == 100 && skipMap_u64_getSize(sm) == 0);
+    skipMap_u64_destroy(&sm);
+    printf("[test_remove_range_u64] ✅\n");
+}
+
+
+int main() {
+    test_remove_range_i32();
+    test_remove_range_u32();
+    test_remove_range_i64();
+    test_remove_range_u64();
+    return 0;
+}
@@ -0,0 +1,341 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+// members are every other key from base
+#define MEMBERS 5000
+#define CAP 7
+
+struct scan_state {
+    int64_t last;
+    uint32_t count;
+    uint32_t stop_after;
+};
+
+
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static bool visit_i32(int32_t key, void *ctx) {
+    struct scan_state *st = (struct scan_state *)ctx;
+    assert(st->count == 0 || (int64_t)key > st->last);
+    st->last = (int64_t)key;
+    return ++st->count != st->stop_after;
+}
+
+static bool visit_map_i32(int32_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)(((int64_t)key + 5000) / 2 + 1));
+    return visit_i32(key, ctx);
+}
+
+void test_scan_i32() {
+    printf("test_scan_i32()\n");
+    const int64_t base = -5000;
+    SkipList_i32 * sl = skipList_i32_create();
+    SkipMap_i32 * sm = skipMap_i32_create();
+    for (int i = 0; i < MEMBERS; i++) {
+        int32_t key = (int32_t)(base + 2 * i);
+        assert(skipList_i32_insert(sl, key));
+        assert(skipMap_i32_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_scan_i32] callback scans over assorted ranges\n");
+    for (int r = 0; r < 200; r++) {
+        int64_t lo = base - 3 + rand() % (2 * MEMBERS + 6);
+        int64_t hi = lo + rand() % 300;
+        uint32_t expected = 0;
+        for (int i = 0; i < MEMBERS; i++) {
+            int64_t k = base + 2 * i;
+            expected += (k >= lo && k < hi);
+        }
+        struct scan_state st = {0, 0, 0};
+        assert(skipList_i32_scan(sl, (int32_t)lo, (int32_t)hi, visit_i32, &st) == expected);
+        assert(st.count == expected);
+        st.count = 0;
+        assert(skipMap_i32_scan(sm, (int32_t)lo, (int32_t)hi, visit_map_i32, &st) == expected);
+    }
+    struct scan_state st = {0, 0, 3};
+    assert(skipList_i32_scan(sl, (int32_t)base, (int32_t)(base + 100), visit_i32, &st) == 3);
+    assert(skipList_i32_scan(sl, (int32_t)(base + 10), (int32_t)(base + 10), visit_i32, &st) == 0);
+    printf("[test_scan_i32] streaming the whole list in batches of %d\n", CAP);
+    int32_t keys[CAP];
+    struct SM_i32_kv kvs[CAP];
+    int32_t lo = (int32_t)base;
+    uint32_t total = 0, n;
+    while ((n = skipList_i32_scanBatch(sl, &lo, (int32_t)(base + 2 * MEMBERS), keys, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(keys[i] == (int32_t)(base + 2 * (total + i)));
+        }
+        total += n;
+    }
+    assert(total == MEMBERS);
+    lo = (int32_t)(base + 1);
+    total = 0;
+    while ((n = skipMap_i32_scanBatch(sm, &lo, (int32_t)(base + 21), kvs, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(kvs[i].key == (int32_t)(base + 2 * (total + i + 1)));
+            assert(kvs[i].value == (void *)(intptr_t)(total + i + 2));
+        }
+        total += n;
+    }
+    assert(total == 10);
+    printf("[test_scan_i32] ranges ending at the largest key\n");
+    skipList_i32_insert(sl, (int32_t)INT32_MAX);
+    skipList_i32_insert(sl, (int32_t)((INT32_MAX) - 1));
+    lo = (int32_t)((INT32_MAX) - 1);
+    assert(skipList_i32_scanBatch(sl, &lo, (int32_t)INT32_MAX, keys, CAP) == 1);
+    assert(keys[0] == (int32_t)((INT32_MAX) - 1) && lo == (int32_t)INT32_MAX);
+    assert(skipList_i32_scanBatch(sl, &lo, (int32_t)INT32_MAX, keys, CAP) == 0);
+    skipList_i32_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_i32_pop(sm, &kvs[0]));
+    skipMap_i32_destroy(&sm);
+    printf("[test_scan_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static bool visit_u32(uint32_t key, void *ctx) {
+    struct scan_state *st = (struct scan_state *)ctx;
+    assert(st->count == 0 || (int64_t)key > st->last);
+    st->last = (int64_t)key;
+    return ++st->count != st->stop_after;
+}
+
+static bool visit_map_u32(uint32_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)(((int64_t)key) / 2 + 1));
+    return visit_u32(key, ctx);
+}
+
+void test_scan_u32() {
+    printf("test_scan_u32()\n");
+    const int64_t base = 0;
+    SkipList_u32 * sl = skipList_u32_create();
+    SkipMap_u32 * sm = skipMap_u32_create();
+    for (int i = 0; i < MEMBERS; i++) {
+        uint32_t key = (uint32_t)(base + 2 * i);
+        assert(skipList_u32_insert(sl, key));
+        assert(skipMap_u32_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_scan_u32] callback scans over assorted ranges\n");
+    for (int r = 0; r < 200; r++) {
+        int64_t lo = base - 3 + rand() % (2 * MEMBERS + 6);
+        int64_t hi = lo + rand() % 300;
+        uint32_t expected = 0;
+        for (int i = 0; i < MEMBERS; i++) {
+            int64_t k = base + 2 * i;
+            expected += (k >= lo && k < hi);
+        }
+        struct scan_state st = {0, 0, 0};
+        assert(skipList_u32_scan(sl, (uint32_t)lo, (uint32_t)hi, visit_u32, &st) == expected);
+        assert(st.count == expected);
+        st.count = 0;
+        assert(skipMap_u32_scan(sm, (uint32_t)lo, (uint32_t)hi, visit_map_u32, &st) == expected);
+    }
+    struct scan_state st = {0, 0, 3};
+    assert(skipList_u32_scan(sl, (uint32_t)base, (uint32_t)(base + 100), visit_u32, &st) == 3);
+    assert(skipList_u32_scan(sl, (uint32_t)(base + 10), (uint32_t)(base + 10), visit_u32, &st) == 0);
+    printf("[test_scan_u32] streaming the whole list in batches of %d\n", CAP);
+    uint32_t keys[CAP];
+    struct SM_u32_kv kvs[CAP];
+    uint32_t lo = (uint32_t)base;
+    uint32_t total = 0, n;
+    while ((n = skipList_u32_scanBatch(sl, &lo, (uint32_t)(base + 2 * MEMBERS), keys, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(keys[i] == (uint32_t)(base + 2 * (total + i)));
+        }
+        total += n;
+    }
+    assert(total == MEMBERS);
+    lo = (uint32_t)(base + 1);
+    total = 0;
+    while ((n = skipMap_u32_scanBatch(sm, &lo, (uint32_t)(base + 21), kvs, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(kvs[i].key == (uint32_t)(base + 2 * (total + i + 1)));
+            assert(kvs[i].value == (void *)(intptr_t)(total + i + 2));
+        }
+        total += n;
+    }
+    assert(total == 10);
+    printf("[test_scan_u32] ranges ending at the largest key\n");
+    skipList_u32_insert(sl, (uint32_t)UINT32_MAX);
+    skipList_u32_insert(sl, (uint32_t)((UINT32_MAX) - 1));
+    lo = (uint32_t)((UINT32_MAX) - 1);
+    assert(skipList_u32_scanBatch(sl, &lo, (uint32_t)UINT32_MAX, keys, CAP) == 1);
+    assert(keys[0] == (uint32_t)((UINT32_MAX) - 1) && lo == (uint32_t)UINT32_MAX);
+    assert(skipList_u32_scanBatch(sl, &lo, (uint32_t)UINT32_MAX, keys, CAP) == 0);
+    skipList_u32_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_u32_pop(sm, &kvs[0]));
+    skipMap_u32_destroy(&sm);
+    printf("[test_scan_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static bool visit_i64(int64_t key, void *ctx) {
+    struct scan_state *st = (struct scan_state *)ctx;
+    assert(st->count == 0 || (int64_t)key > st->last);
+    st->last = (int64_t)key;
+    return ++st->count != st->stop_after;
+}
+
+static bool visit_map_i64(int64_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)(((int64_t)key + 5000) / 2 + 1));
+    return visit_i64(key, ctx);
+}
+
+void test_scan_i64() {
+    printf("test_scan_i64()\n");
+    const int64_t base = -5000;
+    SkipList_i64 * sl = skipList_i64_create();
+    SkipMap_i64 * sm = skipMap_i64_create();
+    for (int i = 0; i < MEMBERS; i++) {
+        int64_t key = (int64_t)(base + 2 * i);
+        assert(skipList_i64_insert(sl, key));
+        assert(skipMap_i64_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_scan_i64] callback scans over assorted ranges\n");
+    for (int r = 0; r < 200; r++) {
+        int64_t lo = base - 3 + rand() % (2 * MEMBERS + 6);
+        int64_t hi = lo + rand() % 300;
+        uint32_t expected = 0;
+        for (int i = 0; i < MEMBERS; i++) {
+            int64_t k = base + 2 * i;
+            expected += (k >= lo && k < hi);
+        }
+        struct scan_state st = {0, 0, 0};
+        assert(skipList_i64_scan(sl, (int64_t)lo, (int64_t)hi, visit_i64, &st) == expected);
+        assert(st.count == expected);
+        st.count = 0;
+        assert(skipMap_i64_scan(sm, (int64_t)lo, (int64_t)hi, visit_map_i64, &st) == expected);
+    }
+    struct scan_state st = {0, 0, 3};
+    assert(skipList_i64_scan(sl, (int64_t)base, (int64_t)(base + 100), visit_i64, &st) == 3);
+    assert(skipList_i64_scan(sl, (int64_t)(base + 10), (int64_t)(base + 10), visit_i64, &st) == 0);
+    printf("[test_scan_i64] streaming the whole list in batches of %d\n", CAP);
+    int64_t keys[CAP];
+    struct SM_i64_kv kvs[CAP];
+    int64_t lo = (int64_t)base;
+    uint32_t total = 0, n;
+    while ((n = skipList_i64_scanBatch(sl, &lo, (int64_t)(base + 2 * MEMBERS), keys, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(keys[i] == (int64_t)(base + 2 * (total + i)));
+        }
+        total += n;
+    }
+    assert(total == MEMBERS);
+    lo = (int64_t)(base + 1);
+    total = 0;
+    while ((n = skipMap_i64_scanBatch(sm, &lo, (int64_t)(base + 21), kvs, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(kvs[i].key == (int64_t)(base + 2 * (total + i + 1)));
+            assert(kvs[i].value == (void *)(intptr_t)(total + i + 2));
+        }
+        total += n;
+    }
+    assert(total == 10);
+    printf("[test_scan_i64] ranges ending at the largest key\n");
+    skipList_i64_insert(sl, (int64_t)INT64_MAX);
+    skipList_i64_insert(sl, (int64_t)((INT64_MAX) - 1));
+    lo = (int64_t)((INT64_MAX) - 1);
+    assert(skipList_i64_scanBatch(sl, &lo, (int64_t)INT64_MAX, keys, CAP) == 1);
+    assert(keys[0] == (int64_t)((INT64_MAX) - 1) && lo == (int64_t)INT64_MAX);
+    assert(skipList_i64_scanBatch(sl, &lo, (int64_t)INT64_MAX, keys, CAP) == 0);
+    skipList_i64_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_i64_pop(sm, &kvs[0]));
+    skipMap_i64_destroy(&sm);
+    printf("[test_scan_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static bool visit_u64(uint64_t key, void *ctx) {
+    struct scan_state *st = (struct scan_state *)ctx;
+    assert(st->count == 0 || (int64_t)key > st->last);
+    st->last = (int64_t)key;
+    return ++st->count != st->stop_after;
+}
+
+static bool visit_map_u64(uint64_t key, void *value, void *ctx) {
+    assert(value == (void *)(intptr_t)(((int64_t)key) / 2 + 1));
+    return visit_u64(key, ctx);
+}
+
+void test_scan_u64() {
+    printf("test_scan_u64()\n");
+    const int64_t base = 0;
+    SkipList_u64 * sl = skipList_u64_create();
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (int i = 0; i < MEMBERS; i++) {
+        uint64_t key = (uint64_t)(base + 2 * i);
+        assert(skipList_u64_insert(sl, key));
+        assert(skipMap_u64_put(sm, key, (void *)(intptr_t)(i + 1)));
+    }
+    printf("[test_scan_u64] callback scans over assorted ranges\n");
+    for (int r = 0; r < 200; r++) {
+        int64_t lo = base - 3 + rand() % (2 * MEMBERS + 6);
+        int64_t hi = lo + rand() % 300;
+        uint32_t expected = 0;
+        for (int i = 0; i < MEMBERS; i++) {
+            int64_t k = base + 2 * i;
+            expected += (k >= lo && k < hi);
+        }
+        struct scan_state st = {0, 0, 0};
+        assert(skipList_u64_scan(sl, (uint64_t)lo, (uint64_t)hi, visit_u64, &st) == expected);
+        assert(st.count == expected);
+        st.count = 0;
+        assert(skipMap_u64_scan(sm, (uint64_t)lo, (uint64_t)hi, visit_map_u64, &st) == expected);
+    }
+    struct scan_state st = {0, 0, 3};
+    assert(skipList_u64_scan(sl, (uint64_t)base, (uint64_t)(base + 100), visit_u64, &st) == 3);
+    assert(skipList_u64_scan(sl, (uint64_t)(base + 10), (uint64_t)(base + 10), visit_u64, &st) == 0);
+    printf("[test_scan_u64] streaming the whole list in batches of %d\n", CAP);
+    uint64_t keys[CAP];
+    struct SM_u64_kv kvs[CAP];
+    uint64_t lo = (uint64_t)base;
+    uint32_t total = 0, n;
+    while ((n = skipList_u64_scanBatch(sl, &lo, (uint64_t)(base + 2 * MEMBERS), keys, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(keys[i] == (uint64_t)(base + 2 * (total + i)));
+        }
+        total += n;
+    }
+    assert(total == MEMBERS);
+    lo = (uint64_t)(base + 1);
+    total = 0;
+    while ((n = skipMap_u64_scanBatch(sm, &lo, (uint64_t)(base + 21), kvs, CAP))) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(kvs[i].key == (uint64_t)(base + 2 * (total + i + 1)));
+            assert(kvs[i].value == (void *)(intptr_t)(total + i + 2));
+        }
+        total += n;
+    }
+    assert(total == 10);
+    printf("[test_scan_u64] ranges ending at the largest key\n");
+    skipList_u64_insert(sl, (uint64_t)UINT64_MAX);
+    skipList_u64_insert(sl, (uint64_t)((UINT64_MAX) - 1));
+    lo = (uint64_t)((UINT64_MAX) - 1);
+    assert(skipList_u64_scanBatch(sl, &lo, (uint64_t)UINT64_MAX, keys, CAP) == 1);
+    assert(keys[0] == (uint64_t)((UINT64_MAX) - 1) && lo == (uint64_t)UINT64_MAX);
+    assert(skipList_u64_scanBatch(sl, &lo, (uint64_t)UINT64_MAX, keys, CAP) == 0);
+    skipList_u64_destroy(&sl);
+    // map values are fake pointers, drain before destroy frees them
+    while (skipMap_u64_pop(sm, &kvs[0]));
+    skipMap_u64_destroy(&sm);
+    printf("[test_scan_u64] ✅\n");
+}
+
+
+int main() {
+    test_scan_i32();
+    test_scan_u32();
+    test_scan_i64();
+    test_scan_u64();
+    return 0;
+}
@@ -0,0 +1,404 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define ROUNDS 40
+#define KEY_RANGE 3000
+
+// a and b are filled from reference sets of varied density so both the
+// linear merge and the skewed finger probes are exercised
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void fill_i32(SkipList_i32 * sl, bool *ref, int density) {
+    for (int k = 0; k < KEY_RANGE; k++) {
+        ref[k] = rand() % 1000 < density;
+        if (ref[k]) skipList_i32_insert(sl, (int32_t)(-1500 + k));
+    }
+}
+
+static void expect_i32(SkipList_i32 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_i32_search(sl, (int32_t)(-1500 + k)) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_i32_getSize(sl) == n);
+    int32_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i32_select(sl, i, &out));
+            assert(skipList_i32_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i32_iter_last(it); skipList_i32_iter_valid(it);
+             skipList_i32_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_i32_iter_destroy(&it);
+    }
+}
+
+static void run_set_ops_i32(uint32_t flags) {
+    static const int densities[] = { 0, 2, 50, 500, 1000 };
+    static bool ra[KEY_RANGE], rb[KEY_RANGE], want[KEY_RANGE];
+    for (int round = 0; round < ROUNDS; round++) {
+        SkipList_i32 * a = skipList_i32_create_with_flags(flags);
+        SkipList_i32 * b = skipList_i32_create_with_flags(flags);
+        fill_i32(a, ra, densities[rand() % 5]);
+        fill_i32(b, rb, densities[rand() % 5]);
+        bool subset = true;
+        for (int k = 0; k < KEY_RANGE; k++) subset = subset && (!ra[k] || rb[k]);
+        assert(skipList_i32_isSubset(a, b) == subset);
+        assert(skipList_i32_isSubset(a, a));
+        SkipList_i32 * r = skipList_i32_union(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+        expect_i32(r, want, flags);
+        assert(skipList_i32_isSubset(a, r) && skipList_i32_isSubset(b, r));
+        skipList_i32_destroy(&r);
+        r = skipList_i32_intersect(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+        expect_i32(r, want, flags);
+        skipList_i32_destroy(&r);
+        r = skipList_i32_difference(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+        expect_i32(r, want, flags);
+        skipList_i32_destroy(&r);
+        // in place variants report how much a changed
+        uint32_t size = skipList_i32_getSize(a);
+        switch (round % 3) {
+            case 0:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+                assert(skipList_i32_unionInPlace(a, b) == skipList_i32_getSize(a) - size);
+                break;
+            case 1:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+                assert(skipList_i32_intersectInPlace(a, b) == size - skipList_i32_getSize(a));
+                break;
+            default:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+                assert(skipList_i32_differenceInPlace(a, b) == size - skipList_i32_getSize(a));
+                break;
+        }
+        expect_i32(a, want, flags);
+        expect_i32(b, rb, flags);
+        assert(skipList_i32_unionInPlace(b, b) == 0);
+        assert(skipList_i32_intersectInPlace(b, b) == 0);
+        size = skipList_i32_getSize(b);
+        assert(skipList_i32_differenceInPlace(b, b) == size);
+        assert(skipList_i32_isEmpty(b));
+        skipList_i32_destroy(&a);
+        skipList_i32_destroy(&b);
+    }
+}
+
+void test_set_ops_i32() {
+    printf("test_set_ops_i32()\n");
+    printf("[test_set_ops_i32] random sets against reference sets\n");
+    run_set_ops_i32(0);
+    run_set_ops_i32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_set_ops_i32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_set_ops_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void fill_u32(SkipList_u32 * sl, bool *ref, int density) {
+    for (int k = 0; k < KEY_RANGE; k++) {
+        ref[k] = rand() % 1000 < density;
+        if (ref[k]) skipList_u32_insert(sl, (uint32_t)k);
+    }
+}
+
+static void expect_u32(SkipList_u32 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_u32_search(sl, (uint32_t)k) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_u32_getSize(sl) == n);
+    uint32_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u32_select(sl, i, &out));
+            assert(skipList_u32_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u32_iter_last(it); skipList_u32_iter_valid(it);
+             skipList_u32_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_u32_iter_destroy(&it);
+    }
+}
+
+static void run_set_ops_u32(uint32_t flags) {
+    static const int densities[] = { 0, 2, 50, 500, 1000 };
+    static bool ra[KEY_RANGE], rb[KEY_RANGE], want[KEY_RANGE];
+    for (int round = 0; round < ROUNDS; round++) {
+        SkipList_u32 * a = skipList_u32_create_with_flags(flags);
+        SkipList_u32 * b = skipList_u32_create_with_flags(flags);
+        fill_u32(a, ra, densities[rand() % 5]);
+        fill_u32(b, rb, densities[rand() % 5]);
+        bool subset = true;
+        for (int k = 0; k < KEY_RANGE; k++) subset = subset && (!ra[k] || rb[k]);
+        assert(skipList_u32_isSubset(a, b) == subset);
+        assert(skipList_u32_isSubset(a, a));
+        SkipList_u32 * r = skipList_u32_union(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+        expect_u32(r, want, flags);
+        assert(skipList_u32_isSubset(a, r) && skipList_u32_isSubset(b, r));
+        skipList_u32_destroy(&r);
+        r = skipList_u32_intersect(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+        expect_u32(r, want, flags);
+        skipList_u32_destroy(&r);
+        r = skipList_u32_difference(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+        expect_u32(r, want, flags);
+        skipList_u32_destroy(&r);
+        // in place variants report how much a changed
+        uint32_t size = skipList_u32_getSize(a);
+        switch (round % 3) {
+            case 0:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+                assert(skipList_u32_unionInPlace(a, b) == skipList_u32_getSize(a) - size);
+                break;
+            case 1:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+                assert(skipList_u32_intersectInPlace(a, b) == size - skipList_u32_getSize(a));
+                break;
+            default:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+                assert(skipList_u32_differenceInPlace(a, b) == size - skipList_u32_getSize(a));
+                break;
+        }
+        expect_u32(a, want, flags);
+        expect_u32(b, rb, flags);
+        assert(skipList_u32_unionInPlace(b, b) == 0);
+        assert(skipList_u32_intersectInPlace(b, b) == 0);
+        size = skipList_u32_getSize(b);
+        assert(skipList_u32_differenceInPlace(b, b) == size);
+        assert(skipList_u32_isEmpty(b));
+        skipList_u32_destroy(&a);
+        skipList_u32_destroy(&b);
+    }
+}
+
+void test_set_ops_u32() {
+    printf("test_set_ops_u32()\n");
+    printf("[test_set_ops_u32] random sets against reference sets\n");
+    run_set_ops_u32(0);
+    run_set_ops_u32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_set_ops_u32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_set_ops_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void fill_i64(SkipList_i64 * sl, bool *ref, int density) {
+    for (int k = 0; k < KEY_RANGE; k++) {
+        ref[k] = rand() % 1000 < density;
+        if (ref[k]) skipList_i64_insert(sl, (int64_t)(-1500 + k));
+    }
+}
+
+static void expect_i64(SkipList_i64 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_i64_search(sl, (int64_t)(-1500 + k)) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_i64_getSize(sl) == n);
+    int64_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i64_select(sl, i, &out));
+            assert(skipList_i64_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i64_iter_last(it); skipList_i64_iter_valid(it);
+             skipList_i64_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_i64_iter_destroy(&it);
+    }
+}
+
+static void run_set_ops_i64(uint32_t flags) {
+    static const int densities[] = { 0, 2, 50, 500, 1000 };
+    static bool ra[KEY_RANGE], rb[KEY_RANGE], want[KEY_RANGE];
+    for (int round = 0; round < ROUNDS; round++) {
+        SkipList_i64 * a = skipList_i64_create_with_flags(flags);
+        SkipList_i64 * b = skipList_i64_create_with_flags(flags);
+        fill_i64(a, ra, densities[rand() % 5]);
+        fill_i64(b, rb, densities[rand() % 5]);
+        bool subset = true;
+        for (int k = 0; k < KEY_RANGE; k++) subset = subset && (!ra[k] || rb[k]);
+        assert(skipList_i64_isSubset(a, b) == subset);
+        assert(skipList_i64_isSubset(a, a));
+        SkipList_i64 * r = skipList_i64_union(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+        expect_i64(r, want, flags);
+        assert(skipList_i64_isSubset(a, r) && skipList_i64_isSubset(b, r));
+        skipList_i64_destroy(&r);
+        r = skipList_i64_intersect(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+        expect_i64(r, want, flags);
+        skipList_i64_destroy(&r);
+        r = skipList_i64_difference(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+        expect_i64(r, want, flags);
+        skipList_i64_destroy(&r);
+        // in place variants report how much a changed
+        uint32_t size = skipList_i64_getSize(a);
+        switch (round % 3) {
+            case 0:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+                assert(skipList_i64_unionInPlace(a, b) == skipList_i64_getSize(a) - size);
+                break;
+            case 1:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+                assert(skipList_i64_intersectInPlace(a, b) == size - skipList_i64_getSize(a));
+                break;
+            default:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+                assert(skipList_i64_differenceInPlace(a, b) == size - skipList_i64_getSize(a));
+                break;
+        }
+        expect_i64(a, want, flags);
+        expect_i64(b, rb, flags);
+        assert(skipList_i64_unionInPlace(b, b) == 0);
+        assert(skipList_i64_intersectInPlace(b, b) == 0);
+        size = skipList_i64_getSize(b);
+        assert(skipList_i64_differenceInPlace(b, b) == size);
+        assert(skipList_i64_isEmpty(b));
+        skipList_i64_destroy(&a);
+        skipList_i64_destroy(&b);
+    }
+}
+
+void test_set_ops_i64() {
+    printf("test_set_ops_i64()\n");
+    printf("[test_set_ops_i64] random sets against reference sets\n");
+    run_set_ops_i64(0);
+    run_set_ops_i64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_set_ops_i64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_set_ops_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void fill_u64(SkipList_u64 * sl, bool *ref, int density) {
+    for (int k = 0; k < KEY_RANGE; k++) {
+        ref[k] = rand() % 1000 < density;
+        if (ref[k]) skipList_u64_insert(sl, (uint64_t)k);
+    }
+}
+
+static void expect_u64(SkipList_u64 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_u64_search(sl, (uint64_t)k) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_u64_getSize(sl) == n);
+    uint64_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u64_select(sl, i, &out));
+            assert(skipList_u64_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u64_iter_last(it); skipList_u64_iter_valid(it);
+             skipList_u64_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_u64_iter_destroy(&it);
+    }
+}
+
+static void run_set_ops_u64(uint32_t flags) {
+    static const int densities[] = { 0, 2, 50, 500, 1000 };
+    static bool ra[KEY_RANGE], rb[KEY_RANGE], want[KEY_RANGE];
+    for (int round = 0; round < ROUNDS; round++) {
+        SkipList_u64 * a = skipList_u64_create_with_flags(flags);
+        SkipList_u64 * b = skipList_u64_create_with_flags(flags);
+        fill_u64(a, ra, densities[rand() % 5]);
+        fill_u64(b, rb, densities[rand() % 5]);
+        bool subset = true;
+        for (int k = 0; k < KEY_RANGE; k++) subset = subset && (!ra[k] || rb[k]);
+        assert(skipList_u64_isSubset(a, b) == subset);
+        assert(skipList_u64_isSubset(a, a));
+        SkipList_u64 * r = skipList_u64_union(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+        expect_u64(r, want, flags);
+        assert(skipList_u64_isSubset(a, r) && skipList_u64_isSubset(b, r));
+        skipList_u64_destroy(&r);
+        r = skipList_u64_intersect(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+        expect_u64(r, want, flags);
+        skipList_u64_destroy(&r);
+        r = skipList_u64_difference(a, b);
+        for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+        expect_u64(r, want, flags);
+        skipList_u64_destroy(&r);
+        // in place variants report how much a changed
+        uint32_t size = skipList_u64_getSize(a);
+        switch (round % 3) {
+            case 0:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] || rb[k];
+                assert(skipList_u64_unionInPlace(a, b) == skipList_u64_getSize(a) - size);
+                break;
+            case 1:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && rb[k];
+                assert(skipList_u64_intersectInPlace(a, b) == size - skipList_u64_getSize(a));
+                break;
+            default:
+                for (int k = 0; k < KEY_RANGE; k++) want[k] = ra[k] && !rb[k];
+                assert(skipList_u64_differenceInPlace(a, b) == size - skipList_u64_getSize(a));
+                break;
+        }
+        expect_u64(a, want, flags);
+        expect_u64(b, rb, flags);
+        assert(skipList_u64_unionInPlace(b, b) == 0);
+        assert(skipList_u64_intersectInPlace(b, b) == 0);
+        size = skipList_u64_getSize(b);
+        assert(skipList_u64_differenceInPlace(b, b) == size);
+        assert(skipList_u64_isEmpty(b));
+        skipList_u64_destroy(&a);
+        skipList_u64_destroy(&b);
+    }
+}
+
+void test_set_ops_u64() {
+    printf("test_set_ops_u64()\n");
+    printf("[test_set_ops_u64] random sets against reference sets\n");
+    run_set_ops_u64(0);
+    run_set_ops_u64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_set_ops_u64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    printf("[test_set_ops_u64] ✅\n");
+}
+
+
+int main() {
+    test_set_ops_i32();
+    test_set_ops_u32();
+    test_set_ops_i64();
+    test_set_ops_u64();
+    return 0;
+}
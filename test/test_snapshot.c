@@ -0,0 +1,555 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define KEY_RANGE 2000
+
+// snapshots must keep answering from the state they were taken in while the
+// source goes through every kind of write
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void expect_i32(SkipList_i32 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_i32_search(sl, (int32_t)(-1000 + k)) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_i32_getSize(sl) == n);
+    int32_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i32_select(sl, i, &out));
+            assert(skipList_i32_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i32_iter_last(it); skipList_i32_iter_valid(it);
+             skipList_i32_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_i32_iter_destroy(&it);
+    }
+}
+
+static void mutate_i32(SkipList_i32 * sl, bool *ref, int op) {
+    int32_t out;
+    int k = rand() % KEY_RANGE;
+    switch (op % 5) {
+        case 0: skipList_i32_insert(sl, (int32_t)(-1000 + k)); ref[k] = true; break;
+        case 1: skipList_i32_remove(sl, (int32_t)(-1000 + k)); ref[k] = false; break;
+        case 2:
+            if (skipList_i32_pop(sl, &out)) ref[(int)((int64_t)out + 1000)] = false;
+            break;
+        case 3:
+            if (skipList_i32_popMax(sl, &out)) ref[(int)((int64_t)out + 1000)] = false;
+            break;
+        default:
+            skipList_i32_removeRange(sl, (int32_t)(-1000 + k), (int32_t)(-1000 + k + 10), NULL, NULL);
+            for (int j = k; j < k + 10 && j < KEY_RANGE; j++) ref[j] = false;
+            break;
+    }
+}
+
+static void run_snapshot_i32(uint32_t flags) {
+    static bool live[KEY_RANGE], first[KEY_RANGE], second[KEY_RANGE];
+    SkipList_i32 * sl = skipList_i32_create_with_flags(flags);
+    for (int k = 0; k < KEY_RANGE; k++) {
+        live[k] = rand() % 3 == 0;
+        if (live[k]) skipList_i32_insert(sl, (int32_t)(-1000 + k));
+    }
+    SkipList_i32 * copy = skipList_i32_clone(sl);
+    expect_i32(copy, live, flags);
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    SkipList_i32 * a = skipList_i32_snapshot(sl);
+    SkipList_i32 * b = skipList_i32_snapshot(sl);
+    for (int op = 0; op < 200; op++) mutate_i32(sl, live, op);
+    expect_i32(sl, live, flags);
+    expect_i32(a, first, flags);
+    expect_i32(b, first, flags);
+    expect_i32(copy, first, flags);
+    for (int k = 0; k < KEY_RANGE; k++) second[k] = live[k];
+    SkipList_i32 * c = skipList_i32_snapshot(sl);
+    skipList_i32_destroy(&a);
+    for (int op = 0; op < 200; op++) mutate_i32(sl, live, op);
+    expect_i32(b, first, flags);
+    expect_i32(c, second, flags);
+    skipList_i32_destroy(&b);
+    skipList_i32_destroy(&c);
+    // a snapshot dropped before any write costs no copy
+    a = skipList_i32_snapshot(sl);
+    skipList_i32_destroy(&a);
+    skipList_i32_insertBatch(sl, (int32_t[]){ (int32_t)-1000, -999 }, 2);
+    live[0] = live[1] = true;
+    expect_i32(sl, live, flags);
+    // the source may go first, its snapshot keeps the nodes
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    a = skipList_i32_snapshot(sl);
+    skipList_i32_destroy(&sl);
+    expect_i32(a, first, flags);
+    skipList_i32_destroy(&a);
+    skipList_i32_destroy(&copy);
+}
+
+void test_snapshot_i32() {
+    printf("test_snapshot_i32()\n");
+    printf("[test_snapshot_i32] clones and snapshots against reference sets\n");
+    run_snapshot_i32(0);
+    run_snapshot_i32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_snapshot_i32(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_snapshot_i32] map snapshots borrow values\n");
+    SkipMap_i32 * sm = skipMap_i32_create();
+    for (int i = 0; i < 100; i++) {
+        int * v = malloc(sizeof(int));
+        *v = i;
+        skipMap_i32_put(sm, (int32_t)(-1000 + i), v);
+    }
+    SkipMap_i32 * snap = skipMap_i32_snapshot(sm);
+    free(skipMap_i32_remove(sm, -995));
+    assert(!skipMap_i32_get(sm, -995));
+    assert(skipMap_i32_getSize(snap) == 100);
+    assert(*(int *)skipMap_i32_get(snap, -994) == 6);
+    skipMap_i32_destroy(&snap);
+    assert(*(int *)skipMap_i32_get(sm, -994) == 6);
+    skipMap_i32_destroy(&sm);
+    printf("[test_snapshot_i32] values are freed once in either destroy order\n");
+    for (int order = 0; order < 2; order++) {
+        sm = skipMap_i32_create();
+        for (int i = 0; i < 100; i++) {
+            int * v = malloc(sizeof(int));
+            *v = i;
+            skipMap_i32_put(sm, (int32_t)(-1000 + i), v);
+        }
+        SkipMap_i32 * copy = skipMap_i32_clone(sm);
+        snap = skipMap_i32_snapshot(sm);
+        if (order) {
+            // the snapshot keeps the values of the map alive for the clone
+            skipMap_i32_destroy(&sm);
+            assert(*(int *)skipMap_i32_get(snap, -993) == 7);
+            assert(*(int *)skipMap_i32_get(copy, -993) == 7);
+            skipMap_i32_destroy(&snap);
+            skipMap_i32_destroy(&copy);
+        } else {
+            skipMap_i32_destroy(&copy);
+            skipMap_i32_destroy(&snap);
+            assert(*(int *)skipMap_i32_get(sm, -993) == 7);
+            skipMap_i32_destroy(&sm);
+        }
+    }
+    printf("[test_snapshot_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void expect_u32(SkipList_u32 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_u32_search(sl, (uint32_t)k) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_u32_getSize(sl) == n);
+    uint32_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u32_select(sl, i, &out));
+            assert(skipList_u32_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u32_iter_last(it); skipList_u32_iter_valid(it);
+             skipList_u32_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_u32_iter_destroy(&it);
+    }
+}
+
+static void mutate_u32(SkipList_u32 * sl, bool *ref, int op) {
+    uint32_t out;
+    int k = rand() % KEY_RANGE;
+    switch (op % 5) {
+        case 0: skipList_u32_insert(sl, (uint32_t)k); ref[k] = true; break;
+        case 1: skipList_u32_remove(sl, (uint32_t)k); ref[k] = false; break;
+        case 2:
+            if (skipList_u32_pop(sl, &out)) ref[(int)((int64_t)out)] = false;
+            break;
+        case 3:
+            if (skipList_u32_popMax(sl, &out)) ref[(int)((int64_t)out)] = false;
+            break;
+        default:
+            skipList_u32_removeRange(sl, (uint32_t)k, (uint32_t)(k + 10), NULL, NULL);
+            for (int j = k; j < k + 10 && j < KEY_RANGE; j++) ref[j] = false;
+            break;
+    }
+}
+
+static void run_snapshot_u32(uint32_t flags) {
+    static bool live[KEY_RANGE], first[KEY_RANGE], second[KEY_RANGE];
+    SkipList_u32 * sl = skipList_u32_create_with_flags(flags);
+    for (int k = 0; k < KEY_RANGE; k++) {
+        live[k] = rand() % 3 == 0;
+        if (live[k]) skipList_u32_insert(sl, (uint32_t)k);
+    }
+    SkipList_u32 * copy = skipList_u32_clone(sl);
+    expect_u32(copy, live, flags);
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    SkipList_u32 * a = skipList_u32_snapshot(sl);
+    SkipList_u32 * b = skipList_u32_snapshot(sl);
+    for (int op = 0; op < 200; op++) mutate_u32(sl, live, op);
+    expect_u32(sl, live, flags);
+    expect_u32(a, first, flags);
+    expect_u32(b, first, flags);
+    expect_u32(copy, first, flags);
+    for (int k = 0; k < KEY_RANGE; k++) second[k] = live[k];
+    SkipList_u32 * c = skipList_u32_snapshot(sl);
+    skipList_u32_destroy(&a);
+    for (int op = 0; op < 200; op++) mutate_u32(sl, live, op);
+    expect_u32(b, first, flags);
+    expect_u32(c, second, flags);
+    skipList_u32_destroy(&b);
+    skipList_u32_destroy(&c);
+    // a snapshot dropped before any write costs no copy
+    a = skipList_u32_snapshot(sl);
+    skipList_u32_destroy(&a);
+    skipList_u32_insertBatch(sl, (uint32_t[]){ 0, 1 }, 2);
+    live[0] = live[1] = true;
+    expect_u32(sl, live, flags);
+    // the source may go first, its snapshot keeps the nodes
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    a = skipList_u32_snapshot(sl);
+    skipList_u32_destroy(&sl);
+    expect_u32(a, first, flags);
+    skipList_u32_destroy(&a);
+    skipList_u32_destroy(&copy);
+}
+
+void test_snapshot_u32() {
+    printf("test_snapshot_u32()\n");
+    printf("[test_snapshot_u32] clones and snapshots against reference sets\n");
+    run_snapshot_u32(0);
+    run_snapshot_u32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_snapshot_u32(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_snapshot_u32] map snapshots borrow values\n");
+    SkipMap_u32 * sm = skipMap_u32_create();
+    for (int i = 0; i < 100; i++) {
+        int * v = malloc(sizeof(int));
+        *v = i;
+        skipMap_u32_put(sm, (uint32_t)i, v);
+    }
+    SkipMap_u32 * snap = skipMap_u32_snapshot(sm);
+    free(skipMap_u32_remove(sm, 5));
+    assert(!skipMap_u32_get(sm, 5));
+    assert(skipMap_u32_getSize(snap) == 100);
+    assert(*(int *)skipMap_u32_get(snap, 6) == 6);
+    skipMap_u32_destroy(&snap);
+    assert(*(int *)skipMap_u32_get(sm, 6) == 6);
+    skipMap_u32_destroy(&sm);
+    printf("[test_snapshot_u32] values are freed once in either destroy order\n");
+    for (int order = 0; order < 2; order++) {
+        sm = skipMap_u32_create();
+        for (int i = 0; i < 100; i++) {
+            int * v = malloc(sizeof(int));
+            *v = i;
+            skipMap_u32_put(sm, (uint32_t)i, v);
+        }
+        SkipMap_u32 * copy = skipMap_u32_clone(sm);
+        snap = skipMap_u32_snapshot(sm);
+        if (order) {
+            // the snapshot keeps the values of the map alive for the clone
+            skipMap_u32_destroy(&sm);
+            assert(*(int *)skipMap_u32_get(snap, 7) == 7);
+            assert(*(int *)skipMap_u32_get(copy, 7) == 7);
+            skipMap_u32_destroy(&snap);
+            skipMap_u32_destroy(&copy);
+        } else {
+            skipMap_u32_destroy(&copy);
+            skipMap_u32_destroy(&snap);
+            assert(*(int *)skipMap_u32_get(sm, 7) == 7);
+            skipMap_u32_destroy(&sm);
+        }
+    }
+    printf("[test_snapshot_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void expect_i64(SkipList_i64 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_i64_search(sl, (int64_t)(-1000 + k)) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_i64_getSize(sl) == n);
+    int64_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i64_select(sl, i, &out));
+            assert(skipList_i64_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i64_iter_last(it); skipList_i64_iter_valid(it);
+             skipList_i64_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_i64_iter_destroy(&it);
+    }
+}
+
+static void mutate_i64(SkipList_i64 * sl, bool *ref, int op) {
+    int64_t out;
+    int k = rand() % KEY_RANGE;
+    switch (op % 5) {
+        case 0: skipList_i64_insert(sl, (int64_t)(-1000 + k)); ref[k] = true; break;
+        case 1: skipList_i64_remove(sl, (int64_t)(-1000 + k)); ref[k] = false; break;
+        case 2:
+            if (skipList_i64_pop(sl, &out)) ref[(int)((int64_t)out + 1000)] = false;
+            break;
+        case 3:
+            if (skipList_i64_popMax(sl, &out)) ref[(int)((int64_t)out + 1000)] = false;
+            break;
+        default:
+            skipList_i64_removeRange(sl, (int64_t)(-1000 + k), (int64_t)(-1000 + k + 10), NULL, NULL);
+            for (int j = k; j < k + 10 && j < KEY_RANGE; j++) ref[j] = false;
+            break;
+    }
+}
+
+static void run_snapshot_i64(uint32_t flags) {
+    static bool live[KEY_RANGE], first[KEY_RANGE], second[KEY_RANGE];
+    SkipList_i64 * sl = skipList_i64_create_with_flags(flags);
+    for (int k = 0; k < KEY_RANGE; k++) {
+        live[k] = rand() % 3 == 0;
+        if (live[k]) skipList_i64_insert(sl, (int64_t)(-1000 + k));
+    }
+    SkipList_i64 * copy = skipList_i64_clone(sl);
+    expect_i64(copy, live, flags);
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    SkipList_i64 * a = skipList_i64_snapshot(sl);
+    SkipList_i64 * b = skipList_i64_snapshot(sl);
+    for (int op = 0; op < 200; op++) mutate_i64(sl, live, op);
+    expect_i64(sl, live, flags);
+    expect_i64(a, first, flags);
+    expect_i64(b, first, flags);
+    expect_i64(copy, first, flags);
+    for (int k = 0; k < KEY_RANGE; k++) second[k] = live[k];
+    SkipList_i64 * c = skipList_i64_snapshot(sl);
+    skipList_i64_destroy(&a);
+    for (int op = 0; op < 200; op++) mutate_i64(sl, live, op);
+    expect_i64(b, first, flags);
+    expect_i64(c, second, flags);
+    skipList_i64_destroy(&b);
+    skipList_i64_destroy(&c);
+    // a snapshot dropped before any write costs no copy
+    a = skipList_i64_snapshot(sl);
+    skipList_i64_destroy(&a);
+    skipList_i64_insertBatch(sl, (int64_t[]){ (int64_t)-1000, -999 }, 2);
+    live[0] = live[1] = true;
+    expect_i64(sl, live, flags);
+    // the source may go first, its snapshot keeps the nodes
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    a = skipList_i64_snapshot(sl);
+    skipList_i64_destroy(&sl);
+    expect_i64(a, first, flags);
+    skipList_i64_destroy(&a);
+    skipList_i64_destroy(&copy);
+}
+
+void test_snapshot_i64() {
+    printf("test_snapshot_i64()\n");
+    printf("[test_snapshot_i64] clones and snapshots against reference sets\n");
+    run_snapshot_i64(0);
+    run_snapshot_i64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_snapshot_i64(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_snapshot_i64] map snapshots borrow values\n");
+    SkipMap_i64 * sm = skipMap_i64_create();
+    for (int i = 0; i < 100; i++) {
+        int * v = malloc(sizeof(int));
+        *v = i;
+        skipMap_i64_put(sm, (int64_t)(-1000 + i), v);
+    }
+    SkipMap_i64 * snap = skipMap_i64_snapshot(sm);
+    free(skipMap_i64_remove(sm, -995));
+    assert(!skipMap_i64_get(sm, -995));
+    assert(skipMap_i64_getSize(snap) == 100);
+    assert(*(int *)skipMap_i64_get(snap, -994) == 6);
+    skipMap_i64_destroy(&snap);
+    assert(*(int *)skipMap_i64_get(sm, -994) == 6);
+    skipMap_i64_destroy(&sm);
+    printf("[test_snapshot_i64] values are freed once in either destroy order\n");
+    for (int order = 0; order < 2; order++) {
+        sm = skipMap_i64_create();
+        for (int i = 0; i < 100; i++) {
+            int * v = malloc(sizeof(int));
+            *v = i;
+            skipMap_i64_put(sm, (int64_t)(-1000 + i), v);
+        }
+        SkipMap_i64 * copy = skipMap_i64_clone(sm);
+        snap = skipMap_i64_snapshot(sm);
+        if (order) {
+            // the snapshot keeps the values of the map alive for the clone
+            skipMap_i64_destroy(&sm);
+            assert(*(int *)skipMap_i64_get(snap, -993) == 7);
+            assert(*(int *)skipMap_i64_get(copy, -993) == 7);
+            skipMap_i64_destroy(&snap);
+            skipMap_i64_destroy(&copy);
+        } else {
+            skipMap_i64_destroy(&copy);
+            skipMap_i64_destroy(&snap);
+            assert(*(int *)skipMap_i64_get(sm, -993) == 7);
+            skipMap_i64_destroy(&sm);
+        }
+    }
+    printf("[test_snapshot_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void expect_u64(SkipList_u64 * sl, const bool *ref, uint32_t flags) {
+    uint32_t n = 0;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        assert(skipList_u64_search(sl, (uint64_t)k) == ref[k]);
+        n += ref[k];
+    }
+    assert(skipList_u64_getSize(sl) == n);
+    uint64_t out;
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u64_select(sl, i, &out));
+            assert(skipList_u64_rank(sl, out) == i);
+        }
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u64_iter_last(it); skipList_u64_iter_valid(it);
+             skipList_u64_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_u64_iter_destroy(&it);
+    }
+}
+
+static void mutate_u64(SkipList_u64 * sl, bool *ref, int op) {
+    uint64_t out;
+    int k = rand() % KEY_RANGE;
+    switch (op % 5) {
+        case 0: skipList_u64_insert(sl, (uint64_t)k); ref[k] = true; break;
+        case 1: skipList_u64_remove(sl, (uint64_t)k); ref[k] = false; break;
+        case 2:
+            if (skipList_u64_pop(sl, &out)) ref[(int)((int64_t)out)] = false;
+            break;
+        case 3:
+            if (skipList_u64_popMax(sl, &out)) ref[(int)((int64_t)out)] = false;
+            break;
+        default:
+            skipList_u64_removeRange(sl, (uint64_t)k, (uint64_t)(k + 10), NULL, NULL);
+            for (int j = k; j < k + 10 && j < KEY_RANGE; j++) ref[j] = false;
+            break;
+    }
+}
+
+static void run_snapshot_u64(uint32_t flags) {
+    static bool live[KEY_RANGE], first[KEY_RANGE], second[KEY_RANGE];
+    SkipList_u64 * sl = skipList_u64_create_with_flags(flags);
+    for (int k = 0; k < KEY_RANGE; k++) {
+        live[k] = rand() % 3 == 0;
+        if (live[k]) skipList_u64_insert(sl, (uint64_t)k);
+    }
+    SkipList_u64 * copy = skipList_u64_clone(sl);
+    expect_u64(copy, live, flags);
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    SkipList_u64 * a = skipList_u64_snapshot(sl);
+    SkipList_u64 * b = skipList_u64_snapshot(sl);
+    for (int op = 0; op < 200; op++) mutate_u64(sl, live, op);
+    expect_u64(sl, live, flags);
+    expect_u64(a, first, flags);
+    expect_u64(b, first, flags);
+    expect_u64(copy, first, flags);
+    for (int k = 0; k < KEY_RANGE; k++) second[k] = live[k];
+    SkipList_u64 * c = skipList_u64_snapshot(sl);
+    skipList_u64_destroy(&a);
+    for (int op = 0; op < 200; op++) mutate_u64(sl, live, op);
+    expect_u64(b, first, flags);
+    expect_u64(c, second, flags);
+    skipList_u64_destroy(&b);
+    skipList_u64_destroy(&c);
+    // a snapshot dropped before any write costs no copy
+    a = skipList_u64_snapshot(sl);
+    skipList_u64_destroy(&a);
+    skipList_u64_insertBatch(sl, (uint64_t[]){ 0, 1 }, 2);
+    live[0] = live[1] = true;
+    expect_u64(sl, live, flags);
+    // the source may go first, its snapshot keeps the nodes
+    for (int k = 0; k < KEY_RANGE; k++) first[k] = live[k];
+    a = skipList_u64_snapshot(sl);
+    skipList_u64_destroy(&sl);
+    expect_u64(a, first, flags);
+    skipList_u64_destroy(&a);
+    skipList_u64_destroy(&copy);
+}
+
+void test_snapshot_u64() {
+    printf("test_snapshot_u64()\n");
+    printf("[test_snapshot_u64] clones and snapshots against reference sets\n");
+    run_snapshot_u64(0);
+    run_snapshot_u64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_snapshot_u64(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_snapshot_u64] map snapshots borrow values\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (int i = 0; i < 100; i++) {
+        int * v = malloc(sizeof(int));
+        *v = i;
+        skipMap_u64_put(sm, (uint64_t)i, v);
+    }
+    SkipMap_u64 * snap = skipMap_u64_snapshot(sm);
+    free(skipMap_u64_remove(sm, 5));
+    assert(!skipMap_u64_get(sm, 5));
+    assert(skipMap_u64_getSize(snap) == 100);
+    assert(*(int *)skipMap_u64_get(snap, 6) == 6);
+    skipMap_u64_destroy(&snap);
+    assert(*(int *)skipMap_u64_get(sm, 6) == 6);
+    skipMap_u64_destroy(&sm);
+    printf("[test_snapshot_u64] values are freed once in either destroy order\n");
+    for (int order = 0; order < 2; order++) {
+        sm = skipMap_u64_create();
+        for (int i = 0; i < 100; i++) {
+            int * v = malloc(sizeof(int));
+            *v = i;
+            skipMap_u64_put(sm, (uint64_t)i, v);
+        }
+        SkipMap_u64 * copy = skipMap_u64_clone(sm);
+        snap = skipMap_u64_snapshot(sm);
+        if (order) {
+            // the snapshot keeps the values of the map alive for the clone
+            skipMap_u64_destroy(&sm);
+            assert(*(int *)skipMap_u64_get(snap, 7) == 7);
+            assert(*(int *)skipMap_u64_get(copy, 7) == 7);
+            skipMap_u64_destroy(&snap);
+            skipMap_u64_destroy(&copy);
+        } else {
+            skipMap_u64_destroy(&copy);
+            skipMap_u64_destroy(&snap);
+            assert(*(int *)skipMap_u64_get(sm, 7) == 7);
+            skipMap_u64_destroy(&sm);
+        }
+    }
+    printf("[test_snapshot_u64] ✅\n");
+}
+
+
+int main() {
+    test_snapshot_i32();
+    test_snapshot_u32();
+    test_snapshot_i64();
+    test_snapshot_u64();
+    return 0;
+}
@@ -0,0 +1,536 @@
+#include <skiplist.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define ROUNDS 60
+#define KEY_RANGE 2000
+
+// present[] is the reference set, left holds keys below the cut and right the
+// rest, both are checked with every structure the flags enable
+/* ============================================================
+   SkipList_i32 / SkipMap_i32
+   ============================================================ */
+static void check_i32(SkipList_i32 * sl, const bool *present, int from, int to, uint32_t flags) {
+    uint32_t n = 0;
+    int max = -1;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        bool in = present[k] && k >= from && k < to;
+        assert(skipList_i32_search(sl, (int32_t)(-1000 + k)) == in);
+        if (in) { n++; max = k; }
+    }
+    assert(skipList_i32_getSize(sl) == n);
+    int32_t out;
+    assert(skipList_i32_peekMax(sl, &out) == (max >= 0));
+    if (max >= 0) assert(out == (int32_t)(-1000 + max));
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i32_select(sl, i, &out));
+            assert(skipList_i32_rank(sl, out) == i);
+        }
+        assert(!skipList_i32_select(sl, n, &out));
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i32 * it = skipList_i32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i32_iter_last(it); skipList_i32_iter_valid(it);
+             skipList_i32_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_i32_iter_destroy(&it);
+    }
+}
+
+static void run_split_i32(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_i32 * sl = skipList_i32_create_with_flags(flags);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 50; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_i32_insert(sl, (int32_t)(-1000 + k));
+            present[k] = true;
+        }
+        int cut = round % 10 == 0 ? (round % 20 ? 0 : KEY_RANGE) : rand() % KEY_RANGE;
+        SkipList_i32 * right;
+        skipList_i32_split(sl, (int32_t)(-1000 + cut), &right);
+        check_i32(sl, present, 0, cut, flags);
+        check_i32(right, present, cut, KEY_RANGE, flags);
+        // both halves stay usable on their own
+        for (int j = 0; j < 20; j++) {
+            int k = rand() % KEY_RANGE;
+            if (k < cut) skipList_i32_insert(sl, (int32_t)(-1000 + k));
+            else skipList_i32_remove(right, (int32_t)(-1000 + k));
+            present[k] = k < cut;
+        }
+        check_i32(sl, present, 0, cut, flags);
+        check_i32(right, present, cut, KEY_RANGE, flags);
+        skipList_i32_concat(sl, &right);
+        assert(right == NULL);
+        check_i32(sl, present, 0, KEY_RANGE, flags);
+    }
+    // the left half can go first, the right one keeps the shared arena alive
+    SkipList_i32 * right;
+    skipList_i32_split(sl, (int32_t)(-1000 + KEY_RANGE / 2), &right);
+    skipList_i32_destroy(&sl);
+    check_i32(right, present, KEY_RANGE / 2, KEY_RANGE, flags);
+    skipList_i32_insert(right, (int32_t)(-1000 + KEY_RANGE - 1));
+    assert(skipList_i32_search(right, (int32_t)(-1000 + KEY_RANGE - 1)));
+    skipList_i32_destroy(&right);
+}
+
+void test_split_i32() {
+    printf("test_split_i32()\n");
+    printf("[test_split_i32] split and concat against a reference set\n");
+    run_split_i32(0);
+    run_split_i32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_split_i32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    run_split_i32(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_split_i32] concat of separately built arena lists\n");
+    SkipList_i32 * a = skipList_i32_create_with_arena();
+    SkipList_i32 * b = skipList_i32_create_with_arena();
+    for (int i = 0; i < 1000; i++) {
+        skipList_i32_insert(i < 500 ? a : b, (int32_t)(-1000 + i));
+    }
+    skipList_i32_concat(a, &b);
+    assert(skipList_i32_getSize(a) == 1000);
+    for (int i = 0; i < 1000; i++) assert(skipList_i32_search(a, (int32_t)(-1000 + i)));
+    skipList_i32_destroy(&a);
+    printf("[test_split_i32] concat of a half whose arena is still shared\n");
+    for (int order = 0; order < 2; order++) {
+        SkipList_i32 * d = skipList_i32_create_with_arena();
+        SkipList_i32 * g = skipList_i32_create_with_arena();
+        for (int i = 0; i < 1000; i++) {
+            skipList_i32_insert(i < 300 ? g : d, (int32_t)(-1000 + i));
+        }
+        SkipList_i32 * e;
+        skipList_i32_split(d, -300, &e);
+        skipList_i32_concat(g, &d);
+        assert(!d && skipList_i32_getSize(g) == 700);
+        // nodes of the shared arena are freed into and reused from g
+        for (int i = 300; i < 700; i += 2) skipList_i32_remove(g, (int32_t)(-1000 + i));
+        for (int i = 300; i < 700; i += 2) skipList_i32_insert(g, (int32_t)(-1000 + i));
+        skipList_i32_insert(e, 0);
+        if (order) skipList_i32_destroy(&g);
+        skipList_i32_destroy(&e);
+        if (!order) {
+            for (int i = 0; i < 700; i++) assert(skipList_i32_search(g, (int32_t)(-1000 + i)));
+            skipList_i32_destroy(&g);
+        }
+    }
+    printf("[test_split_i32] maps keep their values\n");
+    SkipMap_i32 * sm = skipMap_i32_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_i32_put(sm, (int32_t)(-1000 + i), (void *)(intptr_t)(i + 1));
+    }
+    SkipMap_i32 * hi;
+    skipMap_i32_split(sm, -960, &hi);
+    assert(skipMap_i32_getSize(sm) == 40 && skipMap_i32_getSize(hi) == 60);
+    assert(skipMap_i32_get(hi, -960) == (void *)(intptr_t)41);
+    assert(skipMap_i32_get(sm, -960) == NULL);
+    skipMap_i32_concat(sm, &hi);
+    struct SM_i32_kv kv;
+    for (int i = 0; i < 100; i++) {
+        assert(skipMap_i32_pop(sm, &kv));
+        assert(kv.key == (int32_t)(-1000 + i) && kv.value == (void *)(intptr_t)(i + 1));
+    }
+    skipMap_i32_destroy(&sm);
+    printf("[test_split_i32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u32 / SkipMap_u32
+   ============================================================ */
+static void check_u32(SkipList_u32 * sl, const bool *present, int from, int to, uint32_t flags) {
+    uint32_t n = 0;
+    int max = -1;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        bool in = present[k] && k >= from && k < to;
+        assert(skipList_u32_search(sl, (uint32_t)k) == in);
+        if (in) { n++; max = k; }
+    }
+    assert(skipList_u32_getSize(sl) == n);
+    uint32_t out;
+    assert(skipList_u32_peekMax(sl, &out) == (max >= 0));
+    if (max >= 0) assert(out == (uint32_t)max);
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u32_select(sl, i, &out));
+            assert(skipList_u32_rank(sl, out) == i);
+        }
+        assert(!skipList_u32_select(sl, n, &out));
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u32 * it = skipList_u32_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u32_iter_last(it); skipList_u32_iter_valid(it);
+             skipList_u32_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_u32_iter_destroy(&it);
+    }
+}
+
+static void run_split_u32(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_u32 * sl = skipList_u32_create_with_flags(flags);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 50; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_u32_insert(sl, (uint32_t)k);
+            present[k] = true;
+        }
+        int cut = round % 10 == 0 ? (round % 20 ? 0 : KEY_RANGE) : rand() % KEY_RANGE;
+        SkipList_u32 * right;
+        skipList_u32_split(sl, (uint32_t)cut, &right);
+        check_u32(sl, present, 0, cut, flags);
+        check_u32(right, present, cut, KEY_RANGE, flags);
+        // both halves stay usable on their own
+        for (int j = 0; j < 20; j++) {
+            int k = rand() % KEY_RANGE;
+            if (k < cut) skipList_u32_insert(sl, (uint32_t)k);
+            else skipList_u32_remove(right, (uint32_t)k);
+            present[k] = k < cut;
+        }
+        check_u32(sl, present, 0, cut, flags);
+        check_u32(right, present, cut, KEY_RANGE, flags);
+        skipList_u32_concat(sl, &right);
+        assert(right == NULL);
+        check_u32(sl, present, 0, KEY_RANGE, flags);
+    }
+    // the left half can go first, the right one keeps the shared arena alive
+    SkipList_u32 * right;
+    skipList_u32_split(sl, (uint32_t)(KEY_RANGE / 2), &right);
+    skipList_u32_destroy(&sl);
+    check_u32(right, present, KEY_RANGE / 2, KEY_RANGE, flags);
+    skipList_u32_insert(right, (uint32_t)(KEY_RANGE - 1));
+    assert(skipList_u32_search(right, (uint32_t)(KEY_RANGE - 1)));
+    skipList_u32_destroy(&right);
+}
+
+void test_split_u32() {
+    printf("test_split_u32()\n");
+    printf("[test_split_u32] split and concat against a reference set\n");
+    run_split_u32(0);
+    run_split_u32(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_split_u32(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    run_split_u32(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_split_u32] concat of separately built arena lists\n");
+    SkipList_u32 * a = skipList_u32_create_with_arena();
+    SkipList_u32 * b = skipList_u32_create_with_arena();
+    for (int i = 0; i < 1000; i++) {
+        skipList_u32_insert(i < 500 ? a : b, (uint32_t)i);
+    }
+    skipList_u32_concat(a, &b);
+    assert(skipList_u32_getSize(a) == 1000);
+    for (int i = 0; i < 1000; i++) assert(skipList_u32_search(a, (uint32_t)i));
+    skipList_u32_destroy(&a);
+    printf("[test_split_u32] concat of a half whose arena is still shared\n");
+    for (int order = 0; order < 2; order++) {
+        SkipList_u32 * d = skipList_u32_create_with_arena();
+        SkipList_u32 * g = skipList_u32_create_with_arena();
+        for (int i = 0; i < 1000; i++) {
+            skipList_u32_insert(i < 300 ? g : d, (uint32_t)i);
+        }
+        SkipList_u32 * e;
+        skipList_u32_split(d, 700, &e);
+        skipList_u32_concat(g, &d);
+        assert(!d && skipList_u32_getSize(g) == 700);
+        // nodes of the shared arena are freed into and reused from g
+        for (int i = 300; i < 700; i += 2) skipList_u32_remove(g, (uint32_t)i);
+        for (int i = 300; i < 700; i += 2) skipList_u32_insert(g, (uint32_t)i);
+        skipList_u32_insert(e, 1000);
+        if (order) skipList_u32_destroy(&g);
+        skipList_u32_destroy(&e);
+        if (!order) {
+            for (int i = 0; i < 700; i++) assert(skipList_u32_search(g, (uint32_t)i));
+            skipList_u32_destroy(&g);
+        }
+    }
+    printf("[test_split_u32] maps keep their values\n");
+    SkipMap_u32 * sm = skipMap_u32_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_u32_put(sm, (uint32_t)i, (void *)(intptr_t)(i + 1));
+    }
+    SkipMap_u32 * hi;
+    skipMap_u32_split(sm, 40, &hi);
+    assert(skipMap_u32_getSize(sm) == 40 && skipMap_u32_getSize(hi) == 60);
+    assert(skipMap_u32_get(hi, 40) == (void *)(intptr_t)41);
+    assert(skipMap_u32_get(sm, 40) == NULL);
+    skipMap_u32_concat(sm, &hi);
+    struct SM_u32_kv kv;
+    for (int i = 0; i < 100; i++) {
+        assert(skipMap_u32_pop(sm, &kv));
+        assert(kv.key == (uint32_t)i && kv.value == (void *)(intptr_t)(i + 1));
+    }
+    skipMap_u32_destroy(&sm);
+    printf("[test_split_u32] ✅\n");
+}
+
+/* ============================================================
+   SkipList_i64 / SkipMap_i64
+   ============================================================ */
+static void check_i64(SkipList_i64 * sl, const bool *present, int from, int to, uint32_t flags) {
+    uint32_t n = 0;
+    int max = -1;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        bool in = present[k] && k >= from && k < to;
+        assert(skipList_i64_search(sl, (int64_t)(-1000 + k)) == in);
+        if (in) { n++; max = k; }
+    }
+    assert(skipList_i64_getSize(sl) == n);
+    int64_t out;
+    assert(skipList_i64_peekMax(sl, &out) == (max >= 0));
+    if (max >= 0) assert(out == (int64_t)(-1000 + max));
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_i64_select(sl, i, &out));
+            assert(skipList_i64_rank(sl, out) == i);
+        }
+        assert(!skipList_i64_select(sl, n, &out));
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_i64 * it = skipList_i64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_i64_iter_last(it); skipList_i64_iter_valid(it);
+             skipList_i64_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_i64_iter_destroy(&it);
+    }
+}
+
+static void run_split_i64(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_i64 * sl = skipList_i64_create_with_flags(flags);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 50; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_i64_insert(sl, (int64_t)(-1000 + k));
+            present[k] = true;
+        }
+        int cut = round % 10 == 0 ? (round % 20 ? 0 : KEY_RANGE) : rand() % KEY_RANGE;
+        SkipList_i64 * right;
+        skipList_i64_split(sl, (int64_t)(-1000 + cut), &right);
+        check_i64(sl, present, 0, cut, flags);
+        check_i64(right, present, cut, KEY_RANGE, flags);
+        // both halves stay usable on their own
+        for (int j = 0; j < 20; j++) {
+            int k = rand() % KEY_RANGE;
+            if (k < cut) skipList_i64_insert(sl, (int64_t)(-1000 + k));
+            else skipList_i64_remove(right, (int64_t)(-1000 + k));
+            present[k] = k < cut;
+        }
+        check_i64(sl, present, 0, cut, flags);
+        check_i64(right, present, cut, KEY_RANGE, flags);
+        skipList_i64_concat(sl, &right);
+        assert(right == NULL);
+        check_i64(sl, present, 0, KEY_RANGE, flags);
+    }
+    // the left half can go first, the right one keeps the shared arena alive
+    SkipList_i64 * right;
+    skipList_i64_split(sl, (int64_t)(-1000 + KEY_RANGE / 2), &right);
+    skipList_i64_destroy(&sl);
+    check_i64(right, present, KEY_RANGE / 2, KEY_RANGE, flags);
+    skipList_i64_insert(right, (int64_t)(-1000 + KEY_RANGE - 1));
+    assert(skipList_i64_search(right, (int64_t)(-1000 + KEY_RANGE - 1)));
+    skipList_i64_destroy(&right);
+}
+
+void test_split_i64() {
+    printf("test_split_i64()\n");
+    printf("[test_split_i64] split and concat against a reference set\n");
+    run_split_i64(0);
+    run_split_i64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_split_i64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    run_split_i64(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_split_i64] concat of separately built arena lists\n");
+    SkipList_i64 * a = skipList_i64_create_with_arena();
+    SkipList_i64 * b = skipList_i64_create_with_arena();
+    for (int i = 0; i < 1000; i++) {
+        skipList_i64_insert(i < 500 ? a : b, (int64_t)(-1000 + i));
+    }
+    skipList_i64_concat(a, &b);
+    assert(skipList_i64_getSize(a) == 1000);
+    for (int i = 0; i < 1000; i++) assert(skipList_i64_search(a, (int64_t)(-1000 + i)));
+    skipList_i64_destroy(&a);
+    printf("[test_split_i64] concat of a half whose arena is still shared\n");
+    for (int order = 0; order < 2; order++) {
+        SkipList_i64 * d = skipList_i64_create_with_arena();
+        SkipList_i64 * g = skipList_i64_create_with_arena();
+        for (int i = 0; i < 1000; i++) {
+            skipList_i64_insert(i < 300 ? g : d, (int64_t)(-1000 + i));
+        }
+        SkipList_i64 * e;
+        skipList_i64_split(d, -300, &e);
+        skipList_i64_concat(g, &d);
+        assert(!d && skipList_i64_getSize(g) == 700);
+        // nodes of the shared arena are freed into and reused from g
+        for (int i = 300; i < 700; i += 2) skipList_i64_remove(g, (int64_t)(-1000 + i));
+        for (int i = 300; i < 700; i += 2) skipList_i64_insert(g, (int64_t)(-1000 + i));
+        skipList_i64_insert(e, 0);
+        if (order) skipList_i64_destroy(&g);
+        skipList_i64_destroy(&e);
+        if (!order) {
+            for (int i = 0; i < 700; i++) assert(skipList_i64_search(g, (int64_t)(-1000 + i)));
+            skipList_i64_destroy(&g);
+        }
+    }
+    printf("[test_split_i64] maps keep their values\n");
+    SkipMap_i64 * sm = skipMap_i64_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_i64_put(sm, (int64_t)(-1000 + i), (void *)(intptr_t)(i + 1));
+    }
+    SkipMap_i64 * hi;
+    skipMap_i64_split(sm, -960, &hi);
+    assert(skipMap_i64_getSize(sm) == 40 && skipMap_i64_getSize(hi) == 60);
+    assert(skipMap_i64_get(hi, -960) == (void *)(intptr_t)41);
+    assert(skipMap_i64_get(sm, -960) == NULL);
+    skipMap_i64_concat(sm, &hi);
+    struct SM_i64_kv kv;
+    for (int i = 0; i < 100; i++) {
+        assert(skipMap_i64_pop(sm, &kv));
+        assert(kv.key == (int64_t)(-1000 + i) && kv.value == (void *)(intptr_t)(i + 1));
+    }
+    skipMap_i64_destroy(&sm);
+    printf("[test_split_i64] ✅\n");
+}
+
+/* ============================================================
+   SkipList_u64 / SkipMap_u64
+   ============================================================ */
+static void check_u64(SkipList_u64 * sl, const bool *present, int from, int to, uint32_t flags) {
+    uint32_t n = 0;
+    int max = -1;
+    for (int k = 0; k < KEY_RANGE; k++) {
+        bool in = present[k] && k >= from && k < to;
+        assert(skipList_u64_search(sl, (uint64_t)k) == in);
+        if (in) { n++; max = k; }
+    }
+    assert(skipList_u64_getSize(sl) == n);
+    uint64_t out;
+    assert(skipList_u64_peekMax(sl, &out) == (max >= 0));
+    if (max >= 0) assert(out == (uint64_t)max);
+    if (flags & SKIPLIST_INDEXABLE) {
+        for (uint32_t i = 0; i < n; i++) {
+            assert(skipList_u64_select(sl, i, &out));
+            assert(skipList_u64_rank(sl, out) == i);
+        }
+        assert(!skipList_u64_select(sl, n, &out));
+    }
+    if (flags & SKIPLIST_BACKLINKS) {
+        SkipListIter_u64 * it = skipList_u64_iter_create(sl);
+        uint32_t walked = 0;
+        for (skipList_u64_iter_last(it); skipList_u64_iter_valid(it);
+             skipList_u64_iter_prev(it)) walked++;
+        assert(walked == n);
+        skipList_u64_iter_destroy(&it);
+    }
+}
+
+static void run_split_u64(uint32_t flags) {
+    static bool present[KEY_RANGE];
+    for (int i = 0; i < KEY_RANGE; i++) present[i] = false;
+    SkipList_u64 * sl = skipList_u64_create_with_flags(flags);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int j = 0; j < 50; j++) {
+            int k = rand() % KEY_RANGE;
+            skipList_u64_insert(sl, (uint64_t)k);
+            present[k] = true;
+        }
+        int cut = round % 10 == 0 ? (round % 20 ? 0 : KEY_RANGE) : rand() % KEY_RANGE;
+        SkipList_u64 * right;
+        skipList_u64_split(sl, (uint64_t)cut, &right);
+        check_u64(sl, present, 0, cut, flags);
+        check_u64(right, present, cut, KEY_RANGE, flags);
+        // both halves stay usable on their own
+        for (int j = 0; j < 20; j++) {
+            int k = rand() % KEY_RANGE;
+            if (k < cut) skipList_u64_insert(sl, (uint64_t)k);
+            else skipList_u64_remove(right, (uint64_t)k);
+            present[k] = k < cut;
+        }
+        check_u64(sl, present, 0, cut, flags);
+        check_u64(right, present, cut, KEY_RANGE, flags);
+        skipList_u64_concat(sl, &right);
+        assert(right == NULL);
+        check_u64(sl, present, 0, KEY_RANGE, flags);
+    }
+    // the left half can go first, the right one keeps the shared arena alive
+    SkipList_u64 * right;
+    skipList_u64_split(sl, (uint64_t)(KEY_RANGE / 2), &right);
+    skipList_u64_destroy(&sl);
+    check_u64(right, present, KEY_RANGE / 2, KEY_RANGE, flags);
+    skipList_u64_insert(right, (uint64_t)(KEY_RANGE - 1));
+    assert(skipList_u64_search(right, (uint64_t)(KEY_RANGE - 1)));
+    skipList_u64_destroy(&right);
+}
+
+void test_split_u64() {
+    printf("test_split_u64()\n");
+    printf("[test_split_u64] split and concat against a reference set\n");
+    run_split_u64(0);
+    run_split_u64(SKIPLIST_INDEXABLE | SKIPLIST_BACKLINKS);
+    run_split_u64(SKIPLIST_ARENA | SKIPLIST_INDEXABLE);
+    run_split_u64(SKIPLIST_ARENA | SKIPLIST_BACKLINKS);
+    printf("[test_split_u64] concat of separately built arena lists\n");
+    SkipList_u64 * a = skipList_u64_create_with_arena();
+    SkipList_u64 * b = skipList_u64_create_with_arena();
+    for (int i = 0; i < 1000; i++) {
+        skipList_u64_insert(i < 500 ? a : b, (uint64_t)i);
+    }
+    skipList_u64_concat(a, &b);
+    assert(skipList_u64_getSize(a) == 1000);
+    for (int i = 0; i < 1000; i++) assert(skipList_u64_search(a, (uint64_t)i));
+    skipList_u64_destroy(&a);
+    printf("[test_split_u64] concat of a half whose arena is still shared\n");
+    for (int order = 0; order < 2; order++) {
+        SkipList_u64 * d = skipList_u64_create_with_arena();
+        SkipList_u64 * g = skipList_u64_create_with_arena();
+        for (int i = 0; i < 1000; i++) {
+            skipList_u64_insert(i < 300 ? g : d, (uint64_t)i);
+        }
+        SkipList_u64 * e;
+        skipList_u64_split(d, 700, &e);
+        skipList_u64_concat(g, &d);
+        assert(!d && skipList_u64_getSize(g) == 700);
+        // nodes of the shared arena are freed into and reused from g
+        for (int i = 300; i < 700; i += 2) skipList_u64_remove(g, (uint64_t)i);
+        for (int i = 300; i < 700; i += 2) skipList_u64_insert(g, (uint64_t)i);
+        skipList_u64_insert(e, 1000);
+        if (order) skipList_u64_destroy(&g);
+        skipList_u64_destroy(&e);
+        if (!order) {
+            for (int i = 0; i < 700; i++) assert(skipList_u64_search(g, (uint64_t)i));
+            skipList_u64_destroy(&g);
+        }
+    }
+    printf("[test_split_u64] maps keep their values\n");
+    SkipMap_u64 * sm = skipMap_u64_create();
+    for (int i = 0; i < 100; i++) {
+        skipMap_u64_put(sm, (uint64_t)i, (void *)(intptr_t)(i + 1));
+    }
+    SkipMap_u64 * hi;
+    skipMap_u64_split(sm, 40, &hi);
+    assert(skipMap_u64_getSize(sm) == 40 && skipMap_u64_getSize(hi) == 60);
+    assert(skipMap_u64_get(hi, 40) == (void *)(intptr_t)41);
+    assert(skipMap_u64_get(sm, 40) == NULL);
+    skipMap_u64_concat(sm, &hi);
+    struct SM_u64_kv kv;
+    for (int i = 0; i < 100; i++) {
+        assert(skipMap_u64_pop(sm, &kv));
+        assert(kv.key == (uint64_t)i && kv.value == (void *)(intptr_t)(i + 1));
+    }
+    skipMap_u64_destroy(&sm);
+    printf("[test_split_u64] ✅\n");
+}
+
+
+int main() {
+    test_split_i32();
+    test_split_u32();
+    test_split_i64();
+    test_split_u64();
+    return 0;
+}